@@ -46,7 +46,7 @@ void hash_int(int x)
 /* add contents of a file to the hash */
 void hash_file(const char *fname)
 {
-	char buf[1024];
+	char buf[65536];
 	int fd, n;
 
 	fd = open(fname, O_RDONLY|O_BINARY);
@@ -87,6 +87,14 @@ static void copy64(uint32 *M, const unsigned char *in)
 {
 	int i;
 
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+	/* the wire format is little-endian, so the block can be loaded
+	   directly when the host matches */
+	if (sizeof(uint32) == 4) {
+		memcpy(M, in, 64);
+		return;
+	}
+#endif
 	for (i=0;i<16;i++)
 		M[i] = (in[i*4+3]<<24) | (in[i*4+2]<<16) |
 			(in[i*4+1]<<8) | (in[i*4+0]<<0);
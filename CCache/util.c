@@ -70,7 +70,7 @@ int safe_rename(const char* oldpath, const char* newpath)
 /* copy all data from one file descriptor to another */
 void copy_fd(int fd_in, int fd_out)
 {
-	char buf[10240];
+	char buf[65536];
 	int n;
 
 	while ((n = read(fd_in, buf, sizeof(buf))) > 0) {
@@ -100,7 +100,7 @@ int move_file(const char *src, const char *dest) {
 static int copy_file(const char *src, const char *dest)
 {
 	int fd1, fd2;
-	char buf[10240];
+	char buf[65536];
 	int n;
 	char *tmp_name;
 	mode_t mask;
@@ -177,7 +177,7 @@ static int copy_file_from_cache(const char *src, const char *dest) {
    possibly decompressing it
 */
 void copy_fd(int fd_in, int fd_out) {
-	char buf[10240];
+	char buf[65536];
 	int n;
 	gzFile gz_in;
 
@@ -199,7 +199,7 @@ void copy_fd(int fd_in, int fd_out) {
 static int _copy_file(const char *src, const char *dest, int mode) {
 	int fd_in, fd_out;
 	gzFile gz_in, gz_out = NULL;
-	char buf[10240];
+	char buf[65536];
 	int n, ret;
 	char *tmp_name;
 	mode_t mask;
@@ -251,7 +251,14 @@ static int _copy_file(const char *src, const char *dest, int mode) {
 
 	if (mode == COPY_TO_CACHE) {
 		int dup_fd_out = dup(fd_out);
-		gz_out = gzdopen(dup_fd_out, "wb");
+		/* CCACHE_COMPRESSLEVEL picks the zlib level (1-9); level 1
+		   trades a slightly larger cache for much cheaper stores */
+		const char *level = getenv("CCACHE_COMPRESSLEVEL");
+		char gzmode[4] = "wb";
+		if (level && level[0] >= '1' && level[0] <= '9' && !level[1]) {
+			gzmode[2] = level[0];
+		}
+		gz_out = gzdopen(dup_fd_out, gzmode);
 		if (!gz_out) {
 			gzclose(gz_in);
 			close(dup_fd_out);
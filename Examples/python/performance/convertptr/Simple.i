@@ -0,0 +1,14 @@
+%inline %{
+class Point {
+public:
+    Point (double x, double y) : x(x), y(y) {}
+    ~Point () {}
+    double x, y;
+};
+
+double dist (const Point *a, const Point *b) {
+    double dx = a->x - b->x;
+    double dy = a->y - b->y;
+    return dx * dx + dy * dy;
+}
+%}
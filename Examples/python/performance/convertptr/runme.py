@@ -0,0 +1,13 @@
+import sys
+sys.path.append("..")
+import harness
+
+
+def proc(mod):
+    a = mod.Point(0.0, 0.0)
+    b = mod.Point(3.0, 4.0)
+    dist = mod.dist
+    for i in range(5000000):
+        dist(a, b)
+
+harness.run(proc)
@@ -0,0 +1,18 @@
+%module(directors="1") Simple
+
+%feature("director") Callback;
+
+%inline %{
+class Callback {
+public:
+    virtual ~Callback () {}
+    virtual int handle (int n) { return n; }
+};
+
+int drive (Callback *cb, int count) {
+    int total = 0;
+    for (int i = 0; i < count; ++i)
+        total += cb->handle(i);
+    return total;
+}
+%}
@@ -0,0 +1,15 @@
+import sys
+sys.path.append("..")
+import harness
+
+
+def proc(mod):
+    class PyCallback(mod.Callback):
+        def handle(self, n):
+            return n
+
+    cb = PyCallback()
+    for i in range(100):
+        mod.drive(cb, 10000)
+
+harness.run(proc)
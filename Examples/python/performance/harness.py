@@ -1,32 +1,23 @@
+import importlib
 import sys
 import time
-import imp
 from subprocess import *
 
 
 def run(proc):
 
-    try:
-        mod = imp.find_module(sys.argv[1])
-        mod = imp.load_module(sys.argv[1], *mod)
+    if len(sys.argv) > 1:
+        sys.path.insert(0, ".")
+        mod = importlib.import_module(sys.argv[1])
 
-        t1 = time.clock()
+        t1 = time.perf_counter()
         proc(mod)
-        t2 = time.clock()
-        print "%s took %f seconds" % (mod.__name__, t2 - t1)
+        t2 = time.perf_counter()
+        print("%s took %f seconds" % (mod.__name__, t2 - t1))
 
-    except IndexError:
-        proc = Popen(
-            [sys.executable, "runme.py", "Simple_baseline"], stdout=PIPE)
-        (stdout, stderr) = proc.communicate()
-        print stdout
-
-        proc = Popen(
-            [sys.executable, "runme.py", "Simple_optimized"], stdout=PIPE)
-        (stdout, stderr) = proc.communicate()
-        print stdout
-
-        proc = Popen(
-            [sys.executable, "runme.py", "Simple_builtin"], stdout=PIPE)
-        (stdout, stderr) = proc.communicate()
-        print stdout
+    else:
+        for variant in ["Simple_baseline", "Simple_optimized", "Simple_builtin"]:
+            proc = Popen(
+                [sys.executable, "runme.py", variant], stdout=PIPE)
+            (stdout, stderr) = proc.communicate()
+            sys.stdout.write(stdout.decode())
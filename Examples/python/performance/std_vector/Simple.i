@@ -0,0 +1,12 @@
+%include "std_vector.i"
+
+%template(DoubleVector) std::vector<double>;
+
+%inline %{
+double sum (const std::vector<double> &v) {
+    double total = 0;
+    for (std::vector<double>::const_iterator i = v.begin(); i != v.end(); ++i)
+        total += *i;
+    return total;
+}
+%}
@@ -0,0 +1,16 @@
+import sys
+sys.path.append("..")
+import harness
+
+
+def proc(mod):
+    data = [float(i) for i in range(1000)]
+    wrapped = mod.DoubleVector(data)
+    s = mod.sum
+    # Converting a Python list exercises the sequence typemap; passing the
+    # wrapped vector exercises the pointer fast path.
+    for i in range(5000):
+        s(data)
+        s(wrapped)
+
+harness.run(proc)
@@ -0,0 +1,35 @@
+import enum_thorough
+
+# Plain integer enum items, global and class scope.
+if enum_thorough.ReallyAnInteger != 200:
+    raise RuntimeError("wrong value {}".format(enum_thorough.ReallyAnInteger))
+if enum_thorough.SpeedClass.slow != 10 or enum_thorough.SpeedClass.lightning != 31:
+    raise RuntimeError("wrong SpeedClass values")
+if enum_thorough.speedTest1(enum_thorough.SpeedClass.fast) != enum_thorough.SpeedClass.fast:
+    raise RuntimeError("speedTest1 failed")
+
+
+# Char-valued enum items must stay one-char strings, not integer codes,
+# while items of the same enums defined with integer literals stay ints.
+def check_char_items(scope, prefix):
+    if getattr(scope, prefix + "A") != 'A':
+        raise RuntimeError("{}A is not 'A'".format(prefix))
+    if getattr(scope, prefix + "B") != 'B':
+        raise RuntimeError("{}B is not 'B'".format(prefix))
+    if getattr(scope, prefix + "2") != '\n':
+        raise RuntimeError("{}2 is not a newline".format(prefix))
+    if getattr(scope, prefix + "D") != 0x44:
+        raise RuntimeError("{}D is not 0x44".format(prefix))
+    if getattr(scope, prefix + "E") != 69:
+        raise RuntimeError("{}E is not 69".format(prefix))
+
+
+check_char_items(enum_thorough, "globalenumchar")
+check_char_items(enum_thorough, "enumchar")
+check_char_items(enum_thorough.EnumCharStruct, "enumchar")
+
+# Bool-valued enum items must stay booleans.
+if enum_thorough.global_typebooltrue is not True:
+    raise RuntimeError("global_typebooltrue is not True")
+if enum_thorough.global_typeboolfalse is not False:
+    raise RuntimeError("global_typeboolfalse is not False")
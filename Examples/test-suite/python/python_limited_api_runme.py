@@ -0,0 +1,29 @@
+import python_limited_api
+
+# Exercise the std::vector wrappers, in particular the slice methods
+# the limited API port touched.
+v = python_limited_api.IntVector([1, 2, 3, 4, 5])
+if len(v) != 5:
+    raise RuntimeError("wrong size {}".format(len(v)))
+if list(v[1:4]) != [2, 3, 4]:
+    raise RuntimeError("getitem slice not working")
+if list(v[::2]) != [1, 3, 5]:
+    raise RuntimeError("stepped slice not working")
+v[1:3] = python_limited_api.IntVector([20, 30])
+if list(v) != [1, 20, 30, 4, 5]:
+    raise RuntimeError("setitem slice not working")
+del v[1:3]
+if list(v) != [1, 4, 5]:
+    raise RuntimeError("delitem slice not working")
+try:
+    v["bad"]
+except TypeError:
+    pass
+else:
+    raise RuntimeError("non-slice subscript unexpectedly allowed")
+
+g = python_limited_api.GadgetVector([python_limited_api.Gadget(7)])
+if g[0].id != 7:
+    raise RuntimeError("wrong id {}".format(g[0].id))
+if g[0:1][0].id != 7:
+    raise RuntimeError("object slice not working")
@@ -0,0 +1,57 @@
+import weakref
+import python_slots
+
+# Slotted proxy instances carry no per-instance dict but stay
+# weak-referenceable, and ad-hoc attribute assignment fails.
+s = python_slots.Slotted(7)
+if hasattr(s, "__dict__"):
+    raise RuntimeError("slotted instance has a __dict__")
+if weakref.ref(s)() is not s:
+    raise RuntimeError("weak reference not working")
+if s.value != 7:
+    raise RuntimeError("wrong value {}".format(s.value))
+try:
+    s.extra = 1
+except AttributeError:
+    pass
+else:
+    raise RuntimeError("attribute assignment unexpectedly allowed")
+
+# Nondynamic classes keep dict-based instances; the module must import
+# and the nondynamic check must still be enforced.
+lk = python_slots.Locked()
+lk.a = 1
+lk.b = 2
+try:
+    lk.c = 3
+except AttributeError:
+    pass
+else:
+    raise RuntimeError("nondynamic not enforced")
+
+
+# The back-reference stored in the __swig_container__ slot keeps the
+# vector alive while a reference to an element is held.
+def first_element():
+    v = python_slots.VectorWheel((python_slots.Wheel(11), python_slots.Wheel(22)))
+    # v will be deleted after exit from this method
+    return v[0]
+
+
+size = first_element().size
+if size != 11:
+    raise RuntimeError("Back reference not working {}".format(size))
+
+
+# Proxy classes share one instance layout, so Python-side multiple
+# inheritance from two proxies of the same module works.
+class Both(python_slots.BaseA, python_slots.BaseB):
+
+    def __init__(self):
+        python_slots.BaseA.__init__(self)
+        python_slots.BaseB.__init__(self)
+
+
+both = Both()
+if both.a() != 1 or both.b() != 2:
+    raise RuntimeError("multiple inheritance not working")
@@ -0,0 +1,39 @@
+from python_split import *
+
+# Wrappers for header-backed declarations, spread over the split units
+if header_add(2, 3) != 5:
+    raise RuntimeError("header_add failed")
+if header_sub(7, 3) != 4:
+    raise RuntimeError("header_sub failed")
+if header_echo("split") != "split":
+    raise RuntimeError("header_echo failed")
+
+hc = HeaderCounter()
+hc.bump()
+hc.bump()
+if hc.value() != 2:
+    raise RuntimeError("HeaderCounter failed")
+
+# %inline definitions, pinned to the main unit
+if inline_twice(21) != 42:
+    raise RuntimeError("inline_twice failed")
+if inline_overloaded() != 0:
+    raise RuntimeError("inline_overloaded() failed")
+if inline_overloaded(5) != 5:
+    raise RuntimeError("inline_overloaded(int) failed")
+if inline_overloaded(2.5) != 2.5:
+    raise RuntimeError("inline_overloaded(double) failed")
+if cvar.inline_global != 42:
+    raise RuntimeError("inline_global failed")
+
+b = InlineBox(6)
+if b.get() != 6:
+    raise RuntimeError("InlineBox failed")
+
+# %extend members of an %inline class, whose helper bodies must also
+# stay out of the extra units
+b2 = InlineBox(4, 5)
+if b2.get() != 9:
+    raise RuntimeError("extended InlineBox constructor failed")
+if b2.doubled() != 18:
+    raise RuntimeError("InlineBox.doubled failed")
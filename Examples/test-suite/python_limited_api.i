@@ -0,0 +1,21 @@
+%module python_limited_api
+
+/*
+ Compiled with -py-limited-api (the Makefile passes it for this test
+ only), so the wrapper is built with Py_LIMITED_API defined.  The
+ std::vector wrappers are the interesting part: their slice methods
+ must stick to the stable ABI slice functions, since PySliceObject
+ does not exist under the limited API.
+*/
+
+%include <std_vector.i>
+
+%inline %{
+struct Gadget {
+  int id;
+  Gadget(int i = 0) : id(i) {}
+};
+%}
+
+%template(IntVector) std::vector<int>;
+%template(GadgetVector) std::vector<Gadget>;
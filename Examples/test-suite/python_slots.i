@@ -0,0 +1,42 @@
+%module python_slots
+
+/*
+ Exercises the proxy classes generated with the -slots option (the
+ Makefile passes it for this test only): instances must be dict-free
+ but weak-referenceable, nondynamic classes must keep dict-based
+ instances so the _SwigNonDynamicMeta decorator can recreate them,
+ the container back-reference must land in the __swig_container__
+ slot, and Python code must be able to inherit from two proxy classes
+ of the same module.
+*/
+
+%include <std_vector.i>
+
+%pythonnondynamic Locked;
+
+%inline %{
+struct Slotted {
+  int value;
+  Slotted(int v = 0) : value(v) {}
+};
+
+struct Locked {
+  int a;
+  int b;
+};
+
+struct Wheel {
+  int size;
+  Wheel(int sz = 0) : size(sz) {}
+};
+
+struct BaseA {
+  int a() { return 1; }
+};
+
+struct BaseB {
+  int b() { return 2; }
+};
+%}
+
+%template(VectorWheel) std::vector<Wheel>;
@@ -0,0 +1,57 @@
+/* Exercises -split generation of multiple translation units (the test
+   makefile passes -split 3).  Mixes declarations the splitter may divert
+   to the extra units with %inline definitions, which have external
+   linkage and therefore must only be compiled by the main unit. */
+
+%module python_split
+
+%include <std_string.i>
+
+%{
+#include <string>
+
+inline int header_add(int a, int b) { return a + b; }
+inline int header_sub(int a, int b) { return a - b; }
+inline std::string header_echo(const std::string &s) { return s; }
+
+struct HeaderCounter {
+  int count;
+  HeaderCounter() : count(0) {}
+  void bump() { count++; }
+  int value() const { return count; }
+};
+%}
+
+int header_add(int a, int b);
+int header_sub(int a, int b);
+std::string header_echo(const std::string &s);
+
+struct HeaderCounter {
+  int count;
+  HeaderCounter();
+  void bump();
+  int value() const;
+};
+
+%inline %{
+int inline_twice(int x) { return 2 * x; }
+int inline_overloaded() { return 0; }
+int inline_overloaded(int x) { return x; }
+double inline_overloaded(double x) { return x; }
+int inline_global = 42;
+
+struct InlineBox {
+  int v;
+  InlineBox(int x = 0) : v(x) {}
+  int get() { return v; }
+};
+%}
+
+%extend InlineBox {
+  InlineBox(int a, int b) {
+    return new InlineBox(a + b);
+  }
+  int doubled() {
+    return 2 * $self->v;
+  }
+}
@@ -114,3 +114,74 @@ static NAME *frompointer(TYPE *t) {
 
 %enddef
 
+/* -----------------------------------------------------------------------------
+ * %array_functions_block(TYPE,NAME)
+ *
+ * Adds bulk transfer functions for the arrays handled by %array_functions,
+ * so that extracting or filling a slice is a single crossing instead of one
+ * wrapped call per element:
+ *
+ *        SWIGCDATA NAME_getblock(TYPE *ary, size_t offset, size_t nelements);
+ *        void NAME_setblock(TYPE *ary, size_t offset, const void *blockdata, size_t blocklen);
+ *
+ * getblock returns the slice as a binary string in the target language;
+ * setblock copies a binary string over the slice starting at offset
+ * (blocklen is in bytes and need not be a whole number of elements).
+ * cdata.i must be included first to provide the SWIGCDATA typemaps.  As
+ * with the element accessors, no bounds checking is performed.
+ * ----------------------------------------------------------------------------- */
+
+%define %array_functions_block(TYPE,NAME)
+%typemap(in) (const void *blockdata, size_t blocklen) = (char *STRING, int LENGTH);
+%{
+#include <string.h>
+static SWIGCDATA NAME##_getblock(TYPE *ary, size_t offset, size_t nelements) {
+    SWIGCDATA d;
+    d.data = (char *) (ary + offset);
+    d.len = nelements*sizeof(TYPE);
+    return d;
+}
+static void NAME##_setblock(TYPE *ary, size_t offset, const void *blockdata, size_t blocklen) {
+    memcpy(ary + offset, blockdata, blocklen);
+}
+%}
+
+SWIGCDATA NAME##_getblock(TYPE *ary, size_t offset, size_t nelements);
+void NAME##_setblock(TYPE *ary, size_t offset, const void *blockdata, size_t blocklen);
+
+%enddef
+
+/* -----------------------------------------------------------------------------
+ * %array_class_block(TYPE,NAME)
+ *
+ * Adds bulk transfer methods to a class generated by %array_class:
+ *
+ *          struct NAME {
+ *              ...
+ *              SWIGCDATA getblock(size_t offset, size_t nelements);
+ *              void setblock(size_t offset, const void *blockdata, size_t blocklen);
+ *          }
+ *
+ * Same conventions as %array_functions_block: cdata.i must be included
+ * first, getblock returns a binary string, setblock copies one over the
+ * slice, and no bounds checking is performed.
+ * ----------------------------------------------------------------------------- */
+
+%define %array_class_block(TYPE,NAME)
+%typemap(in) (const void *blockdata, size_t blocklen) = (char *STRING, int LENGTH);
+%extend NAME {
+
+SWIGCDATA getblock(size_t offset, size_t nelements) {
+  SWIGCDATA d;
+  d.data = (char *) (self + offset);
+  d.len = nelements*sizeof(TYPE);
+  return d;
+}
+void setblock(size_t offset, const void *blockdata, size_t blocklen) {
+  memcpy(self + offset, blockdata, blocklen);
+}
+
+};
+
+%enddef
+
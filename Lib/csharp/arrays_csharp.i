@@ -49,6 +49,26 @@
  *   %csmethodmodifiers myArrayCopy "public unsafe";
  *   void myArrayCopy( int *sourceArray, int* targetArray, int nitems );
  *
+ * Span approach
+ * -------------
+ * Variants of the pinning typemaps taking System.Span<T> / System.ReadOnlySpan<T>
+ * instead of an array. Like the FIXED typemaps no copying is done - the span is
+ * pinned for the duration of the call - but the caller can pass stackalloc'd
+ * memory, slices of larger buffers or memory obtained from a pool as well as
+ * arrays, so hot call paths need not allocate at all. The same garbage
+ * collection caveats as for the pinning typemaps apply, and the wrapped method
+ * must equally be marked unsafe. Requires Span support in the target framework
+ * (.NET Core 2.1+ / .NET Standard 2.1 or the System.Memory package) and C# 7.3
+ * or later for the fixed statement over a span.
+ *
+ * Example usage:
+ *
+ *   %include "arrays_csharp.i"
+ *   %apply int READONLYSPAN[] { int* sourceArray }
+ *   %apply int SPAN[] { int* targetArray }
+ *   %csmethodmodifiers myArrayCopy "public unsafe";
+ *   void myArrayCopy( int *sourceArray, int* targetArray, int nitems );
+ *
  * ----------------------------------------------------------------------------- */
 
 %define CSHARP_ARRAYS( CTYPE, CSTYPE )
@@ -177,3 +197,50 @@ CSHARP_ARRAYS_FIXED(float, float)
 CSHARP_ARRAYS_FIXED(double, double)
 CSHARP_ARRAYS_FIXED(bool, bool)
 
+
+%define CSHARP_ARRAYS_SPAN( CTYPE, CSTYPE )
+
+// writable spans
+
+%typemap(ctype)   CTYPE SPAN[] "CTYPE*"
+%typemap(imtype)  CTYPE SPAN[] "global::System.IntPtr"
+%typemap(cstype)  CTYPE SPAN[] "global::System.Span<CSTYPE>"
+%typemap(csin,
+           pre=       "    fixed ( CSTYPE* swig_ptrTo_$csinput = $csinput ) {",
+           terminator="    }")
+                  CTYPE SPAN[] "(global::System.IntPtr)swig_ptrTo_$csinput"
+
+%typemap(in)      CTYPE SPAN[] "$1 = $input;"
+%typemap(freearg) CTYPE SPAN[] ""
+%typemap(argout)  CTYPE SPAN[] ""
+
+// read only spans
+
+%typemap(ctype)   CTYPE READONLYSPAN[] "CTYPE*"
+%typemap(imtype)  CTYPE READONLYSPAN[] "global::System.IntPtr"
+%typemap(cstype)  CTYPE READONLYSPAN[] "global::System.ReadOnlySpan<CSTYPE>"
+%typemap(csin,
+           pre=       "    fixed ( CSTYPE* swig_ptrTo_$csinput = $csinput ) {",
+           terminator="    }")
+                  CTYPE READONLYSPAN[] "(global::System.IntPtr)swig_ptrTo_$csinput"
+
+%typemap(in)      CTYPE READONLYSPAN[] "$1 = $input;"
+%typemap(freearg) CTYPE READONLYSPAN[] ""
+%typemap(argout)  CTYPE READONLYSPAN[] ""
+
+%enddef // CSHARP_ARRAYS_SPAN
+
+CSHARP_ARRAYS_SPAN(signed char, sbyte)
+CSHARP_ARRAYS_SPAN(unsigned char, byte)
+CSHARP_ARRAYS_SPAN(short, short)
+CSHARP_ARRAYS_SPAN(unsigned short, ushort)
+CSHARP_ARRAYS_SPAN(int, int)
+CSHARP_ARRAYS_SPAN(unsigned int, uint)
+CSHARP_ARRAYS_SPAN(long, int)
+CSHARP_ARRAYS_SPAN(unsigned long, uint)
+CSHARP_ARRAYS_SPAN(long long, long)
+CSHARP_ARRAYS_SPAN(unsigned long long, ulong)
+CSHARP_ARRAYS_SPAN(float, float)
+CSHARP_ARRAYS_SPAN(double, double)
+CSHARP_ARRAYS_SPAN(bool, bool)
+
@@ -0,0 +1,63 @@
+/* -----------------------------------------------------------------------------
+ * dstrings_nogc.i
+ *
+ * Alternative char* marshalling for D2 that stays off the garbage collector.
+ * The default typemaps in dstrings.swg allocate GC memory on every call:
+ * std.string.toStringz copies each argument and std.conv.to!string copies
+ * each result.  Including this file after the standard library replaces the
+ * char* family with @nogc-compatible marshalling:
+ *
+ *   - arguments are zero-terminated into a fixed stack buffer, falling back
+ *     to malloc/free for strings that do not fit;
+ *   - results are returned as const(char)[] slices of the C memory
+ *     (std.string.fromStringz), so proxy methods return a view instead of
+ *     a copy.  The slice is only valid as long as the underlying C buffer;
+ *     callers that need to keep the result must .idup it explicitly.
+ *
+ * Director typemaps are not replaced: a director result must outlive the
+ * callback frame, so the GC copy there is load-bearing.  Not supported
+ * together with -splitproxy, as the helpers live in the main proxy module.
+ * ----------------------------------------------------------------------------- */
+
+#if (SWIG_D_VERSION == 1)
+#error "dstrings_nogc.i requires D version 2."
+#endif
+
+%pragma(d) proxydmodulecode = %{
+private const(char)* swigToStringzNoGC(const(char)[] s, char[] buf) @nogc nothrow {
+  import core.stdc.stdlib : malloc;
+  if (s is null)
+    return null;
+  if (s.length < buf.length) {
+    buf[0 .. s.length] = s[];
+    buf[s.length] = '\0';
+    return buf.ptr;
+  } else {
+    char* p = cast(char*) malloc(s.length + 1);
+    if (p is null)
+      return null;
+    p[0 .. s.length] = s[];
+    p[s.length] = '\0';
+    return p;
+  }
+}
+
+private void swigFreeStringzNoGC(const(char)* p, const(char)[] buf) @nogc nothrow {
+  import core.stdc.stdlib : free;
+  if (p !is null && (p < buf.ptr || p >= buf.ptr + buf.length))
+    free(cast(void*) p);
+}
+%}
+
+%typemap(imtype) char *, char *&, char[ANY], char[] "const(char)*"
+%typemap(dtype) char *, char *&, char[ANY], char[] "const(char)[]"
+
+%typemap(din,
+         pre="    char[257] swigbuf_$dinput = void;\n    const(char)* swigzstr_$dinput = swigToStringzNoGC($dinput, swigbuf_$dinput);",
+         post="      swigFreeStringzNoGC(swigzstr_$dinput, swigbuf_$dinput);"
+        ) char *, char *&, char[ANY], char[] "swigzstr_$dinput"
+
+%typemap(dout, excode=SWIGEXCODE) char *, char *&, char[ANY], char[] {
+  const(char)[] ret = std.string.fromStringz($imcall);$excode
+  return ret;
+}
@@ -285,25 +285,40 @@ SWIGINTERN void SWIG_DThrowException(int code, const char *msg) {
 %{
 #include <typeinfo>
 #include <stdexcept>
+
+/* Map the in-flight std::exception to a SWIG error code.  Keeping the
+ * dispatch in one cold helper means SWIG_CATCH_STDEXCEPT needs only a
+ * single catch clause per wrapper instead of one landing pad per standard
+ * exception type, which matters for the code size of large generated
+ * modules.  The rethrow idiom keeps the same catch order as the old
+ * per-wrapper ladder and, unlike dynamic_cast, also works with -fno-rtti.
+ * Only call this from within a catch block. */
+SWIGINTERN int SWIG_StdExceptionCode(void) {
+  try {
+    throw;
+  } catch (std::invalid_argument&) {
+    return SWIG_ValueError;
+  } catch (std::domain_error&) {
+    return SWIG_ValueError;
+  } catch (std::overflow_error&) {
+    return SWIG_OverflowError;
+  } catch (std::out_of_range&) {
+    return SWIG_IndexError;
+  } catch (std::length_error&) {
+    return SWIG_IndexError;
+  } catch (std::runtime_error&) {
+    return SWIG_RuntimeError;
+  } catch (std::bad_cast&) {
+    return SWIG_TypeError;
+  } catch (...) {
+    return SWIG_SystemError;
+  }
+}
 %}
 %define SWIG_CATCH_STDEXCEPT
   /* catching std::exception  */
-  catch (std::invalid_argument& e) {
-    SWIG_exception(SWIG_ValueError, e.what() );
-  } catch (std::domain_error& e) {
-    SWIG_exception(SWIG_ValueError, e.what() );
-  } catch (std::overflow_error& e) {
-    SWIG_exception(SWIG_OverflowError, e.what() );
-  } catch (std::out_of_range& e) {
-    SWIG_exception(SWIG_IndexError, e.what() );
-  } catch (std::length_error& e) {
-    SWIG_exception(SWIG_IndexError, e.what() );
-  } catch (std::runtime_error& e) {
-    SWIG_exception(SWIG_RuntimeError, e.what() );
-  } catch (std::bad_cast& e) {
-    SWIG_exception(SWIG_TypeError, e.what() );
-  } catch (std::exception& e) {
-    SWIG_exception(SWIG_SystemError, e.what() );
+  catch (std::exception& e) {
+    SWIG_exception(SWIG_StdExceptionCode(), e.what() );
   }
 %enddef
 %define SWIG_CATCH_UNKNOWN
@@ -379,14 +379,130 @@ JAVA_ARRAYS_TYPEMAPS(double, double, jdouble, Double, "[D")     /* double[ANY] *
   }
   if (!SWIG_JavaArrayInInt(jenv, &jarr, (int **)&$1, $input)) return $null;
 }
-%typemap(argout) ARRAYSOFENUMS[ANY], ARRAYSOFENUMS[] 
+%typemap(argout) ARRAYSOFENUMS[ANY], ARRAYSOFENUMS[]
 %{ SWIG_JavaArrayArgoutInt(jenv, jarr$argnum, (int *)$1, $input); %}
-%typemap(out) ARRAYSOFENUMS[ANY] 
+%typemap(out) ARRAYSOFENUMS[ANY]
 %{$result = SWIG_JavaArrayOutInt(jenv, (int *)$1, $1_dim0); %}
-%typemap(freearg) ARRAYSOFENUMS[ANY], ARRAYSOFENUMS[] 
+%typemap(freearg) ARRAYSOFENUMS[ANY], ARRAYSOFENUMS[]
 #ifdef __cplusplus
 %{ delete [] $1; %}
 #else
 %{ free($1); %}
 #endif
 
+
+/*
+ * CTYPE *CRITICAL_ARRAY typemaps.
+ * Zero-copy alternative to the array typemaps above for performance critical
+ * functions. The C function is given the storage of the Java array itself via
+ * GetPrimitiveArrayCritical, so nothing is copied in either direction and any
+ * writes made by the C function are seen by the caller. The Java array element
+ * storage is simply reinterpreted as the C type, so these typemaps are only
+ * instantiated for C types whose size and representation match the JNI array
+ * element type exactly (note that this differs from the copying typemaps,
+ * which widen the unsigned types to preserve their value range, and that
+ * long/unsigned long are excluded as their size is platform dependent).
+ *
+ * The JVM may disable garbage collection while the critical region is held,
+ * which lasts for the duration of the C call: the wrapped function must not
+ * block indefinitely, call back into Java or call any other JNI function.
+ * Use the copying typemaps for anything that does.
+ *
+ * Example usage wrapping:
+ *   %apply int *CRITICAL_ARRAY { int *samples };
+ *   void process(int *samples, int len);
+ *
+ * Java usage:
+ *   int[] samples = new int[65536];
+ *   modulename.process(samples, samples.length);
+ */
+%define JAVA_ARRAYS_CRITICAL_TYPEMAPS(CTYPE, JTYPE, JNITYPE)
+%typemap(jni) CTYPE *CRITICAL_ARRAY    %{JNITYPE##Array%}
+%typemap(jtype) CTYPE *CRITICAL_ARRAY  %{JTYPE[]%}
+%typemap(jstype) CTYPE *CRITICAL_ARRAY %{JTYPE[]%}
+
+%typemap(in) CTYPE *CRITICAL_ARRAY
+%{  if (!$input) {
+    SWIG_JavaThrowException(jenv, SWIG_JavaNullPointerException, "null array");
+    return $null;
+  }
+  $1 = (CTYPE *) JCALL2(GetPrimitiveArrayCritical, jenv, $input, 0);
+  if (!$1) return $null; %}
+%typemap(argout) CTYPE *CRITICAL_ARRAY
+%{ JCALL3(ReleasePrimitiveArrayCritical, jenv, $input, $1, 0); %}
+
+%typemap(javain) CTYPE *CRITICAL_ARRAY "$javainput"
+
+/* Prevent default freearg typemap from being used */
+%typemap(freearg) CTYPE *CRITICAL_ARRAY ""
+%enddef
+
+JAVA_ARRAYS_CRITICAL_TYPEMAPS(signed char, byte, jbyte)          /* signed char* <-> byte[] */
+JAVA_ARRAYS_CRITICAL_TYPEMAPS(unsigned char, byte, jbyte)        /* unsigned char* <-> byte[] */
+JAVA_ARRAYS_CRITICAL_TYPEMAPS(short, short, jshort)              /* short* <-> short[] */
+JAVA_ARRAYS_CRITICAL_TYPEMAPS(unsigned short, short, jshort)     /* unsigned short* <-> short[] */
+JAVA_ARRAYS_CRITICAL_TYPEMAPS(int, int, jint)                    /* int* <-> int[] */
+JAVA_ARRAYS_CRITICAL_TYPEMAPS(unsigned int, int, jint)           /* unsigned int* <-> int[] */
+JAVA_ARRAYS_CRITICAL_TYPEMAPS(long long, long, jlong)            /* long long* <-> long[] */
+JAVA_ARRAYS_CRITICAL_TYPEMAPS(unsigned long long, long, jlong)   /* unsigned long long* <-> long[] */
+JAVA_ARRAYS_CRITICAL_TYPEMAPS(float, float, jfloat)              /* float* <-> float[] */
+JAVA_ARRAYS_CRITICAL_TYPEMAPS(double, double, jdouble)           /* double* <-> double[] */
+
+
+/*
+ * CTYPE *NIOBUFFER typemaps.
+ * Typed direct buffer variants of the unsigned char *NIOBUFFER typemaps in
+ * various.i. The C function receives the address of a direct java.nio buffer
+ * of the matching element type, so data crosses JNI without any copying and
+ * without holding a critical region - unlike CRITICAL_ARRAY, the wrapped
+ * function may block or call back into Java, and may retain the pointer for
+ * as long as the caller keeps the buffer alive.
+ * Note: The Java buffer has to be allocated with allocateDirect (for the
+ * typed buffers: ByteBuffer.allocateDirect(n * size).order(nativeOrder())
+ * followed by asIntBuffer() and so on).
+ *
+ * Example usage wrapping:
+ *   %apply float *NIOBUFFER { float *buf };
+ *   void foo(float *buf, int len);
+ *
+ * Java usage:
+ *   java.nio.FloatBuffer b = java.nio.ByteBuffer.allocateDirect(4*20)
+ *       .order(java.nio.ByteOrder.nativeOrder()).asFloatBuffer();
+ *   modulename.foo(b, b.capacity());
+ */
+%define JAVA_ARRAYS_NIOBUFFER_TYPEMAPS(CTYPE, BUFFERCLASS)
+%typemap(jni) CTYPE *NIOBUFFER "jobject"
+%typemap(jtype) CTYPE *NIOBUFFER "java.nio.BUFFERCLASS"
+%typemap(jstype) CTYPE *NIOBUFFER "java.nio.BUFFERCLASS"
+%typemap(javain,
+  pre="  assert $javainput.isDirect() : \"Buffer must be allocated direct.\";") CTYPE *NIOBUFFER "$javainput"
+%typemap(javaout) CTYPE *NIOBUFFER {
+  return $jnicall;
+}
+%typemap(in) CTYPE *NIOBUFFER {
+  $1 = (CTYPE *) JCALL1(GetDirectBufferAddress, jenv, $input);
+  if ($1 == NULL) {
+    SWIG_JavaThrowException(jenv, SWIG_JavaRuntimeException, "Unable to get address of a java.nio buffer. Buffer must be a direct buffer and not a non-direct buffer.");
+  }
+}
+%typemap(memberin) CTYPE *NIOBUFFER {
+  if ($input) {
+    $1 = $input;
+  } else {
+    $1 = 0;
+  }
+}
+%typemap(freearg) CTYPE *NIOBUFFER ""
+%enddef
+
+JAVA_ARRAYS_NIOBUFFER_TYPEMAPS(signed char, ByteBuffer)          /* signed char* <-> ByteBuffer */
+JAVA_ARRAYS_NIOBUFFER_TYPEMAPS(unsigned char, ByteBuffer)        /* unsigned char* <-> ByteBuffer */
+JAVA_ARRAYS_NIOBUFFER_TYPEMAPS(short, ShortBuffer)               /* short* <-> ShortBuffer */
+JAVA_ARRAYS_NIOBUFFER_TYPEMAPS(unsigned short, ShortBuffer)      /* unsigned short* <-> ShortBuffer */
+JAVA_ARRAYS_NIOBUFFER_TYPEMAPS(int, IntBuffer)                   /* int* <-> IntBuffer */
+JAVA_ARRAYS_NIOBUFFER_TYPEMAPS(unsigned int, IntBuffer)          /* unsigned int* <-> IntBuffer */
+JAVA_ARRAYS_NIOBUFFER_TYPEMAPS(long long, LongBuffer)            /* long long* <-> LongBuffer */
+JAVA_ARRAYS_NIOBUFFER_TYPEMAPS(unsigned long long, LongBuffer)   /* unsigned long long* <-> LongBuffer */
+JAVA_ARRAYS_NIOBUFFER_TYPEMAPS(float, FloatBuffer)               /* float* <-> FloatBuffer */
+JAVA_ARRAYS_NIOBUFFER_TYPEMAPS(double, DoubleBuffer)             /* double* <-> DoubleBuffer */
+
@@ -0,0 +1,101 @@
+/* -----------------------------------------------------------------------------
+ * arraybuffer.i
+ *
+ * Zero-copy typemaps for passing large binary payloads between JavaScript and
+ * C/C++.  Unlike arrays_javascript.i, which converts element by element, these
+ * typemaps hand the C function a pointer directly into the backing store of an
+ * ArrayBuffer or TypedArray, so no data is copied in either direction.  The
+ * pointer is only valid for the duration of the call; the C function must not
+ * retain it.
+ *
+ * The typemaps are applied by parameter name:
+ *
+ *   %include <arraybuffer.i>
+ *   %apply (void *ARRAYBUFFER, size_t LENGTH) { (void *data, size_t size) };
+ *   %inline %{
+ *       void process(void *data, size_t size);
+ *   %}
+ *
+ * Use from JavaScript with an ArrayBuffer or any TypedArray view (a view's
+ * byte offset and byte length are respected):
+ *
+ *   example.process(new Uint8Array(buf, 16, 1024));
+ *
+ * For returning large buffers without a copy, the SWIGV8_NewExternalArrayBuffer
+ * helper wraps caller-owned memory in an ArrayBuffer; the memory must outlive
+ * the buffer object.  It is intended for custom out typemaps, e.g.:
+ *
+ *   %typemap(out, fragment="SWIGV8_NewExternalArrayBuffer") void *getframe
+ *     { $result = SWIGV8_NewExternalArrayBuffer($1, arg1->framesize()); }
+ *
+ * Requires a V8 new enough to provide v8::ArrayBuffer::GetContents (3.25+);
+ * on V8 7.9 and later the backing store API is used instead.
+ * ----------------------------------------------------------------------------- */
+
+%fragment("SWIGV8_ArrayBufferData", "header") %{
+SWIGINTERN bool SWIGV8_ArrayBufferData(v8::Local<v8::Value> value, void **data, size_t *length) {
+  if (value->IsArrayBufferView()) {
+    v8::Local<v8::ArrayBufferView> view = v8::Local<v8::ArrayBufferView>::Cast(value);
+    v8::Local<v8::ArrayBuffer> buffer = view->Buffer();
+#if (V8_MAJOR_VERSION-0) > 7 || ((V8_MAJOR_VERSION-0) == 7 && (V8_MINOR_VERSION-0) >= 9)
+    *data = static_cast<char *>(buffer->GetBackingStore()->Data()) + view->ByteOffset();
+#else
+    *data = static_cast<char *>(buffer->GetContents().Data()) + view->ByteOffset();
+#endif
+    *length = view->ByteLength();
+    return true;
+  }
+  if (value->IsArrayBuffer()) {
+    v8::Local<v8::ArrayBuffer> buffer = v8::Local<v8::ArrayBuffer>::Cast(value);
+#if (V8_MAJOR_VERSION-0) > 7 || ((V8_MAJOR_VERSION-0) == 7 && (V8_MINOR_VERSION-0) >= 9)
+    *data = buffer->GetBackingStore()->Data();
+#else
+    *data = buffer->GetContents().Data();
+#endif
+    *length = buffer->ByteLength();
+    return true;
+  }
+  return false;
+}
+%}
+
+%fragment("SWIGV8_NewExternalArrayBuffer", "header") %{
+SWIGINTERN v8::Local<v8::ArrayBuffer> SWIGV8_NewExternalArrayBuffer(void *data, size_t length) {
+#if (V8_MAJOR_VERSION-0) > 7 || ((V8_MAJOR_VERSION-0) == 7 && (V8_MINOR_VERSION-0) >= 9)
+  std::unique_ptr<v8::BackingStore> store =
+    v8::ArrayBuffer::NewBackingStore(data, length, v8::BackingStore::EmptyDeleter, NULL);
+  return v8::ArrayBuffer::New(v8::Isolate::GetCurrent(), std::move(store));
+#else
+  return v8::ArrayBuffer::New(v8::Isolate::GetCurrent(), data, length);
+#endif
+}
+%}
+
+%define JAVASCRIPT_ARRAYBUFFER_TYPEMAPS(BUFFERTYPE)
+
+%typemap(in, fragment="SWIGV8_ArrayBufferData") (BUFFERTYPE *ARRAYBUFFER, size_t LENGTH) {
+  void *swig_data = NULL;
+  size_t swig_length = 0;
+  if (!SWIGV8_ArrayBufferData($input, &swig_data, &swig_length)) {
+    SWIG_exception_fail(SWIG_TypeError, "in method '$symname', argument $argnum is not an ArrayBuffer or TypedArray");
+  }
+  $1 = ($1_ltype)swig_data;
+  $2 = ($2_ltype)swig_length;
+}
+
+%typemap(freearg) (BUFFERTYPE *ARRAYBUFFER, size_t LENGTH) ""
+
+%typemap(typecheck, precedence=SWIG_TYPECHECK_POINTER) (BUFFERTYPE *ARRAYBUFFER, size_t LENGTH) {
+  $1 = ($input->IsArrayBuffer() || $input->IsArrayBufferView()) ? 1 : 0;
+}
+
+%enddef
+
+JAVASCRIPT_ARRAYBUFFER_TYPEMAPS(void)
+JAVASCRIPT_ARRAYBUFFER_TYPEMAPS(const void)
+JAVASCRIPT_ARRAYBUFFER_TYPEMAPS(char)
+JAVASCRIPT_ARRAYBUFFER_TYPEMAPS(const char)
+JAVASCRIPT_ARRAYBUFFER_TYPEMAPS(signed char)
+JAVASCRIPT_ARRAYBUFFER_TYPEMAPS(const signed char)
+JAVASCRIPT_ARRAYBUFFER_TYPEMAPS(unsigned char)
+JAVASCRIPT_ARRAYBUFFER_TYPEMAPS(const unsigned char)
@@ -89,7 +89,7 @@
     %argument_fail(res, "$type", $symname, $argnum);
   }
   if (newmem & SWIG_CAST_NEW_MEMORY) {
-    tempshared = *%reinterpret_cast(argp, SWIG_SHARED_PTR_QNAMESPACE::shared_ptr< CONST TYPE > *);
+    tempshared = SWIG_STD_MOVE((*%reinterpret_cast(argp, SWIG_SHARED_PTR_QNAMESPACE::shared_ptr< CONST TYPE > *)));
     delete %reinterpret_cast(argp, SWIG_SHARED_PTR_QNAMESPACE::shared_ptr< CONST TYPE > *);
     $1 = %const_cast(tempshared.get(), $1_ltype);
   } else {
@@ -113,7 +113,7 @@
   SWIG_SHARED_PTR_QNAMESPACE::shared_ptr< CONST TYPE > tempshared;
   SWIG_SHARED_PTR_QNAMESPACE::shared_ptr< CONST TYPE > *smartarg = 0;
   if (newmem & SWIG_CAST_NEW_MEMORY) {
-    tempshared = *%reinterpret_cast(argp, SWIG_SHARED_PTR_QNAMESPACE::shared_ptr< CONST TYPE > *);
+    tempshared = SWIG_STD_MOVE((*%reinterpret_cast(argp, SWIG_SHARED_PTR_QNAMESPACE::shared_ptr< CONST TYPE > *)));
     delete %reinterpret_cast(argp, SWIG_SHARED_PTR_QNAMESPACE::shared_ptr< CONST TYPE > *);
     $1 = %const_cast(tempshared.get(), $1_ltype);
   } else {
@@ -143,7 +143,7 @@
   }
   if (!argp) { %argument_nullref("$type", $symname, $argnum); }
   if (newmem & SWIG_CAST_NEW_MEMORY) {
-    tempshared = *%reinterpret_cast(argp, SWIG_SHARED_PTR_QNAMESPACE::shared_ptr< CONST TYPE > *);
+    tempshared = SWIG_STD_MOVE((*%reinterpret_cast(argp, SWIG_SHARED_PTR_QNAMESPACE::shared_ptr< CONST TYPE > *)));
     delete %reinterpret_cast(argp, SWIG_SHARED_PTR_QNAMESPACE::shared_ptr< CONST TYPE > *);
     $1 = %const_cast(tempshared.get(), $1_ltype);
   } else {
@@ -167,7 +167,7 @@
     %variable_nullref("$type", "$name");
   }
   if (newmem & SWIG_CAST_NEW_MEMORY) {
-    tempshared = *%reinterpret_cast(argp, SWIG_SHARED_PTR_QNAMESPACE::shared_ptr< CONST TYPE > *);
+    tempshared = SWIG_STD_MOVE((*%reinterpret_cast(argp, SWIG_SHARED_PTR_QNAMESPACE::shared_ptr< CONST TYPE > *)));
     delete %reinterpret_cast(argp, SWIG_SHARED_PTR_QNAMESPACE::shared_ptr< CONST TYPE > *);
     $1 = *%const_cast(tempshared.get(), $1_ltype);
   } else {
@@ -196,7 +196,7 @@
     %argument_fail(res, "$type", $symname, $argnum);
   }
   if (newmem & SWIG_CAST_NEW_MEMORY) {
-    tempshared = *%reinterpret_cast(argp, SWIG_SHARED_PTR_QNAMESPACE::shared_ptr< CONST TYPE > *);
+    tempshared = SWIG_STD_MOVE((*%reinterpret_cast(argp, SWIG_SHARED_PTR_QNAMESPACE::shared_ptr< CONST TYPE > *)));
     delete %reinterpret_cast(argp, SWIG_SHARED_PTR_QNAMESPACE::shared_ptr< CONST TYPE > *);
     temp = %const_cast(tempshared.get(), $*1_ltype);
   } else {
@@ -231,8 +231,12 @@
   if (!SWIG_IsOK(res)) {
     %argument_fail(res, "$type", $symname, $argnum);
   }
-  if (argp) $1 = *(%reinterpret_cast(argp, $&ltype));
-  if (newmem & SWIG_CAST_NEW_MEMORY) delete %reinterpret_cast(argp, $&ltype);
+  if (newmem & SWIG_CAST_NEW_MEMORY) {
+    if (argp) $1 = SWIG_STD_MOVE((*%reinterpret_cast(argp, $&ltype)));
+    delete %reinterpret_cast(argp, $&ltype);
+  } else {
+    if (argp) $1 = *(%reinterpret_cast(argp, $&ltype));
+  }
 }
 %typemap(out) SWIG_SHARED_PTR_QNAMESPACE::shared_ptr< CONST TYPE > {
   SWIG_SHARED_PTR_QNAMESPACE::shared_ptr< CONST TYPE > *smartresult = $1 ? new SWIG_SHARED_PTR_QNAMESPACE::shared_ptr< CONST TYPE >($1) : 0;
@@ -246,8 +250,12 @@
   if (!SWIG_IsOK(res)) {
     %variable_fail(res, "$type", "$name");
   }
-  $1 = argp ? *(%reinterpret_cast(argp, $&ltype)) : SWIG_SHARED_PTR_QNAMESPACE::shared_ptr< TYPE >();
-  if (newmem & SWIG_CAST_NEW_MEMORY) delete %reinterpret_cast(argp, $&ltype);
+  if (newmem & SWIG_CAST_NEW_MEMORY) {
+    $1 = argp ? SWIG_STD_MOVE((*%reinterpret_cast(argp, $&ltype))) : SWIG_SHARED_PTR_QNAMESPACE::shared_ptr< TYPE >();
+    delete %reinterpret_cast(argp, $&ltype);
+  } else {
+    $1 = argp ? *(%reinterpret_cast(argp, $&ltype)) : SWIG_SHARED_PTR_QNAMESPACE::shared_ptr< TYPE >();
+  }
 }
 %typemap(varout) SWIG_SHARED_PTR_QNAMESPACE::shared_ptr< CONST TYPE > {
   SWIG_SHARED_PTR_QNAMESPACE::shared_ptr< CONST TYPE > *smartresult = $1 ? new SWIG_SHARED_PTR_QNAMESPACE::shared_ptr< CONST TYPE >($1) : 0;
@@ -265,8 +273,12 @@
     %dirout_fail(swig_res, "$type");
   }
   if (swig_argp) {
-    $result = *(%reinterpret_cast(swig_argp, $&ltype));
-    if (newmem & SWIG_CAST_NEW_MEMORY) delete %reinterpret_cast(swig_argp, $&ltype);
+    if (newmem & SWIG_CAST_NEW_MEMORY) {
+      $result = SWIG_STD_MOVE((*%reinterpret_cast(swig_argp, $&ltype)));
+      delete %reinterpret_cast(swig_argp, $&ltype);
+    } else {
+      $result = *(%reinterpret_cast(swig_argp, $&ltype));
+    }
   }
 }
 
@@ -278,7 +290,7 @@
     %argument_fail(res, "$type", $symname, $argnum);
   }
   if (newmem & SWIG_CAST_NEW_MEMORY) {
-    if (argp) tempshared = *%reinterpret_cast(argp, $ltype);
+    if (argp) tempshared = SWIG_STD_MOVE((*%reinterpret_cast(argp, $ltype)));
     delete %reinterpret_cast(argp, $ltype);
     $1 = &tempshared;
   } else {
@@ -313,7 +325,7 @@
     %argument_fail(res, "$type", $symname, $argnum);
   }
   if (newmem & SWIG_CAST_NEW_MEMORY) {
-    if (argp) tempshared = *%reinterpret_cast(argp, $ltype);
+    if (argp) tempshared = SWIG_STD_MOVE((*%reinterpret_cast(argp, $ltype)));
     delete %reinterpret_cast(argp, $ltype);
     $1 = &tempshared;
   } else {
@@ -348,8 +360,12 @@
   if (!SWIG_IsOK(res)) {
     %argument_fail(res, "$type", $symname, $argnum);
   }
-  if (argp) tempshared = *%reinterpret_cast(argp, $*ltype);
-  if (newmem & SWIG_CAST_NEW_MEMORY) delete %reinterpret_cast(argp, $*ltype);
+  if (newmem & SWIG_CAST_NEW_MEMORY) {
+    if (argp) tempshared = SWIG_STD_MOVE((*%reinterpret_cast(argp, $*ltype)));
+    delete %reinterpret_cast(argp, $*ltype);
+  } else {
+    if (argp) tempshared = *%reinterpret_cast(argp, $*ltype);
+  }
   temp = &tempshared;
   $1 = &temp;
 }
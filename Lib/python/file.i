@@ -10,9 +10,13 @@
 %fragment("SWIG_AsValFilePtr","header") {
 SWIGINTERN int
 SWIG_AsValFilePtr(PyObject *obj, FILE **val) {
+  static int init = 0;
   static swig_type_info* desc = 0;
   void *vptr = 0;
-  if (!desc) desc = SWIG_TypeQuery("FILE *");
+  if (!init) {
+    desc = SWIG_TypeQuery("FILE *");
+    init = 1;
+  }
   if ((SWIG_ConvertPtr(obj, &vptr, desc, 0)) == SWIG_OK) {
     if (val) *val = (FILE *)vptr;
     return SWIG_OK;
@@ -117,3 +117,128 @@
   $1 = ($1_ltype) buf;
 }
 %enddef
+
+/* %pybuffer_vector(TYPE, FORMAT)
+ *
+ * Macro mapping std::vector<TYPE> through the buffer protocol instead of
+ * the element-by-element conversions of std_vector.i.  FORMAT is the
+ * struct-module format string for TYPE ("d" for double, "i" for int, ...).
+ * For example:
+ *
+ *      %pybuffer_vector(double, "d");
+ *      std::vector<double> make(size_t n);
+ *      double total(const std::vector<double> &v);
+ *
+ * Vectors returned by value hand their storage to a memoryview without
+ * copying the elements: the storage is swapped into a heap vector owned
+ * by a capsule that the memoryview keeps alive.  Input arguments accept
+ * any C-contiguous object supporting the buffer protocol whose length is
+ * a multiple of sizeof(TYPE); the data is filled into the vector with one
+ * bulk assignment (a vector owns its elements, so input cannot borrow).
+ */
+
+%fragment("SwigPyBufferVector", "header") %{
+#include <vector>
+namespace swig {
+  /* PyMemoryView_FromBuffer rejects a NULL buf, so empty vectors point at
+     this zero-length placeholder instead */
+  static char pybuffer_vector_empty[1];
+  template <class Vector> static void pybuffer_vector_free(PyObject *cap) {
+    delete reinterpret_cast<Vector *>(PyCapsule_GetPointer(cap, NULL));
+  }
+  /* Build a typed memoryview over a raw buffer.  PyMemoryView_FromBuffer
+     treats a shape-less buffer as plain bytes, so the typed view is made
+     by casting the byte view to the requested element format. */
+  inline PyObject *pybuffer_view_cast(Py_buffer *view, const char *format) {
+    PyObject *bytes_view = PyMemoryView_FromBuffer(view);
+    PyObject *typed;
+    if (!bytes_view)
+      return NULL;
+    typed = PyObject_CallMethod(bytes_view, (char *)"cast", (char *)"s", format);
+    Py_DECREF(bytes_view);
+    return typed;
+  }
+  template <class Vector> PyObject *pybuffer_vector_view(Vector *owned, const char *format, size_t itemsize) {
+    PyObject *result;
+    Py_buffer view;
+    PyObject *cap = PyCapsule_New(owned, NULL, pybuffer_vector_free<Vector>);
+    if (!cap) {
+      delete owned;
+      return NULL;
+    }
+    if (PyBuffer_FillInfo(&view, cap, owned->empty() ? (void *)pybuffer_vector_empty : (void *)&(*owned)[0],
+                          (Py_ssize_t)(owned->size() * itemsize), 0, PyBUF_CONTIG) < 0) {
+      Py_DECREF(cap);
+      return NULL;
+    }
+    result = pybuffer_view_cast(&view, format);
+    /* the memoryview now holds the reference to the capsule taken by
+       PyBuffer_FillInfo and releases it with the buffer */
+    Py_DECREF(cap);
+    return result;
+  }
+}
+%}
+
+%define %pybuffer_vector(TYPE, FORMAT)
+%typemap(in, fragment="SwigPyBufferVector") const std::vector<TYPE> & (std::vector<TYPE> temp) {
+  Py_buffer view;
+  if (PyObject_GetBuffer($input, &view, PyBUF_CONTIG_RO) < 0) {
+    PyErr_Clear();
+    %argument_fail(SWIG_TypeError, "contiguous buffer of TYPE", $symname, $argnum);
+  }
+  if (view.len % sizeof(TYPE) != 0) {
+    PyBuffer_Release(&view);
+    %argument_fail(SWIG_ValueError, "buffer length not a multiple of sizeof(TYPE)", $symname, $argnum);
+  }
+  temp.assign((const TYPE *)view.buf, (const TYPE *)view.buf + view.len / sizeof(TYPE));
+  PyBuffer_Release(&view);
+  $1 = &temp;
+}
+%typemap(in, fragment="SwigPyBufferVector") std::vector<TYPE> {
+  Py_buffer view;
+  if (PyObject_GetBuffer($input, &view, PyBUF_CONTIG_RO) < 0) {
+    PyErr_Clear();
+    %argument_fail(SWIG_TypeError, "contiguous buffer of TYPE", $symname, $argnum);
+  }
+  if (view.len % sizeof(TYPE) != 0) {
+    PyBuffer_Release(&view);
+    %argument_fail(SWIG_ValueError, "buffer length not a multiple of sizeof(TYPE)", $symname, $argnum);
+  }
+  $1.assign((const TYPE *)view.buf, (const TYPE *)view.buf + view.len / sizeof(TYPE));
+  PyBuffer_Release(&view);
+}
+%typemap(out, fragment="SwigPyBufferVector") std::vector<TYPE> {
+  std::vector<TYPE> *owned = new std::vector<TYPE>();
+  owned->swap($1);
+  $result = swig::pybuffer_vector_view(owned, FORMAT, sizeof(TYPE));
+  if (!$result) SWIG_fail;
+}
+%enddef
+
+/* %pybuffer_vector_ref(TYPE, FORMAT)
+ *
+ * Companion to %pybuffer_vector for functions returning a reference to a
+ * vector: the memoryview borrows the vector's current storage with no
+ * copy at all.  The view is only valid while the vector is alive and not
+ * resized; this is the caller's responsibility, which is why reference
+ * returns are a separate opt-in.  A const reference yields a read-only
+ * view.
+ */
+
+%define %pybuffer_vector_ref(TYPE, FORMAT)
+%typemap(out, fragment="SwigPyBufferVector") const std::vector<TYPE> & {
+  Py_buffer view;
+  if (PyBuffer_FillInfo(&view, NULL, $1->empty() ? (void *)swig::pybuffer_vector_empty : (void *)&(*$1)[0],
+                        (Py_ssize_t)($1->size() * sizeof(TYPE)), 1, PyBUF_CONTIG_RO) < 0) SWIG_fail;
+  $result = swig::pybuffer_view_cast(&view, FORMAT);
+  if (!$result) SWIG_fail;
+}
+%typemap(out, fragment="SwigPyBufferVector") std::vector<TYPE> & {
+  Py_buffer view;
+  if (PyBuffer_FillInfo(&view, NULL, $1->empty() ? (void *)swig::pybuffer_vector_empty : (void *)&(*$1)[0],
+                        (Py_ssize_t)($1->size() * sizeof(TYPE)), 0, PyBUF_CONTIG) < 0) SWIG_fail;
+  $result = swig::pybuffer_view_cast(&view, FORMAT);
+  if (!$result) SWIG_fail;
+}
+%enddef
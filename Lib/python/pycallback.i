@@ -0,0 +1,201 @@
+/* -----------------------------------------------------------------------------
+ * pycallback.i
+ *
+ * Trampoline pools for binding Python callables to C function pointers.
+ *
+ * The %callback machinery only exposes existing C functions as callback
+ * constants; handing a Python function to a C API that stores a plain
+ * function pointer normally requires a director class.  For APIs that
+ * register per-event hooks, these macros generate a small pool of typed
+ * static trampolines at compile time instead: registering a callable just
+ * claims a free slot (no allocation), and the call path from C is the
+ * trampoline plus one table dispatch.
+ *
+ *   %python_callback_pool(name, rettype, retfmt, retdefault, parms, buildargs)
+ *   %python_callback_pool_void(name, parms, buildargs)
+ *
+ * generate, for the function pointer type  rettype (*)parms :
+ *
+ *   typedef rettype (*name_fn)parms;
+ *   name_fn name_register(PyObject *func);   claim a slot, return the
+ *                                            trampoline to pass to the C API
+ *   void name_unregister(name_fn fn);        release the slot again
+ *
+ * 'parms' is the parenthesized C parameter list, 'buildargs' the complete
+ * parenthesized Py_BuildValue() argument list turning those parameters into
+ * the Python call arguments, 'retfmt' a PyArg_Parse() format converting the
+ * Python result back to 'rettype', and 'retdefault' the value returned to C
+ * when the callable raises.  For example:
+ *
+ *   %python_callback_pool(on_sample, int, "i", -1,
+ *                         (int channel, double value),
+ *                         ("(id)", channel, value))
+ *
+ * Each pool holds 16 trampolines; name_register raises RuntimeError when
+ * they are all claimed.  Trampolines acquire the GIL, so the C side may
+ * fire them from any thread; exceptions raised by the callable are printed
+ * via PyErr_Print() and 'retdefault' is returned.
+ * ----------------------------------------------------------------------------- */
+
+%define %_python_callback_tramp(NAME, RETTYPE, PARMS, BUILDARGS, SLOT)
+%{
+static RETTYPE NAME##_tramp_##SLOT PARMS {
+  RETTYPE swig_res;
+  PyGILState_STATE swig_gil = PyGILState_Ensure();
+  swig_res = NAME##_call(SLOT, Py_BuildValue BUILDARGS);
+  PyGILState_Release(swig_gil);
+  return swig_res;
+}
+%}
+%enddef
+
+%define %_python_callback_tramp_void(NAME, PARMS, BUILDARGS, SLOT)
+%{
+static void NAME##_tramp_##SLOT PARMS {
+  PyGILState_STATE swig_gil = PyGILState_Ensure();
+  NAME##_call(SLOT, Py_BuildValue BUILDARGS);
+  PyGILState_Release(swig_gil);
+}
+%}
+%enddef
+
+/* Registration API shared by both pool flavours.  The slot table is only
+   touched with the GIL held: register/unregister run in wrapper context and
+   the trampolines take it before dispatching. */
+%define %_python_callback_registry(NAME, RETTYPE, PARMS)
+%{
+typedef RETTYPE (*NAME##_fn) PARMS;
+
+static NAME##_fn const NAME##_tramps[16] = {
+  NAME##_tramp_0,  NAME##_tramp_1,  NAME##_tramp_2,  NAME##_tramp_3,
+  NAME##_tramp_4,  NAME##_tramp_5,  NAME##_tramp_6,  NAME##_tramp_7,
+  NAME##_tramp_8,  NAME##_tramp_9,  NAME##_tramp_10, NAME##_tramp_11,
+  NAME##_tramp_12, NAME##_tramp_13, NAME##_tramp_14, NAME##_tramp_15
+};
+
+static NAME##_fn NAME##_register(PyObject *func) {
+  int i;
+  if (!PyCallable_Check(func)) {
+    PyErr_SetString(PyExc_TypeError, #NAME "_register: argument is not callable");
+    return 0;
+  }
+  for (i = 0; i < 16; i++) {
+    if (!NAME##_slots[i]) {
+      Py_INCREF(func);
+      NAME##_slots[i] = func;
+      return NAME##_tramps[i];
+    }
+  }
+  PyErr_SetString(PyExc_RuntimeError, #NAME "_register: callback pool exhausted");
+  return 0;
+}
+
+static void NAME##_unregister(NAME##_fn fn) {
+  int i;
+  for (i = 0; i < 16; i++) {
+    if (NAME##_tramps[i] == fn && NAME##_slots[i]) {
+      Py_DECREF(NAME##_slots[i]);
+      NAME##_slots[i] = 0;
+      return;
+    }
+  }
+}
+%}
+
+typedef RETTYPE (*NAME##_fn) PARMS;
+
+%exception NAME##_register {
+  $action
+  if (!result) SWIG_fail;
+}
+
+NAME##_fn NAME##_register(PyObject *func);
+void NAME##_unregister(NAME##_fn fn);
+
+%enddef
+
+%define %python_callback_pool(NAME, RETTYPE, RETFMT, RETDEFAULT, PARMS, BUILDARGS)
+%{
+static PyObject *NAME##_slots[16];
+
+/* Called with the GIL held and ownership of swig_args. */
+static RETTYPE NAME##_call(int swig_slot, PyObject *swig_args) {
+  RETTYPE swig_result = RETDEFAULT;
+  PyObject *swig_ret = 0;
+  if (swig_args) {
+    if (NAME##_slots[swig_slot])
+      swig_ret = PyObject_CallObject(NAME##_slots[swig_slot], swig_args);
+    Py_DECREF(swig_args);
+  }
+  if (swig_ret) {
+    if (!PyArg_Parse(swig_ret, RETFMT, &swig_result))
+      PyErr_Print();
+    Py_DECREF(swig_ret);
+  } else if (PyErr_Occurred()) {
+    PyErr_Print();
+  }
+  return swig_result;
+}
+%}
+
+%_python_callback_tramp(NAME, RETTYPE, PARMS, BUILDARGS, 0)
+%_python_callback_tramp(NAME, RETTYPE, PARMS, BUILDARGS, 1)
+%_python_callback_tramp(NAME, RETTYPE, PARMS, BUILDARGS, 2)
+%_python_callback_tramp(NAME, RETTYPE, PARMS, BUILDARGS, 3)
+%_python_callback_tramp(NAME, RETTYPE, PARMS, BUILDARGS, 4)
+%_python_callback_tramp(NAME, RETTYPE, PARMS, BUILDARGS, 5)
+%_python_callback_tramp(NAME, RETTYPE, PARMS, BUILDARGS, 6)
+%_python_callback_tramp(NAME, RETTYPE, PARMS, BUILDARGS, 7)
+%_python_callback_tramp(NAME, RETTYPE, PARMS, BUILDARGS, 8)
+%_python_callback_tramp(NAME, RETTYPE, PARMS, BUILDARGS, 9)
+%_python_callback_tramp(NAME, RETTYPE, PARMS, BUILDARGS, 10)
+%_python_callback_tramp(NAME, RETTYPE, PARMS, BUILDARGS, 11)
+%_python_callback_tramp(NAME, RETTYPE, PARMS, BUILDARGS, 12)
+%_python_callback_tramp(NAME, RETTYPE, PARMS, BUILDARGS, 13)
+%_python_callback_tramp(NAME, RETTYPE, PARMS, BUILDARGS, 14)
+%_python_callback_tramp(NAME, RETTYPE, PARMS, BUILDARGS, 15)
+
+%_python_callback_registry(NAME, RETTYPE, PARMS)
+
+%enddef
+
+%define %python_callback_pool_void(NAME, PARMS, BUILDARGS)
+%{
+static PyObject *NAME##_slots[16];
+
+/* Called with the GIL held and ownership of swig_args. */
+static void NAME##_call(int swig_slot, PyObject *swig_args) {
+  PyObject *swig_ret = 0;
+  if (swig_args) {
+    if (NAME##_slots[swig_slot])
+      swig_ret = PyObject_CallObject(NAME##_slots[swig_slot], swig_args);
+    Py_DECREF(swig_args);
+  }
+  if (swig_ret) {
+    Py_DECREF(swig_ret);
+  } else if (PyErr_Occurred()) {
+    PyErr_Print();
+  }
+}
+%}
+
+%_python_callback_tramp_void(NAME, PARMS, BUILDARGS, 0)
+%_python_callback_tramp_void(NAME, PARMS, BUILDARGS, 1)
+%_python_callback_tramp_void(NAME, PARMS, BUILDARGS, 2)
+%_python_callback_tramp_void(NAME, PARMS, BUILDARGS, 3)
+%_python_callback_tramp_void(NAME, PARMS, BUILDARGS, 4)
+%_python_callback_tramp_void(NAME, PARMS, BUILDARGS, 5)
+%_python_callback_tramp_void(NAME, PARMS, BUILDARGS, 6)
+%_python_callback_tramp_void(NAME, PARMS, BUILDARGS, 7)
+%_python_callback_tramp_void(NAME, PARMS, BUILDARGS, 8)
+%_python_callback_tramp_void(NAME, PARMS, BUILDARGS, 9)
+%_python_callback_tramp_void(NAME, PARMS, BUILDARGS, 10)
+%_python_callback_tramp_void(NAME, PARMS, BUILDARGS, 11)
+%_python_callback_tramp_void(NAME, PARMS, BUILDARGS, 12)
+%_python_callback_tramp_void(NAME, PARMS, BUILDARGS, 13)
+%_python_callback_tramp_void(NAME, PARMS, BUILDARGS, 14)
+%_python_callback_tramp_void(NAME, PARMS, BUILDARGS, 15)
+
+%_python_callback_registry(NAME, void, PARMS)
+
+%enddef
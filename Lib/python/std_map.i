@@ -71,6 +71,42 @@
     {
       return new SwigPyMapValueIterator_T<OutIter>(current, begin, end, seq);
     }
+
+    /* Fill a map-like container straight from a dict: iterate with
+       PyDict_Next instead of materializing an items() sequence and
+       building a std::pair per entry, reserving capacity up front where
+       the container supports it.  Return convention as traits_asptr. */
+    template <class Map, class K, class T>
+    struct traits_asptr_stddict {
+      static int asptr(PyObject *obj, Map **val) {
+	PyObject *key = 0;
+	PyObject *value = 0;
+	Py_ssize_t pos = 0;
+	if (val) {
+	  Map *m = new Map();
+	  swig::traits_reserve<Map>::reserve(*m, (typename Map::size_type)PyDict_Size(obj));
+	  try {
+	    while (PyDict_Next(obj, &pos, &key, &value)) {
+	      m->insert(m->end(), typename Map::value_type(swig::as<K>(key), swig::as<T>(value)));
+	    }
+	  } catch (std::exception& e) {
+	    delete m;
+	    if (!PyErr_Occurred()) {
+	      PyErr_SetString(PyExc_TypeError, e.what());
+	    }
+	    return SWIG_ERROR;
+	  }
+	  *val = m;
+	  return SWIG_NEWOBJ;
+	} else {
+	  while (PyDict_Next(obj, &pos, &key, &value)) {
+	    if (!swig::check<K>(key) || !swig::check<T>(value))
+	      return SWIG_ERROR;
+	  }
+	  return SWIG_OK;
+	}
+      }
+    };
   }
 }
 
@@ -94,12 +130,7 @@
 	int res = SWIG_ERROR;
 	SWIG_PYTHON_THREAD_BEGIN_BLOCK;
 	if (PyDict_Check(obj)) {
-	  SwigVar_PyObject items = PyObject_CallMethod(obj,(char *)"items",NULL);
-%#if PY_VERSION_HEX >= 0x03000000
-          /* In Python 3.x the ".items()" method returns a dict_items object */
-          items = PySequence_Fast(items, ".items() didn't return a sequence!");
-%#endif
-	  res = traits_asptr_stdseq<map_type, std::pair<K, T> >::asptr(items, val);
+	  res = traits_asptr_stddict<map_type, K, T>::asptr(obj, val);
 	} else {
 	  map_type *p = 0;
 	  swig_type_info *descriptor = swig::type_info<map_type>();
@@ -177,8 +208,11 @@
 
 #else
   %extend {
+    PyObject *_swig_fast_key_iterator(PyObject **PYTHON_SELF) {
+      return swig::make_fast_iterator(swig::make_output_key_iterator(self->begin(), self->begin(), self->end(), *PYTHON_SELF));
+    }
     %pythoncode %{def __iter__(self):
-    return self.key_iterator()%}
+    return self._swig_fast_key_iterator()%}
     %pythoncode %{def iterkeys(self):
     return self.key_iterator()%}
     %pythoncode %{def itervalues(self):
@@ -22,12 +22,7 @@
       static int asptr(PyObject *obj, std::multimap<K,T> **val) {
 	int res = SWIG_ERROR;
 	if (PyDict_Check(obj)) {
-	  SwigVar_PyObject items = PyObject_CallMethod(obj,(char *)"items",NULL);
-%#if PY_VERSION_HEX >= 0x03000000
-          /* In Python 3.x the ".items()" method returns a dict_items object */
-          items = PySequence_Fast(items, ".items() didn't return a sequence!");
-%#endif
-	  res = traits_asptr_stdseq<std::multimap<K,T>, std::pair<K, T> >::asptr(items, val);
+	  res = traits_asptr_stddict<multimap_type, K, T>::asptr(obj, val);
 	} else {
 	  multimap_type *p = 0;
 	  swig_type_info *descriptor = swig::type_info<multimap_type>();
@@ -1 +1,35 @@
 %include <typemaps/std_string.swg>
+
+/* %std_string_borrow_input()
+ *
+ * Opt-in replacement for the const std::string & input typemap.  The
+ * default conversion goes through SWIG_AsCharPtrAndSize, which encodes
+ * the str to a temporary bytes object, duplicates the buffer, and then
+ * copies it again into a new heap std::string.  This variant builds the
+ * argument on the stack directly from the buffer owned by the Python
+ * object (the cached UTF-8 representation of a str) — one copy, no heap
+ * string.  A std::string itself must own its characters, so the one copy
+ * cannot be avoided; use std_string_view.i on C++17 targets for fully
+ * borrowed input.  Wrapped std::string pointers are still accepted.
+ * The by-value and non-const reference typemaps are unchanged.
+ */
+%define %std_string_borrow_input()
+%typemap(in, fragment="SWIG_AsCharViewAndSize") const std::string & (std::string temp) {
+  const char *buf = 0;
+  size_t size = 0;
+  if (SWIG_IsOK(SWIG_AsCharViewAndSize($input, &buf, &size))) {
+    temp.assign(buf, size);
+    $1 = &temp;
+  } else {
+    void *vptr = 0;
+    int res = SWIG_ConvertPtr($input, &vptr, $descriptor(std::string *), 0);
+    if (!SWIG_IsOK(res)) {
+      %argument_fail(res, "std::string const &", $symname, $argnum);
+    }
+    $1 = (std::string *)vptr;
+  }
+}
+/* the default freearg deletes the heap string the default in typemap made;
+   there is none here */
+%typemap(freearg) const std::string & "";
+%enddef
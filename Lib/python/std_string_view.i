@@ -0,0 +1,67 @@
+/* -----------------------------------------------------------------------------
+ * std_string_view.i
+ *
+ * Typemaps for std::string_view and const std::string_view&.  Requires a
+ * C++17 target.
+ *
+ * Input arguments borrow the buffer owned by the Python object (the cached
+ * UTF-8 representation of a str, or the payload of a bytes object under
+ * SWIG_PYTHON_STRICT_BYTE_CHAR), so no copy is made; the view is valid for
+ * the duration of the call.  Do not use these typemaps for functions that
+ * retain the view past the call.  A returned view is copied into a new
+ * Python string, since a view does not own its bytes.
+ * ----------------------------------------------------------------------------- */
+
+%{
+#include <string_view>
+%}
+
+namespace std {
+
+%naturalvar string_view;
+
+class string_view;
+
+%typemap(typecheck, precedence=SWIG_TYPECHECK_STRING, fragment="SWIG_AsCharViewAndSize") string_view, const string_view & {
+  int res = SWIG_AsCharViewAndSize($input, 0, 0);
+  $1 = SWIG_IsOK(res) ? 1 : 0;
+}
+
+%typemap(in, fragment="SWIG_AsCharViewAndSize") string_view {
+  const char *buf = 0;
+  size_t size = 0;
+  int res = SWIG_AsCharViewAndSize($input, &buf, &size);
+  if (!SWIG_IsOK(res)) {
+    %argument_fail(res, "std::string_view", $symname, $argnum);
+  }
+  $1 = std::string_view(buf, size);
+}
+
+%typemap(in, fragment="SWIG_AsCharViewAndSize") const string_view & (std::string_view temp) {
+  const char *buf = 0;
+  size_t size = 0;
+  int res = SWIG_AsCharViewAndSize($input, &buf, &size);
+  if (!SWIG_IsOK(res)) {
+    %argument_fail(res, "std::string_view const &", $symname, $argnum);
+  }
+  temp = std::string_view(buf, size);
+  $1 = &temp;
+}
+
+%typemap(out, fragment="SWIG_FromCharPtrAndSize") string_view %{
+  $result = SWIG_FromCharPtrAndSize($1.data(), $1.size());
+%}
+
+%typemap(out, fragment="SWIG_FromCharPtrAndSize") const string_view & %{
+  $result = SWIG_FromCharPtrAndSize($1->data(), $1->size());
+%}
+
+%typemap(varout, fragment="SWIG_FromCharPtrAndSize") string_view %{
+  $result = SWIG_FromCharPtrAndSize($1.data(), $1.size());
+%}
+
+%typemap(throws) string_view, const string_view & %{
+  SWIG_exception_fail(SWIG_RuntimeError, std::string($1).c_str());
+%}
+
+}
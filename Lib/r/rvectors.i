@@ -0,0 +1,58 @@
+/* -----------------------------------------------------------------------------
+ * rvectors.i
+ *
+ * Vectorized accessors for C arrays wrapped as pointers.  The element-wise
+ * accessors from carrays.i cost one .Call boundary crossing per element,
+ * which makes looping over large wrapped buffers from R prohibitively slow.
+ * The macros here generate companions that move a whole slice per call.
+ * ----------------------------------------------------------------------------- */
+
+/* -----------------------------------------------------------------------------
+ * %array_vector_functions(TYPE,NAME)
+ *
+ * Generates whole-slice accessors for a C array of a numeric type.  Creates
+ * the following functions:
+ *
+ *        NAME_getvector(ary, offset, len)    -> R numeric vector of len
+ *                                               elements starting at offset
+ *        NAME_setvector(ary, offset, values) -> copies the R vector values
+ *                                               into the array at offset
+ *
+ * Elements pass through double on the way in and out, matching R's own
+ * numeric representation.  Indexing is zero-based like NAME_getitem.  No
+ * bounds checking is performed on the array, as with the element-wise
+ * accessors.
+ * ----------------------------------------------------------------------------- */
+
+%define %array_vector_functions(TYPE,NAME)
+%{
+static SEXP NAME##_getvector(TYPE *ary, int offset, int len) {
+  SEXP result;
+  double *rp;
+  int i;
+  if (len < 0) len = 0;
+  result = Rf_protect(Rf_allocVector(REALSXP, len));
+  rp = REAL(result);
+  for (i = 0; i < len; i++)
+    rp[i] = (double) ary[offset + i];
+  Rf_unprotect(1);
+  return result;
+}
+
+static void NAME##_setvector(TYPE *ary, int offset, SEXP values) {
+  SEXP real;
+  double *rp;
+  int i, len;
+  real = Rf_protect(Rf_coerceVector(values, REALSXP));
+  len = (int) Rf_length(real);
+  rp = REAL(real);
+  for (i = 0; i < len; i++)
+    ary[offset + i] = (TYPE) rp[i];
+  Rf_unprotect(1);
+}
+%}
+
+SEXP NAME##_getvector(TYPE *ary, int offset, int len);
+void NAME##_setvector(TYPE *ary, int offset, SEXP values);
+
+%enddef
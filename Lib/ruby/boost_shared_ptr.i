@@ -85,7 +85,7 @@
     %argument_fail(res, "$type", $symname, $argnum);
   }
   if (newmem.own & SWIG_CAST_NEW_MEMORY) {
-    tempshared = *%reinterpret_cast(argp, SWIG_SHARED_PTR_QNAMESPACE::shared_ptr< CONST TYPE > *);
+    tempshared = SWIG_STD_MOVE((*%reinterpret_cast(argp, SWIG_SHARED_PTR_QNAMESPACE::shared_ptr< CONST TYPE > *)));
     delete %reinterpret_cast(argp, SWIG_SHARED_PTR_QNAMESPACE::shared_ptr< CONST TYPE > *);
     $1 = %const_cast(tempshared.get(), $1_ltype);
   } else {
@@ -109,7 +109,7 @@
   SWIG_SHARED_PTR_QNAMESPACE::shared_ptr< CONST TYPE > tempshared;
   SWIG_SHARED_PTR_QNAMESPACE::shared_ptr< CONST TYPE > *smartarg = 0;
   if (newmem.own & SWIG_CAST_NEW_MEMORY) {
-    tempshared = *%reinterpret_cast(argp, SWIG_SHARED_PTR_QNAMESPACE::shared_ptr< CONST TYPE > *);
+    tempshared = SWIG_STD_MOVE((*%reinterpret_cast(argp, SWIG_SHARED_PTR_QNAMESPACE::shared_ptr< CONST TYPE > *)));
     delete %reinterpret_cast(argp, SWIG_SHARED_PTR_QNAMESPACE::shared_ptr< CONST TYPE > *);
     $1 = %const_cast(tempshared.get(), $1_ltype);
   } else {
@@ -139,7 +139,7 @@
   }
   if (!argp) { %argument_nullref("$type", $symname, $argnum); }
   if (newmem.own & SWIG_CAST_NEW_MEMORY) {
-    tempshared = *%reinterpret_cast(argp, SWIG_SHARED_PTR_QNAMESPACE::shared_ptr< CONST TYPE > *);
+    tempshared = SWIG_STD_MOVE((*%reinterpret_cast(argp, SWIG_SHARED_PTR_QNAMESPACE::shared_ptr< CONST TYPE > *)));
     delete %reinterpret_cast(argp, SWIG_SHARED_PTR_QNAMESPACE::shared_ptr< CONST TYPE > *);
     $1 = %const_cast(tempshared.get(), $1_ltype);
   } else {
@@ -163,7 +163,7 @@
     %variable_nullref("$type", "$name");
   }
   if (newmem.own & SWIG_CAST_NEW_MEMORY) {
-    tempshared = *%reinterpret_cast(argp, SWIG_SHARED_PTR_QNAMESPACE::shared_ptr< CONST TYPE > *);
+    tempshared = SWIG_STD_MOVE((*%reinterpret_cast(argp, SWIG_SHARED_PTR_QNAMESPACE::shared_ptr< CONST TYPE > *)));
     delete %reinterpret_cast(argp, SWIG_SHARED_PTR_QNAMESPACE::shared_ptr< CONST TYPE > *);
     $1 = *%const_cast(tempshared.get(), $1_ltype);
   } else {
@@ -192,7 +192,7 @@
     %argument_fail(res, "$type", $symname, $argnum);
   }
   if (newmem.own & SWIG_CAST_NEW_MEMORY) {
-    tempshared = *%reinterpret_cast(argp, SWIG_SHARED_PTR_QNAMESPACE::shared_ptr< CONST TYPE > *);
+    tempshared = SWIG_STD_MOVE((*%reinterpret_cast(argp, SWIG_SHARED_PTR_QNAMESPACE::shared_ptr< CONST TYPE > *)));
     delete %reinterpret_cast(argp, SWIG_SHARED_PTR_QNAMESPACE::shared_ptr< CONST TYPE > *);
     temp = %const_cast(tempshared.get(), $*1_ltype);
   } else {
@@ -227,8 +227,12 @@
   if (!SWIG_IsOK(res)) {
     %argument_fail(res, "$type", $symname, $argnum);
   }
-  if (argp) $1 = *(%reinterpret_cast(argp, $&ltype));
-  if (newmem.own & SWIG_CAST_NEW_MEMORY) delete %reinterpret_cast(argp, $&ltype);
+  if (newmem.own & SWIG_CAST_NEW_MEMORY) {
+    if (argp) $1 = SWIG_STD_MOVE((*%reinterpret_cast(argp, $&ltype)));
+    delete %reinterpret_cast(argp, $&ltype);
+  } else {
+    if (argp) $1 = *(%reinterpret_cast(argp, $&ltype));
+  }
 }
 %typemap(out) SWIG_SHARED_PTR_QNAMESPACE::shared_ptr< CONST TYPE > {
   SWIG_SHARED_PTR_QNAMESPACE::shared_ptr< CONST TYPE > *smartresult = $1 ? new SWIG_SHARED_PTR_QNAMESPACE::shared_ptr< CONST TYPE >($1) : 0;
@@ -242,8 +246,12 @@
   if (!SWIG_IsOK(res)) {
     %variable_fail(res, "$type", "$name");
   }
-  $1 = argp ? *(%reinterpret_cast(argp, $&ltype)) : SWIG_SHARED_PTR_QNAMESPACE::shared_ptr< TYPE >();
-  if (newmem.own & SWIG_CAST_NEW_MEMORY) delete %reinterpret_cast(argp, $&ltype);
+  if (newmem.own & SWIG_CAST_NEW_MEMORY) {
+    $1 = argp ? SWIG_STD_MOVE((*%reinterpret_cast(argp, $&ltype))) : SWIG_SHARED_PTR_QNAMESPACE::shared_ptr< TYPE >();
+    delete %reinterpret_cast(argp, $&ltype);
+  } else {
+    $1 = argp ? *(%reinterpret_cast(argp, $&ltype)) : SWIG_SHARED_PTR_QNAMESPACE::shared_ptr< TYPE >();
+  }
 }
 %typemap(varout) SWIG_SHARED_PTR_QNAMESPACE::shared_ptr< CONST TYPE > {
   SWIG_SHARED_PTR_QNAMESPACE::shared_ptr< CONST TYPE > *smartresult = $1 ? new SWIG_SHARED_PTR_QNAMESPACE::shared_ptr< CONST TYPE >($1) : 0;
@@ -261,8 +269,12 @@
     %dirout_fail(swig_res, "$type");
   }
   if (swig_argp) {
-    $result = *(%reinterpret_cast(swig_argp, $&ltype));
-    if (newmem.own & SWIG_CAST_NEW_MEMORY) delete %reinterpret_cast(swig_argp, $&ltype);
+    if (newmem.own & SWIG_CAST_NEW_MEMORY) {
+      $result = SWIG_STD_MOVE((*%reinterpret_cast(swig_argp, $&ltype)));
+      delete %reinterpret_cast(swig_argp, $&ltype);
+    } else {
+      $result = *(%reinterpret_cast(swig_argp, $&ltype));
+    }
   }
 }
 
@@ -274,7 +286,7 @@
     %argument_fail(res, "$type", $symname, $argnum);
   }
   if (newmem.own & SWIG_CAST_NEW_MEMORY) {
-    if (argp) tempshared = *%reinterpret_cast(argp, $ltype);
+    if (argp) tempshared = SWIG_STD_MOVE((*%reinterpret_cast(argp, $ltype)));
     delete %reinterpret_cast(argp, $ltype);
     $1 = &tempshared;
   } else {
@@ -309,7 +321,7 @@
     %argument_fail(res, "$type", $symname, $argnum);
   }
   if (newmem.own & SWIG_CAST_NEW_MEMORY) {
-    if (argp) tempshared = *%reinterpret_cast(argp, $ltype);
+    if (argp) tempshared = SWIG_STD_MOVE((*%reinterpret_cast(argp, $ltype)));
     delete %reinterpret_cast(argp, $ltype);
     $1 = &tempshared;
   } else {
@@ -344,8 +356,12 @@
   if (!SWIG_IsOK(res)) {
     %argument_fail(res, "$type", $symname, $argnum);
   }
-  if (argp) tempshared = *%reinterpret_cast(argp, $*ltype);
-  if (newmem.own & SWIG_CAST_NEW_MEMORY) delete %reinterpret_cast(argp, $*ltype);
+  if (newmem.own & SWIG_CAST_NEW_MEMORY) {
+    if (argp) tempshared = SWIG_STD_MOVE((*%reinterpret_cast(argp, $*ltype)));
+    delete %reinterpret_cast(argp, $*ltype);
+  } else {
+    if (argp) tempshared = *%reinterpret_cast(argp, $*ltype);
+  }
   temp = &tempshared;
   $1 = &temp;
 }
@@ -48,6 +48,8 @@ extern "C" {
   extern void start_inline(char *, int);
   extern String *scanner_ccode;
   extern int yylex(void);
+  extern void *Swig_cparse_state_save(void);
+  extern void Swig_cparse_state_restore(void *state);
 
 /* parser.y */
   extern SwigType *Swig_cparse_type(String *);
@@ -141,6 +141,55 @@ void scanner_file(DOHFile * f) {
   Scanner_push(scan,f);
 }
 
+/* ----------------------------------------------------------------------------
+ * Swig_cparse_state_save()
+ * Swig_cparse_state_restore()
+ *
+ * Snapshot and restore the scanner-side parser state.  The secondary parse
+ * entry points (Swig_cparse_type, Swig_cparse_parm, Swig_cparse_parms) feed
+ * a small synthetic string through the one global scanner, which clobbers
+ * the location and brace-tracking state left behind by the main parse.
+ * Bracketing those parses with save/restore keeps the state of the caller
+ * intact and is the first step towards a fully reentrant parse context.
+ * ------------------------------------------------------------------------- */
+
+typedef struct {
+  String *file;
+  int line;
+  int start_line;
+  String *unknown_directive;
+  int num_brace;
+  int last_brace;
+  int last_id;
+  int rename_active;
+} CParseState;
+
+void *Swig_cparse_state_save(void) {
+  CParseState *s = (CParseState *) DohMalloc(sizeof(CParseState));
+  s->file = cparse_file;
+  s->line = cparse_line;
+  s->start_line = cparse_start_line;
+  s->unknown_directive = cparse_unknown_directive;
+  s->num_brace = num_brace;
+  s->last_brace = last_brace;
+  s->last_id = last_id;
+  s->rename_active = rename_active;
+  return s;
+}
+
+void Swig_cparse_state_restore(void *state) {
+  CParseState *s = (CParseState *) state;
+  cparse_file = s->file;
+  cparse_line = s->line;
+  cparse_start_line = s->start_line;
+  cparse_unknown_directive = s->unknown_directive;
+  num_brace = s->num_brace;
+  last_brace = s->last_brace;
+  last_id = s->last_id;
+  rename_active = s->rename_active;
+  DohFree(s);
+}
+
 /* ----------------------------------------------------------------------------
  * start_inline(char *text, int line)
  *
@@ -555,6 +604,91 @@ String *scanner_get_main_input_file() {
   return main_input_file;
 }
 
+/* ----------------------------------------------------------------------------
+ * intern_id()
+ *
+ * Return a process-lifetime copy of an identifier, sharing storage between
+ * repeated occurrences.  Identifier tokens dominate large inputs and the
+ * parser neither frees nor modifies the text it is handed, so handing out
+ * the same copy avoids a malloc per occurrence.
+ * ------------------------------------------------------------------------- */
+
+static Hash *id_intern = 0;
+
+static char *intern_id(const char *text) {
+  String *val;
+  if (!id_intern)
+    id_intern = NewHash();
+  val = Getattr(id_intern, text);
+  if (!val) {
+    String *nval = NewString(text);
+    Setattr(id_intern, text, nval);
+    Delete(nval);
+    val = Getattr(id_intern, text);
+  }
+  return Char(val);
+}
+
+/* ----------------------------------------------------------------------------
+ * is_keyword()
+ *
+ * Membership probe for the C/C++ keywords recognized by the cascaded
+ * comparisons in yylex() below.  Keywords are bucketed by length so an
+ * ordinary identifier - the overwhelming majority of tokens - is rejected
+ * after a single length dispatch and at most a handful of first-character
+ * tests, instead of running the whole comparison chain.  The buckets must
+ * list every identifier yylex() compares against, for either language mode.
+ * ------------------------------------------------------------------------- */
+
+static int is_keyword(const char *id) {
+  static const char *const kw2[] = { "or", 0 };
+  static const char *const kw3[] = { "and", "int", "not", "try", 0 };
+  static const char *const kw4[] = { "auto", "bool", "char", "enum", "long", "void", 0 };
+  static const char *const kw5[] = { "catch", "class", "const", "final", "float", "short", "throw", "union", "using", 0 };
+  static const char *const kw6[] = { "__int8", "delete", "double", "export", "extern", "friend", "inline", "public", "signed", "sizeof", "static", "struct", 0 };
+  static const char *const kw7[] = { "__int16", "__int32", "__int64", "default", "mutable", "private", "typedef", "virtual", "wchar_t", 0 };
+  static const char *const kw8[] = { "_Complex", "decltype", "explicit", "noexcept", "operator", "override", "register", "restrict", "template", "typename", "unsigned", "volatile", 0 };
+  static const char *const kw9[] = { "constexpr", "namespace", "protected", 0 };
+  const char *const *k;
+  switch (strlen(id)) {
+  case 2:
+    k = kw2;
+    break;
+  case 3:
+    k = kw3;
+    break;
+  case 4:
+    k = kw4;
+    break;
+  case 5:
+    k = kw5;
+    break;
+  case 6:
+    k = kw6;
+    break;
+  case 7:
+    k = kw7;
+    break;
+  case 8:
+    k = kw8;
+    break;
+  case 9:
+    k = kw9;
+    break;
+  case 12:
+    return strcmp(id, "thread_local") == 0;
+  case 13:
+    return strcmp(id, "static_assert") == 0;
+  default:
+    return 0;
+  }
+  for (; *k; k++) {
+    if ((*k)[0] == id[0] && strcmp(*k, id) == 0)
+      return 1;
+  }
+  return 0;
+}
+
 /* ----------------------------------------------------------------------------
  * int yylex()
  *
@@ -629,7 +763,11 @@ int yylex(void) {
   case ID:
     yytext = Char(Scanner_text(scan));
     if (yytext[0] != '%') {
-      /* Look for keywords now */
+      /* Look for keywords now.  One probe of the length-bucketed keyword
+         table decides whether any of the comparisons below can match. */
+
+      if (!is_keyword(yytext))
+	goto not_keyword;
 
       if (strcmp(yytext, "int") == 0) {
 	yylval.type = NewSwigType(T_INT);
@@ -1031,6 +1169,7 @@ int yylex(void) {
       /* Note down the apparently unknown directive for error reporting. */
       cparse_unknown_directive = NewString(yytext);
     }
+  not_keyword:
     /* Have an unknown identifier, as a last step, we'll do a typedef lookup on it. */
 
     /* Need to fix this */
@@ -1040,7 +1179,7 @@ int yylex(void) {
 	return (TYPE_TYPEDEF);
       }
     }
-    yylval.id = Swig_copy_string(yytext);
+    yylval.id = intern_id(yytext);
     last_id = 1;
     return (ID);
   case POUND:
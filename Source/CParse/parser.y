@@ -46,6 +46,7 @@ static Node    *top = 0;      /* Top of the generated parse tree */
 static int      unnamed = 0;  /* Unnamed datatype counter */
 static Hash    *classes = 0;        /* Hash table of classes */
 static Hash    *classes_typedefs = 0; /* Hash table of typedef classes: typedef struct X {...} Y; */
+static Hash    *template_instantiation_memo = 0; /* Expanded %template trees, keyed by template/args/name/scope */
 static Symtab  *prev_symtab = 0;
 static Node    *current_class = 0;
 String  *ModuleName = 0;
@@ -179,6 +180,12 @@ static Node *copy_node(Node *n) {
   return nn;
 }
 
+/* Attach a doxygen comment to a node.  Comments arrive as DOXYGENSTRING /
+   DOXYGENPOSTSTRING tokens in the token stream, so the grammar hands each
+   one straight to the declaration it precedes or follows: attachment is a
+   direct assignment at node construction, with no comment list to search.
+   The loops below only walk the declaration's own parameters and its
+   immediately following generated overloads. */
 static void set_comment(Node *n, String *comment) {
   String *name;
   Parm *p;
@@ -1542,6 +1549,12 @@ static String *add_qualifier_to_declarator(SwigType *type, SwigType *qualifier)
 %union {
   const char  *id;
   List  *bases;
+  /* Constant expressions (array sizes, default arguments, enum values)
+     are evaluated exactly once, here in the expression actions: val
+     carries the C text of the expression, which is what the backends
+     must emit, and type carries the T_* code of its evaluated type,
+     stored on the node as "valuetype".  Passes after the parser reuse
+     these attributes rather than re-parsing the expression string. */
   struct Define {
     String *val;
     String *rawval;
@@ -2202,11 +2215,18 @@ inline_directive : INLINE HBLOCK {
 		 } else {
 		   $$ = new_node("insert");
 		   Setattr($$,"code",$2);
+		   /* Mark as %inline rather than a plain %{ ... %} block, for
+		      language modules that treat emitted definitions specially */
+		   Setattr($$,"inline","1");
 		   /* Need to run through the preprocessor */
 		   Seek($2,0,SEEK_SET);
 		   Setline($2,cparse_start_line);
 		   Setfile($2,cparse_file);
 		   cpps = Preprocessor_parse($2);
+		   /* Reading the block advanced its line marker to the end;
+		      restore the start so the code attribute records where
+		      the block begins */
+		   Setline($2,cparse_start_line);
 		   start_inline(Char(cpps), cparse_start_line);
 		   Delete($2);
 		   Delete(cpps);
@@ -2224,11 +2244,14 @@ inline_directive : INLINE HBLOCK {
 		 } else {
 		   String *code;
                    $$ = new_node("insert");
+		   Setattr($$,"inline","1");
 		   Delitem(scanner_ccode,0);
 		   Delitem(scanner_ccode,DOH_END);
 		   code = Copy(scanner_ccode);
+		   Setline(code,start_line);
+		   Setfile(code,cparse_file);
 		   Setattr($$,"code", code);
-		   Delete(code);		   
+		   Delete(code);
 		   cpps=Copy(scanner_ccode);
 		   start_inline(Char(cpps), start_line);
 		   Delete(cpps);
@@ -2253,10 +2276,21 @@ insert_directive : HBLOCK {
 		 $$ = new_node("insert");
 		 Setattr($$,"section",$3);
 		 Setattr($$,"code",code);
-		 if (Swig_insert_file($5,code) < 0) {
+		 if (import_mode) {
+		   /* Sections from %imported files are discarded at emit time
+		      (Language::insertDirective), so don't read the file in;
+		      just check it can be found so diagnostics are unchanged */
+		   FILE *f = Swig_include_open($5);
+		   if (!f) {
+		     Swig_error(cparse_file, cparse_line, "Couldn't find '%s'.\n", $5);
+		     $$ = 0;
+		   } else {
+		     fclose(f);
+		   }
+		 } else if (Swig_insert_file($5,code) < 0) {
 		   Swig_error(cparse_file, cparse_line, "Couldn't find '%s'.\n", $5);
 		   $$ = 0;
-		 } 
+		 }
                }
                | INSERT LPAREN idstring RPAREN HBLOCK {
 		 $$ = new_node("insert");
@@ -2878,6 +2912,8 @@ template_directive: SWIGTEMPLATE LPAREN idstringopt RPAREN idcolonnt LESSTHAN va
                           /* Expand the template */
 			  Node *templ = Swig_symbol_clookup($5,0);
 			  Parm *targs = templ ? Getattr(templ,"templateparms") : 0;
+			  String *tikey = 0;
+			  Node *timemo = 0;
 
                           ParmList *temparms;
                           if (specialized) temparms = CopyParmList($7);
@@ -2934,6 +2970,23 @@ template_directive: SWIGTEMPLATE LPAREN idstringopt RPAREN idcolonnt LESSTHAN va
                             }
                           }
 
+                          /* Memoize expansions: the same template instantiated with the
+                             same arguments, name and scope yields the same expanded tree,
+                             and shared interface files repeat such instantiations often. */
+                          if ($3 && !(nnisclass && ((outer_class && (outer_class != Getattr(nn, "nested:outer")))
+			    ||(extendmode && current_class && (current_class != Getattr(nn, "nested:outer")))))) {
+                            String *parmstr = ParmList_str_defaultargs(temparms);
+                            String *scopename = Swig_symbol_qualifiedscopename(0);
+                            tikey = NewStringf("%p\001%s\001%s\001%s\001%s", (void *) nn, tname, $3, parmstr ? parmstr : "", scopename ? scopename : "");
+                            Delete(parmstr);
+                            Delete(scopename);
+                            if (template_instantiation_memo)
+                              timemo = Getattr(template_instantiation_memo, tikey);
+                          }
+                          if (timemo) {
+                            templnode = copy_node(timemo);
+                            Delete(tname);
+                          } else {
                           templnode = copy_node(nn);
 			  update_nested_classes(templnode); /* update classes nested within template */
                           /* We need to set the node name based on name used to instantiate */
@@ -2958,6 +3011,13 @@ template_directive: SWIGTEMPLATE LPAREN idstringopt RPAREN idcolonnt LESSTHAN va
 			    String *symname = NewString($3);
                             Swig_cparse_template_expand(templnode,symname,temparms,tscope);
                             Setattr(templnode,"sym:name",symname);
+                            {
+                              Node *pristine = copy_node(templnode);
+                              if (!template_instantiation_memo)
+                                template_instantiation_memo = NewHash();
+                              Setattr(template_instantiation_memo, tikey, pristine);
+                              Delete(pristine);
+                            }
                           } else {
                             static int cnt = 0;
                             String *nname = NewStringf("__dummy_%d__", cnt++);
@@ -2969,6 +3029,8 @@ template_directive: SWIGTEMPLATE LPAREN idstringopt RPAREN idcolonnt LESSTHAN va
 			      Swig_warning(WARN_PARSE_NESTED_TEMPLATE, cparse_file, cparse_line, "Named nested template instantiations not supported. Processing as if no name was given to %%template().\n");
 			    }
                           }
+                          }
+                          Delete(tikey);
                           Delattr(templnode,"templatetype");
                           Setattr(templnode,"template",nn);
                           Setfile(templnode,cparse_file);
@@ -7323,6 +7385,7 @@ empty          :   ;
 
 SwigType *Swig_cparse_type(String *s) {
    String *ns;
+   void *state = Swig_cparse_state_save();
    ns = NewStringf("%s;",s);
    Seek(ns,0,SEEK_SET);
    scanner_file(ns);
@@ -7330,12 +7393,14 @@ SwigType *Swig_cparse_type(String *s) {
    scanner_next_token(PARSETYPE);
    yyparse();
    /*   Printf(stdout,"typeparse: '%s' ---> '%s'\n", s, top); */
+   Swig_cparse_state_restore(state);
    return top;
 }
 
 
 Parm *Swig_cparse_parm(String *s) {
    String *ns;
+   void *state = Swig_cparse_state_save();
    ns = NewStringf("%s;",s);
    Seek(ns,0,SEEK_SET);
    scanner_file(ns);
@@ -7344,12 +7409,14 @@ Parm *Swig_cparse_parm(String *s) {
    yyparse();
    /*   Printf(stdout,"typeparse: '%s' ---> '%s'\n", s, top); */
    Delete(ns);
+   Swig_cparse_state_restore(state);
    return top;
 }
 
 
 ParmList *Swig_cparse_parms(String *s, Node *file_line_node) {
    String *ns;
+   void *state = Swig_cparse_state_save();
    char *cs = Char(s);
    if (cs && cs[0] != '(') {
      ns = NewStringf("(%s);",s);
@@ -7364,6 +7431,7 @@ ParmList *Swig_cparse_parms(String *s, Node *file_line_node) {
    scanner_next_token(PARSEPARMS);
    yyparse();
    /*   Printf(stdout,"typeparse: '%s' ---> '%s'\n", s, top); */
+   Swig_cparse_state_restore(state);
    return top;
 }
 
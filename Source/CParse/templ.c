@@ -54,6 +54,15 @@ void Swig_cparse_debug_templates(int x) {
  * Expands a template node into a specialized version.  This is done by
  * patching typenames and other aspects of the node according to a list of
  * template parameters
+ *
+ * The expansion is collect-then-patch: this single walk over the
+ * instantiation's copy of the template tree gathers the attribute strings
+ * that can contain parameter holes (patchlist/typelist/cpatchlist), and the
+ * caller then substitutes each parameter into those strings only - nothing
+ * else in the tree is scanned per parameter.  The hole locations cannot be
+ * recorded once per template and reused, because every instantiation works
+ * on a fresh copy whose strings are new objects; the collection walk is the
+ * per-copy price, and it is no more than the node copy itself already paid.
  * ----------------------------------------------------------------------------- */
 
 static void cparse_template_expand(Node *templnode, Node *n, String *tname, String *rname, String *templateargs, List *patchlist, List *typelist, List *cpatchlist) {
@@ -454,21 +463,32 @@ typedef enum { ExactNoMatch = -2, PartiallySpecializedNoMatch = -1, PartiallySpe
  *   (higher is better) only set if return is set to PartiallySpecializedMatch or ExactMatch.
  * ----------------------------------------------------------------------------- */
 
-static EMatch does_parm_match(SwigType *type, SwigType *partial_parm_type, const char *partial_parm_type_base, Symtab *tscope, int *specialization_priority) {
+static EMatch does_parm_match(SwigType *ty, String *base, Parm *partial_parm, const char *partial_parm_type_base, int *specialization_priority) {
   static const int EXACT_MATCH_PRIORITY = 99999; /* a number bigger than the length of any conceivable type */
-  int matches;
-  int substitutions;
   EMatch match;
-  SwigType *ty = Swig_symbol_typedef_reduce(type, tscope);
-  String *base = SwigType_base(ty);
-  SwigType *t = Copy(partial_parm_type);
-  substitutions = Replaceid(t, partial_parm_type_base, base); /* eg: Replaceid("p.$1", "$1", "int") returns t="p.int" */
-  matches = Equal(ty, t);
+  SwigType *partial_parm_type = Getattr(partial_parm, "type");
+  String *kind = Getattr(partial_parm, "partialmatchkind");
   *specialization_priority = -1;
-  if (substitutions == 1) {
-    /* we have a non-explicit specialized parameter (in partial_parm_type) because a substitution for $1, $2... etc has taken place */
-    SwigType *tt = Copy(partial_parm_type);
-    int len;
+  if (!kind) {
+    /* First use of this partially specialized parameter: classify it and
+       cache the pattern skeleton.  The classification only depends on how
+       often the $1, $2... placeholder occurs in the parameter, so it is
+       the same for every subsequent instantiation. */
+    SwigType *skel = Copy(partial_parm_type);
+    int substitutions = Replaceid(skel, partial_parm_type_base, ""); /* remove the $1, $2 etc, eg skel="p.$1" => "p." */
+    if (substitutions == 1) {
+      Setattr(partial_parm, "partialmatchkind", "pattern");
+      Setattr(partial_parm, "partialskel", skel);
+    } else if (substitutions == 0) {
+      Setattr(partial_parm, "partialmatchkind", "exact");
+    } else {
+      Setattr(partial_parm, "partialmatchkind", "multi");
+    }
+    kind = Getattr(partial_parm, "partialmatchkind");
+    Delete(skel);
+  }
+  if (Equal(kind, "pattern")) {
+    /* we have a non-explicit specialized parameter (in partial_parm_type) because a substitution for $1, $2... etc can take place */
     /*
        check for match to partial specialization type, for example, all of the following could match the type in the %template:
        template <typename T> struct XX {};
@@ -477,28 +497,36 @@ static EMatch does_parm_match(SwigType *type, SwigType *partial_parm_type, const
        template <typename T> struct XX<T *const&> {};   // r.q(const).p.$1
        %template(XXX) XX<int *const&>;                  // r.q(const).p.int
 
-       where type="r.q(const).p.int" will match either of tt="r.", tt="r.q(const)" tt="r.q(const).p"
+       where type="r.q(const).p.int" will match either of skel="r.", skel="r.q(const)" skel="r.q(const).p"
     */
-    Replaceid(tt, partial_parm_type_base, ""); /* remove the $1, $2 etc, eg tt="p.$1" => "p." */
-    len = Len(tt);
-    if (Strncmp(tt, ty, len) == 0) {
+    String *skel = Getattr(partial_parm, "partialskel");
+    int len = Len(skel);
+    if (Strncmp(skel, ty, len) == 0) {
       match = PartiallySpecializedMatch;
       *specialization_priority = len;
     } else {
       match = PartiallySpecializedNoMatch;
     }
-    Delete(tt);
-  } else {
+  } else if (Equal(kind, "exact")) {
+    /* no placeholder at all: the partially specialized parameter is an explicit type */
+    int matches = Equal(ty, partial_parm_type);
     match = matches ? ExactMatch : ExactNoMatch;
     if (matches)
       *specialization_priority = EXACT_MATCH_PRIORITY; /* exact matches always take precedence */
+  } else {
+    /* the placeholder occurs more than once, eg a function type - substitute and compare */
+    int matches;
+    SwigType *t = Copy(partial_parm_type);
+    Replaceid(t, partial_parm_type_base, base); /* eg: Replaceid("p.$1", "$1", "int") returns t="p.int" */
+    matches = Equal(ty, t);
+    match = matches ? ExactMatch : ExactNoMatch;
+    if (matches)
+      *specialization_priority = EXACT_MATCH_PRIORITY;
+    Delete(t);
   }
   /*
-  Printf(stdout, "      does_parm_match %2d %5d [%s] [%s]\n", match, *specialization_priority, type, partial_parm_type);
+  Printf(stdout, "      does_parm_match %2d %5d [%s] [%s]\n", match, *specialization_priority, ty, partial_parm_type);
   */
-  Delete(t);
-  Delete(base);
-  Delete(ty);
   return match;
 }
 
@@ -619,35 +647,56 @@ static Node *template_locate(String *name, Parm *tparms, Symtab *tscope) {
 	Iterator pi;
 	int parms_len = ParmList_len(parms);
 	int *priorities_row;
+	SwigType **reduced_types;
+	String **reduced_bases;
+	int i;
+	Parm *p = parms;
 	max_possible_partials = Len(partials);
 	priorities_matrix = (int *)malloc(sizeof(int) * max_possible_partials * parms_len); /* slightly wasteful allocation for max possible matches */
 	priorities_row = priorities_matrix;
+
+	/* The typedef reduction of the instantiation arguments is the same
+	   for every candidate specialization, so hoist it out of the
+	   candidate loop - deduction per candidate is then a cached
+	   skeleton comparison. */
+	reduced_types = (SwigType **)malloc(sizeof(SwigType *) * parms_len);
+	reduced_bases = (String **)malloc(sizeof(String *) * parms_len);
+	for (i = 0; i < parms_len; i++) {
+	  SwigType *t = Getattr(p, "type");
+	  if (!t)
+	    t = Getattr(p, "value");
+	  if (t) {
+	    reduced_types[i] = Swig_symbol_typedef_reduce(t, tscope);
+	    reduced_bases[i] = SwigType_base(reduced_types[i]);
+	  } else {
+	    reduced_types[i] = 0;
+	    reduced_bases[i] = 0;
+	  }
+	  p = nextSibling(p);
+	}
+
 	for (pi = First(partials); pi.item; pi = Next(pi)) {
-	  Parm *p = parms;
 	  int all_parameters_match = 1;
-	  int i = 1;
 	  Parm *partialparms = Getattr(pi.item, "partialparms");
 	  Parm *pp = partialparms;
 	  String *templcsymname = Getattr(pi.item, "templcsymname");
 	  if (template_debug) {
 	    Printf(stdout, "    checking match: '%s' (partial specialization)\n", templcsymname);
 	  }
-	  if (ParmList_len(partialparms) == parms_len) {
-	    while (p && pp) {
-	      SwigType *t;
+	  if (!Getattr(pi.item, "partialparmslen"))
+	    SetInt(pi.item, "partialparmslen", ParmList_len(partialparms));
+	  if (GetInt(pi.item, "partialparmslen") == parms_len) {
+	    i = 1;
+	    while (i <= parms_len && pp) {
 	      sprintf(tmp, "$%d", i);
-	      t = Getattr(p, "type");
-	      if (!t)
-		t = Getattr(p, "value");
-	      if (t) {
-		EMatch match = does_parm_match(t, Getattr(pp, "type"), tmp, tscope, priorities_row + i - 1);
+	      if (reduced_types[i - 1]) {
+		EMatch match = does_parm_match(reduced_types[i - 1], reduced_bases[i - 1], pp, tmp, priorities_row + i - 1);
 		if (match < (int)PartiallySpecializedMatch) {
 		  all_parameters_match = 0;
 		  break;
 		}
 	      }
 	      i++;
-	      p = nextSibling(p);
 	      pp = nextSibling(pp);
 	    }
 	    if (all_parameters_match) {
@@ -656,6 +705,13 @@ static Node *template_locate(String *name, Parm *tparms, Symtab *tscope) {
 	    }
 	  }
 	}
+
+	for (i = 0; i < parms_len; i++) {
+	  Delete(reduced_types[i]);
+	  Delete(reduced_bases[i]);
+	}
+	free(reduced_types);
+	free(reduced_bases);
       }
     }
 
@@ -118,7 +118,9 @@ void cparse_normalize_void(Node *n) {
  * ----------------------------------------------------------------------------- */
 
 Node *Swig_cparse_new_node(const_String_or_char_ptr tag) {
-  Node *n = NewHash();
+  /* Parser nodes typically collect a dozen or so attributes (name, type,
+     decl, storage, sym:name, ...); pre-size so none of them resizes */
+  Node *n = NewHashSized(12);
   set_nodeType(n,tag);
   Setfile(n,cparse_file);
   Setline(n,cparse_line);
@@ -39,9 +39,10 @@ void DohDelete(DOH *obj) {
   }
   if (b->flag_intern)
     return;
-  assert(b->refcount > 0);
-  b->refcount--;
-  if (b->refcount <= 0) {
+  assert(Refcount(b) > 0);
+  if (DecrefZero(b)) {
+    if (DohDeferDelete(obj))
+      return;
     objinfo = b->type;
     if (objinfo->doh_del) {
       (objinfo->doh_del) (b);
@@ -87,6 +88,10 @@ void DohIncref(DOH *obj) {
   Incref(obj);
 }
 
+int DohRefcount(DOH *obj) {
+  return (int) Refcount(obj);
+}
+
 /* -----------------------------------------------------------------------------
  * DohClear()
  * ----------------------------------------------------------------------------- */
@@ -231,6 +236,11 @@ int DohCmp(const DOH *obj1, const DOH *obj2) {
 int DohEqual(const DOH *obj1, const DOH *obj2) {
   DohBase *b1 = (DohBase *) obj1;
   DohBase *b2 = (DohBase *) obj2;
+  if (obj1 == obj2) {
+    /* Identical objects.  Hash-consed strings (DohInternString) always take
+       this path. */
+    return 1;
+  }
   if (!b1) {
     return !b2;
   } else if (!b2) {
@@ -310,6 +320,35 @@ DohIterator DohNext(DohIterator iter) {
   return niter;
 }
 
+/* -----------------------------------------------------------------------------
+ * DohInternString()
+ *
+ * Hash-consing.  Returns the canonical interned string for the given
+ * contents, creating it on first use.  Identical contents always map to the
+ * same immutable object, so Equal degenerates to a pointer compare and
+ * Hashval to a cached field read.  The returned object must never be
+ * modified and need not be Deleted.
+ * ----------------------------------------------------------------------------- */
+
+static DOH *intern_table = 0;
+
+DOH *DohInternString(const DOHString_or_char *s) {
+  DOH *is;
+  if (!s)
+    return 0;
+  if (!intern_table) {
+    intern_table = NewHash();
+    DohIntern(intern_table);
+  }
+  is = DohGetattr(intern_table, s);
+  if (!is) {
+    is = DohNewString(s);
+    DohIntern(is);
+    DohSetattr(intern_table, is, is);
+  }
+  return is;
+}
+
 /* -----------------------------------------------------------------------------
  * DohIsMapping()
  * ----------------------------------------------------------------------------- */
@@ -38,6 +38,7 @@
 
 #define DohCheck           DOH_NAMESPACE(Check)
 #define DohIntern          DOH_NAMESPACE(Intern)
+#define DohInternString    DOH_NAMESPACE(InternString)
 #define DohDelete          DOH_NAMESPACE(Delete)
 #define DohCopy            DOH_NAMESPACE(Copy)
 #define DohClear           DOH_NAMESPACE(Clear)
@@ -49,10 +50,13 @@
 #define DohCmp             DOH_NAMESPACE(Cmp)
 #define DohEqual           DOH_NAMESPACE(Equal)
 #define DohIncref          DOH_NAMESPACE(Incref)
+#define DohRefcount        DOH_NAMESPACE(Refcount)
 #define DohCheckattr       DOH_NAMESPACE(Checkattr)
 #define DohSetattr         DOH_NAMESPACE(Setattr)
 #define DohDelattr         DOH_NAMESPACE(Delattr)
 #define DohKeys            DOH_NAMESPACE(Keys)
+#define DohSortedKeys      DOH_NAMESPACE(SortedKeys)
+#define DohHashProbeStats  DOH_NAMESPACE(HashProbeStats)
 #define DohGetInt          DOH_NAMESPACE(GetInt)
 #define DohGetDouble       DOH_NAMESPACE(GetDouble)
 #define DohGetChar         DOH_NAMESPACE(GetChar)
@@ -78,6 +82,7 @@
 #define DohGetfile         DOH_NAMESPACE(Getfile)
 #define DohSetfile         DOH_NAMESPACE(Setfile)
 #define DohReplace         DOH_NAMESPACE(Replace)
+#define DohReplaceMulti    DOH_NAMESPACE(ReplaceMulti)
 #define DohChop            DOH_NAMESPACE(Chop)
 #define DohGetmeta         DOH_NAMESPACE(Getmeta)
 #define DohSetmeta         DOH_NAMESPACE(Setmeta)
@@ -105,7 +110,10 @@
 #define DohFileErrorDisplay   DOH_NAMESPACE(FileErrorDisplay)
 #define DohCopyto          DOH_NAMESPACE(Copyto)
 #define DohNewList         DOH_NAMESPACE(NewList)
+#define DohNewRope         DOH_NAMESPACE(NewRope)
+#define DohNewStringView   DOH_NAMESPACE(NewStringView)
 #define DohNewHash         DOH_NAMESPACE(NewHash)
+#define DohNewHashSized    DOH_NAMESPACE(NewHashSized)
 #define DohNewVoid         DOH_NAMESPACE(NewVoid)
 #define DohSplit           DOH_NAMESPACE(Split)
 #define DohSplitLines      DOH_NAMESPACE(SplitLines)
@@ -114,6 +122,13 @@
 #define DohObjMalloc       DOH_NAMESPACE(ObjMalloc)
 #define DohObjFree         DOH_NAMESPACE(ObjFree)
 #define DohMemoryDebug     DOH_NAMESPACE(MemoryDebug)
+#define DohMemoryAccounting DOH_NAMESPACE(MemoryAccounting)
+#define DohMemoryPhase     DOH_NAMESPACE(MemoryPhase)
+#define DohPushArena       DOH_NAMESPACE(PushArena)
+#define DohPopArena        DOH_NAMESPACE(PopArena)
+#define DohDeferDelete     DOH_NAMESPACE(DeferDelete)
+#define DohPushDeferredDelete DOH_NAMESPACE(PushDeferredDelete)
+#define DohPopDeferredDelete  DOH_NAMESPACE(PopDeferredDelete)
 #define DohStringType      DOH_NAMESPACE(StringType)
 #define DohListType        DOH_NAMESPACE(ListType)
 #define DohHashType        DOH_NAMESPACE(HashType)
@@ -175,6 +190,7 @@ typedef struct {
 
 extern int DohCheck(const DOH *ptr);	/* Check if a DOH object */
 extern void DohIntern(DOH *);	/* Intern an object      */
+extern DOH *DohInternString(const DOHString_or_char *s);	/* Hash-consed immutable string */
 
 /* Basic object methods.  Common to most objects */
 
@@ -189,6 +205,7 @@ extern int DohHashval(const DOH *obj);
 extern int DohCmp(const DOH *obj1, const DOH *obj2);
 extern int DohEqual(const DOH *obj1, const DOH *obj2);
 extern void DohIncref(DOH *obj);
+extern int DohRefcount(DOH *obj);
 
 /* Mapping methods */
 
@@ -197,6 +214,7 @@ extern int DohSetattr(DOH *obj, const DOHString_or_char *name, const DOHObj_or_c
 extern int DohDelattr(DOH *obj, const DOHString_or_char *name);
 extern int DohCheckattr(DOH *obj, const DOHString_or_char *name, const DOHString_or_char *value);
 extern DOH *DohKeys(DOH *obj);
+extern DOH *DohSortedKeys(DOH *obj, int (*cmp) (const DOH *, const DOH *));
 extern int DohGetInt(DOH *obj, const DOHString_or_char *name);
 extern void DohSetInt(DOH *obj, const DOHString_or_char *name, int);
 extern double DohGetDouble(DOH *obj, const DOHString_or_char *name);
@@ -244,6 +262,7 @@ extern void DohSetfile(DOH *obj, DOH *file);
   /* String Methods */
 
 extern int DohReplace(DOHString * src, const DOHString_or_char *token, const DOHString_or_char *rep, int flags);
+extern int DohReplaceMulti(DOHString * src, DOHHash * patterns);
 extern void DohChop(DOHString * src);
 
 /* Meta-variables */
@@ -268,6 +287,7 @@ extern int DohIsFile(const DOH *obj);
 
 extern void DohSetMaxHashExpand(int count);
 extern int DohGetMaxHashExpand(void);
+extern int DohHashProbeStats(DOH *obj, int *nitems, int *nslots, int histogram[], int histmax);
 extern void DohSetmark(DOH *obj, int x);
 extern int DohGetmark(DOH *obj);
 
@@ -309,6 +329,9 @@ extern DOHFile *DohNewFileFromFd(int fd);
 extern void DohFileErrorDisplay(DOHString * filename);
 extern int DohCopyto(DOHFile * input, DOHFile * output);
 extern void DohCloseAllOpenFiles(void);
+extern void DohFileWriteIfChanged(int enable);
+extern void DohFileDiscardOutputs(int enable);
+extern void DohCommitAllPendingFiles(void);
 
 
 /* -----------------------------------------------------------------------------
@@ -318,11 +341,24 @@ extern void DohCloseAllOpenFiles(void);
 extern DOHList *DohNewList(void);
 extern void DohSortList(DOH *lo, int (*cmp) (const DOH *, const DOH *));
 
+/* -----------------------------------------------------------------------------
+ * Rope - append-only chunked string for building large code sections
+ * ----------------------------------------------------------------------------- */
+
+extern DOHString *DohNewRope(void);
+
+/* -----------------------------------------------------------------------------
+ * StringView - immutable zero-copy substring of a String
+ * ----------------------------------------------------------------------------- */
+
+extern DOHString *DohNewStringView(DOH *parent, int offset, int len);
+
 /* -----------------------------------------------------------------------------
  * Hash
  * ----------------------------------------------------------------------------- */
 
 extern DOHHash *DohNewHash(void);
+extern DOHHash *DohNewHashSized(int nitems);
 
 /* -----------------------------------------------------------------------------
  * Void
@@ -341,6 +377,23 @@ typedef union DohFuncPtr {
 
 extern void DohMemoryDebug(void);
 
+/* Opt-in per-type object accounting reported at phase boundaries */
+extern void DohMemoryAccounting(int on);
+extern void DohMemoryPhase(const char *phase);
+
+/* Arena (epoch) allocation.  Objects created between a push and the matching
+   pop are pool-allocated separately and bulk-freed at the pop; results that
+   must survive the arena have to be copied out first. */
+extern void DohPushArena(void);
+extern void DohPopArena(void);
+
+/* Deferred reclamation.  Inside a scope, objects whose refcount reaches zero
+   are queued and destroyed in a batch at the pop; an object that regains a
+   reference before then escapes untouched. */
+extern int DohDeferDelete(DOH *obj);
+extern void DohPushDeferredDelete(void);
+extern void DohPopDeferredDelete(void);
+
 #ifndef DOH_LONG_NAMES
 /* Macros to invoke the above functions.  Includes the location of
    the caller to simplify debugging if something goes wrong */
@@ -406,34 +459,48 @@ extern void DohMemoryDebug(void);
 #define ClearFlag(o,n)     DohSetFlagAttr(o,n,"")
 #define Readline           DohReadline
 #define Replace            DohReplace
+#define ReplaceMulti       DohReplaceMulti
 #define Chop               DohChop
 #define Getmeta            DohGetmeta
 #define Setmeta            DohSetmeta
 #define Delmeta            DohDelmeta
+#define InternString       DohInternString
+#define PushArena          DohPushArena
+#define PopArena           DohPopArena
+#define PushDeferredDelete DohPushDeferredDelete
+#define PopDeferredDelete  DohPopDeferredDelete
 #define NewString          DohNewString
 #define NewStringEmpty     DohNewStringEmpty
 #define NewStringWithSize  DohNewStringWithSize
 #define NewStringf         DohNewStringf
 #define NewHash            DohNewHash
+#define NewHashSized       DohNewHashSized
 #define NewList            DohNewList
+#define NewRope            DohNewRope
+#define NewStringView      DohNewStringView
 #define NewFile            DohNewFile
 #define NewFileFromFile    DohNewFileFromFile
 #define NewFileFromFd      DohNewFileFromFd
 #define FileErrorDisplay   DohFileErrorDisplay
 #define NewVoid            DohNewVoid
 #define Keys               DohKeys
+#define SortedKeys         DohSortedKeys
 #define Strcmp             DohStrcmp
 #define Strncmp            DohStrncmp
 #define Strstr             DohStrstr
 #define Strchr             DohStrchr
 #define Copyto             DohCopyto
 #define CloseAllOpenFiles  DohCloseAllOpenFiles
+#define FileWriteIfChanged DohFileWriteIfChanged
+#define FileDiscardOutputs DohFileDiscardOutputs
+#define CommitAllPendingFiles DohCommitAllPendingFiles
 #define Split              DohSplit
 #define SplitLines         DohSplitLines
 #define Setmark            DohSetmark
 #define Getmark            DohGetmark
 #define SetMaxHashExpand   DohSetMaxHashExpand
 #define GetMaxHashExpand   DohGetMaxHashExpand
+#define HashProbeStats     DohHashProbeStats
 #define None               DohNone
 #define Call               DohCall
 #define First              DohFirst
@@ -110,14 +110,36 @@ typedef struct {
   unsigned int flag_marked:1;	/* Mark flag. Used to avoid recursive loops in places */
   unsigned int flag_user:1;	/* User flag */
   unsigned int flag_usermark:1;	/* User marked */
+#ifdef DOH_THREADSAFE
+  unsigned int refcount;	/* Reference count (full word for atomic operations) */
+#else
   unsigned int refcount:28;	/* Reference count (max 16 million) */
+#endif
 } DohBase;
 
-/* Macros for decrefing and increfing (safe for null objects). */
-
+/* Macros for decrefing and increfing (safe for null objects).
+ *
+ * DOH_THREADSAFE (opt-in, GCC/Clang) makes reference counting and object
+ * allocation safe to use from several threads: refcounts become atomic and
+ * the allocator state in memory.c becomes thread-local.  It does NOT make
+ * the containers themselves concurrent - threads sharing a Hash or String
+ * still need external discipline.  DecrefZero decrements and reports
+ * whether this was the last reference, which under DOH_THREADSAFE must be
+ * a single atomic operation. */
+
+#ifdef DOH_THREADSAFE
+#define Decref(a)         if (a) __atomic_sub_fetch(&((DohBase *) a)->refcount, 1, __ATOMIC_ACQ_REL)
+#define Incref(a)         if (a) __atomic_add_fetch(&((DohBase *) a)->refcount, 1, __ATOMIC_RELAXED)
+#define Refcount(a)       __atomic_load_n(&((DohBase *) a)->refcount, __ATOMIC_ACQUIRE)
+#define DecrefZero(a)     (__atomic_sub_fetch(&((DohBase *) a)->refcount, 1, __ATOMIC_ACQ_REL) == 0)
+#define DOH_THREAD_LOCAL  __thread
+#else
 #define Decref(a)         if (a) ((DohBase *) a)->refcount--
 #define Incref(a)         if (a) ((DohBase *) a)->refcount++
 #define Refcount(a)       ((DohBase *) a)->refcount
+#define DecrefZero(a)     (--((DohBase *) a)->refcount == 0)
+#define DOH_THREAD_LOCAL
+#endif
 
 /* Macros for manipulating objects in a safe manner */
 #define ObjData(a)        ((DohBase *)a)->data
@@ -19,12 +19,43 @@
 #endif
 #include <errno.h>
 
+/* stdio buffer size for files opened through NewFile */
+#ifndef DOH_FILE_BUFSIZE
+#define DOH_FILE_BUFSIZE 262144
+#endif
+
 typedef struct {
   FILE *filep;
   int fd;
   int closeondel;
+  char *pending;		/* In write-if-changed mode, the target path; filep is a tmpfile */
 } DohFile;
 
+/* In write-if-changed mode, files opened for writing accumulate in a
+   temporary file and only replace the target on close if the content
+   differs, leaving the timestamp of up-to-date outputs alone */
+static int write_if_changed = 0;
+
+void DohFileWriteIfChanged(int enable) {
+  write_if_changed = enable;
+}
+
+/* In discard mode, every file opened for writing is backed by the null
+   device: generation runs normally, stdio buffers the output in memory
+   and the kernel drops it, and nothing is created on disk.  Used for
+   validation runs (-o /dev/null and friends). */
+static int discard_outputs = 0;
+
+#if defined(_WIN32)
+#define DOH_NULL_DEVICE "NUL"
+#else
+#define DOH_NULL_DEVICE "/dev/null"
+#endif
+
+void DohFileDiscardOutputs(int enable) {
+  discard_outputs = enable;
+}
+
 /* -----------------------------------------------------------------------------
  * open_files_list_instance
  * open_files_list_add
@@ -94,6 +125,79 @@ void DohCloseAllOpenFiles() {
   DohClear(all_open_files);
 }
 
+/* -----------------------------------------------------------------------------
+ * file_commit_pending()
+ *
+ * Compare the temporary file accumulated in write-if-changed mode against the
+ * target and rewrite the target only when the content differs.  The old file
+ * is read in text mode and the target written in text mode so newline
+ * translation matches a plain fopen(name, "w").
+ * ----------------------------------------------------------------------------- */
+
+static void file_commit_pending(DohFile *f) {
+  char nbuf[8192], obuf[8192];
+  FILE *tmp = f->filep;
+  FILE *old;
+  int same = 0;
+  fflush(tmp);
+  rewind(tmp);
+  old = fopen(f->pending, "r");
+  if (old) {
+    same = 1;
+    for (;;) {
+      size_t n1 = fread(nbuf, 1, sizeof nbuf, tmp);
+      size_t n2 = fread(obuf, 1, sizeof obuf, old);
+      if (n1 != n2 || memcmp(nbuf, obuf, n1) != 0) {
+	same = 0;
+	break;
+      }
+      if (n1 < sizeof nbuf)
+	break;
+    }
+    fclose(old);
+  }
+  if (!same) {
+    FILE *out = fopen(f->pending, "w");
+    rewind(tmp);
+    if (out) {
+      size_t n;
+      while ((n = fread(nbuf, 1, sizeof nbuf, tmp)) > 0)
+	fwrite(nbuf, 1, n, out);
+      fclose(out);
+    } else {
+      fprintf(stderr, "Unable to write file %s: %s\n", f->pending, strerror(errno));
+    }
+  }
+}
+
+/* -----------------------------------------------------------------------------
+ * DohCommitAllPendingFiles()
+ *
+ * Commit and close every write-if-changed file that is still open.  Called on
+ * successful termination for output files whose DOH objects are never
+ * released before exit; the error path goes through DohCloseAllOpenFiles
+ * instead, which discards pending content just as a partial write used to be
+ * discarded.
+ * ----------------------------------------------------------------------------- */
+
+void DohCommitAllPendingFiles() {
+  int i;
+  DOHList *all_open_files = open_files_list_instance();
+  for (i = 0; i < DohLen(all_open_files); i++) {
+    DohFile *f = 0;
+    DOHString *sf = Getitem(all_open_files, i);
+    int check = sscanf(Char(sf), "%p", (void **) &f);
+    assert(check == 1);
+    (void) check;
+    if (f->closeondel && f->filep && f->pending) {
+      file_commit_pending(f);
+      fclose(f->filep);
+      f->filep = 0;
+      f->closeondel = 0;
+    }
+  }
+}
+
 /* -----------------------------------------------------------------------------
  * DelFile()
  * ----------------------------------------------------------------------------- */
@@ -102,6 +206,8 @@ static void DelFile(DOH *fo) {
   DohFile *f = (DohFile *) ObjData(fo);
   if (f->closeondel) {
     if (f->filep) {
+      if (f->pending)
+	file_commit_pending(f);
       fclose(f->filep);
     }
 #ifdef DOH_INTFILE
@@ -111,6 +217,8 @@ static void DelFile(DOH *fo) {
 #endif
   open_files_list_remove(f);
   }
+  if (f->pending)
+    DohFree(f->pending);
   DohFree(f);
 }
 
@@ -285,14 +393,61 @@ DOH *DohNewFile(DOHString *filename, const char *mode, DOHList *newfiles) {
   FILE *file;
   char *filen;
 
+  char *pending = 0;
+
   filen = Char(filename);
-  file = fopen(filen, mode);
+  if (discard_outputs && strcmp(mode, "w") == 0) {
+    filen = (char *) DOH_NULL_DEVICE;
+    file = fopen(filen, mode);
+    if (!file)
+      return 0;
+    setvbuf(file, 0, _IOFBF, DOH_FILE_BUFSIZE);
+    f = (DohFile *) DohMalloc(sizeof(DohFile));
+    if (!f) {
+      fclose(file);
+      return 0;
+    }
+    if (newfiles)
+      Append(newfiles, filename);
+    f->filep = file;
+    f->fd = 0;
+    f->closeondel = 1;
+    f->pending = 0;
+    obj = DohObjMalloc(&DohFileType, f);
+    open_files_list_add(f);
+    return obj;
+  }
+  if (write_if_changed && strcmp(mode, "w") == 0) {
+    /* Probe the target so permission problems still surface here, then
+       accumulate output in a tmpfile; DelFile rewrites the target only if
+       the content changed */
+    FILE *probe = fopen(filen, "ab");
+    if (!probe)
+      return 0;
+    fclose(probe);
+    file = tmpfile();
+    if (file) {
+      size_t len = strlen(filen) + 1;
+      pending = (char *) DohMalloc(len);
+      memcpy(pending, filen, len);
+    } else {
+      file = fopen(filen, mode);
+    }
+  } else {
+    file = fopen(filen, mode);
+  }
   if (!file)
     return 0;
 
+  /* Use a large stdio buffer so the many small Printv/Dump fragments the
+     backends emit coalesce into a handful of large sequential writes */
+  setvbuf(file, 0, _IOFBF, DOH_FILE_BUFSIZE);
+
   f = (DohFile *) DohMalloc(sizeof(DohFile));
   if (!f) {
     fclose(file);
+    if (pending)
+      DohFree(pending);
     return 0;
   }
   if (newfiles)
@@ -300,6 +455,7 @@ DOH *DohNewFile(DOHString *filename, const char *mode, DOHList *newfiles) {
   f->filep = file;
   f->fd = 0;
   f->closeondel = 1;
+  f->pending = pending;
   obj = DohObjMalloc(&DohFileType, f);
   open_files_list_add(f);
   return obj;
@@ -319,6 +475,7 @@ DOH *DohNewFileFromFile(FILE *file) {
   f->filep = file;
   f->fd = 0;
   f->closeondel = 0;
+  f->pending = 0;
   return DohObjMalloc(&DohFileType, f);
 }
 
@@ -336,6 +493,7 @@ DOH *DohNewFileFromFd(int fd) {
   f->filep = 0;
   f->fd = fd;
   f->closeondel = 0;
+  f->pending = 0;
   return DohObjMalloc(&DohFileType, f);
 }
 
@@ -86,6 +86,400 @@ static DOH *encode(char *name, DOH *s) {
   return ns;
 }
 
+/* -----------------------------------------------------------------------------
+ * Compiled format cache
+ *
+ * Printf is called millions of times, almost always with a literal format
+ * string, so the same format gets re-parsed over and over.  The first time a
+ * format is seen it is compiled into a list of literal runs and conversion
+ * specs; later calls with the same format pointer replay the compiled form,
+ * writing each literal run in one operation instead of a Putc per character.
+ * Formats the compiler does not handle ('*' widths, truncated specs) are
+ * flagged and always replayed through the interpreter below.  Cache entries
+ * keep a private copy of the format text and are verified against it, so a
+ * reused buffer with different contents just recompiles.
+ * ----------------------------------------------------------------------------- */
+
+#define FMT_CACHE_SIZE  512
+#define FMT_MAX_FORMAT  256
+
+typedef struct FmtSpec {
+  int litpos;			/* Literal run preceding this spec */
+  int litlen;
+  char newformat[FMT_MAX_FORMAT];	/* Complete format for one conversion */
+  char encoder[128];
+  char code;			/* Conversion char, or '%' for a literal percent */
+  int nflen;			/* strlen(newformat) */
+  int maxwidth;			/* Precomputed max(width, precision) */
+} FmtSpec;
+
+typedef struct CompiledFmt {
+  const char *key;		/* Format pointer the entry was built from */
+  char *copy;			/* Private copy of the format text */
+  FmtSpec *specs;
+  int nspecs;
+  int tailpos;			/* Trailing literal run */
+  int taillen;
+  int interpret;		/* 1 = not compilable, use the interpreter */
+  struct CompiledFmt *next;
+} CompiledFmt;
+
+static CompiledFmt *fmt_cache[FMT_CACHE_SIZE];
+
+/* Compile a single conversion spec.  *pp points just past the '%' and is
+   advanced past the spec on success.  Mirrors the interpreter's states;
+   returns 0 on anything it cannot reproduce without the argument list. */
+static int fmt_compile_spec(const char **pp, FmtSpec *spec) {
+  static const char *fmt_codes = "dioxXucsSfeEgGp";
+  const char *p = *pp;
+  char *fmt = spec->newformat;
+  char *fmt_end = spec->newformat + FMT_MAX_FORMAT - 2;
+  char temp[64];
+  char *w = 0;
+  char *ec = 0;
+  int widthval = 0;
+  int precval = 0;
+  int plevel = 0;
+  int state = 10;
+
+  *(fmt++) = '%';
+  spec->encoder[0] = 0;
+  while (*p) {
+    if (fmt >= fmt_end)
+      return 0;
+    switch (state) {
+    case 10:			/* Look for a width and precision */
+      if (isdigit((int) *p) && (*p != '0')) {
+	w = temp;
+	*(w++) = *p;
+	*(fmt++) = *p;
+	state = 20;
+      } else if (strchr(fmt_codes, *p)) {
+	p--;
+	state = 100;
+      } else if (*p == '%') {
+	spec->code = '%';
+	*pp = p + 1;
+	return 1;
+      } else if (*p == '(') {
+	++plevel;
+	ec = spec->encoder;
+	state = 60;
+      } else if (*p == '*') {
+	return 0;
+      } else {
+	*(fmt++) = *p;
+      }
+      break;
+
+    case 20:			/* Collecting a width */
+      if (isdigit((int) *p)) {
+	*(w++) = *p;
+	*(fmt++) = *p;
+      } else if (strchr(fmt_codes, *p)) {
+	*w = 0;
+	widthval = atoi(temp);
+	p--;
+	state = 100;
+      } else if (*p == '.') {
+	*w = 0;
+	widthval = atoi(temp);
+	w = temp;
+	*(fmt++) = *p;
+	state = 40;
+      } else {
+	*w = 0;
+	widthval = atoi(temp);
+	state = 50;
+      }
+      break;
+
+    case 40:			/* Start of precision expected */
+      if (isdigit((int) *p) && (*p != '0')) {
+	*(fmt++) = *p;
+	*(w++) = *p;
+	state = 41;
+      } else if (strchr(fmt_codes, *p)) {
+	p--;
+	state = 100;
+      } else if (*p == '*') {
+	return 0;
+      } else {
+	*(fmt++) = *p;
+	state = 50;
+      }
+      break;
+    case 41:			/* Collecting a precision */
+      if (isdigit((int) *p)) {
+	*(fmt++) = *p;
+	*(w++) = *p;
+      } else if (strchr(fmt_codes, *p)) {
+	*w = 0;
+	precval = atoi(temp);
+	p--;
+	state = 100;
+      } else {
+	*w = 0;
+	precval = atoi(temp);
+	*(fmt++) = *p;
+	state = 50;
+      }
+      break;
+      /* Hang out, wait for format specifier */
+    case 50:
+      if (strchr(fmt_codes, *p)) {
+	p--;
+	state = 100;
+      } else {
+	*(fmt++) = *p;
+      }
+      break;
+
+      /* Got an encoding header */
+    case 60:
+      if (ec >= spec->encoder + sizeof(spec->encoder) - 1)
+	return 0;
+      if (*p == '(') {
+	++plevel;
+	*ec = *p;
+	ec++;
+      } else if (*p == ')') {
+	--plevel;
+	if (plevel <= 0) {
+	  *ec = 0;
+	  state = 10;
+	} else {
+	  *ec = *p;
+	  ec++;
+	}
+      } else {
+	*ec = *p;
+	ec++;
+      }
+      break;
+    case 100:			/* Got a formatting code */
+      if (*p == 'n')
+	return 0;
+      spec->code = *p;
+      spec->maxwidth = (widthval < precval) ? precval : widthval;
+      *(fmt++) = (*p == 'S') ? 's' : *p;
+      *fmt = 0;
+      spec->nflen = (int) (fmt - spec->newformat);
+      *pp = p + 1;
+      return 1;
+    }
+    p++;
+  }
+  return 0;			/* Ran off the end mid-spec */
+}
+
+/* Compile a whole format string into cf.  Sets cf->interpret when the
+   format has to be replayed through the interpreter instead. */
+static void fmt_compile(CompiledFmt *cf, const char *format) {
+  const char *p = format;
+  const char *lit = p;
+  int maxspecs = 4;
+
+  cf->specs = (FmtSpec *) DohMalloc(maxspecs * sizeof(FmtSpec));
+  cf->nspecs = 0;
+  cf->interpret = 0;
+  while (*p) {
+    if (*p == '%') {
+      FmtSpec *spec;
+      const char *sp = p + 1;
+      if (cf->nspecs == maxspecs) {
+	maxspecs *= 2;
+	cf->specs = (FmtSpec *) DohRealloc(cf->specs, maxspecs * sizeof(FmtSpec));
+	assert(cf->specs);
+      }
+      spec = &cf->specs[cf->nspecs];
+      if (!fmt_compile_spec(&sp, spec)) {
+	cf->interpret = 1;
+	return;
+      }
+      spec->litpos = (int) (lit - format);
+      spec->litlen = (int) (p - lit);
+      cf->nspecs++;
+      p = sp;
+      lit = p;
+    } else {
+      p++;
+    }
+  }
+  cf->tailpos = (int) (lit - format);
+  cf->taillen = (int) (p - lit);
+}
+
+/* Look up (or build) the compiled form of a format string */
+static CompiledFmt *fmt_lookup(const char *format) {
+  int h = (int) ((((unsigned long) (size_t) format) >> 3) & (FMT_CACHE_SIZE - 1));
+  CompiledFmt *cf;
+
+  for (cf = fmt_cache[h]; cf; cf = cf->next) {
+    if (cf->key == format) {
+      if (strcmp(cf->copy, format) == 0)
+	return cf;
+      /* Same address, different contents (a reused buffer): recompile */
+      DohFree(cf->copy);
+      DohFree(cf->specs);
+      break;
+    }
+  }
+  if (!cf) {
+    cf = (CompiledFmt *) DohMalloc(sizeof(CompiledFmt));
+    cf->key = format;
+    cf->next = fmt_cache[h];
+    fmt_cache[h] = cf;
+  }
+  cf->copy = (char *) DohMalloc(strlen(format) + 1);
+  strcpy(cf->copy, format);
+  fmt_compile(cf, cf->copy);
+  return cf;
+}
+
+/* Replay a compiled format.  The argument handling matches the
+   interpreter's case 100 exactly. */
+static int fmt_exec(DOH *so, CompiledFmt *cf, va_list ap) {
+  char obuffer[OBUFLEN];
+  char encoder[128];
+  char *stemp;
+  int nbytes = 0;
+  int maxwidth;
+  int ivalue;
+  double dvalue;
+  void *pvalue;
+  int i;
+
+  for (i = 0; i < cf->nspecs; i++) {
+    FmtSpec *spec = &cf->specs[i];
+    if (spec->litlen) {
+      if (Writen(so, cf->copy + spec->litpos, spec->litlen) < 0)
+	return -1;
+      nbytes += spec->litlen;
+    }
+    if (spec->code == '%') {
+      Putc('%', so);
+      nbytes++;
+      continue;
+    }
+    maxwidth = spec->maxwidth;
+    if ((spec->code == 's') || (spec->code == 'S')) {	/* Null-Terminated string */
+      DOH *doh;
+      DOH *Sval;
+      DOH *enc = 0;
+      doh = va_arg(ap, DOH *);
+      if (DohCheck(doh)) {
+	/* Is a DOH object. */
+	if (DohIsString(doh)) {
+	  Sval = doh;
+	} else {
+	  Sval = Str(doh);
+	}
+	if (spec->encoder[0]) {
+	  strcpy(encoder, spec->encoder);	/* encode() clips the name at ':' */
+	  enc = encode(encoder, Sval);
+	  maxwidth = maxwidth + spec->nflen + Len(enc);
+	} else {
+	  maxwidth = maxwidth + spec->nflen + Len(Sval);
+	}
+	if ((maxwidth + 1) < OBUFLEN) {
+	  stemp = obuffer;
+	} else {
+	  stemp = (char *) DohMalloc(maxwidth + 1);
+	}
+	if (enc) {
+	  nbytes += sprintf(stemp, spec->newformat, Data(enc));
+	} else {
+	  nbytes += sprintf(stemp, spec->newformat, Data(Sval));
+	}
+	if (Writen(so, stemp, (int) strlen(stemp)) < 0)
+	  return -1;
+	if ((DOH *) Sval != doh) {
+	  Delete(Sval);
+	}
+	if (enc)
+	  Delete(enc);
+	if (spec->code == 'S') {
+	  Delete(doh);
+	}
+	if (stemp != obuffer) {
+	  DohFree(stemp);
+	}
+      } else {
+	if (!doh)
+	  doh = (char *) "";
+
+	if (spec->encoder[0]) {
+	  DOH *s = NewString(doh);
+	  Seek(s, 0, SEEK_SET);
+	  strcpy(encoder, spec->encoder);
+	  enc = encode(encoder, s);
+	  Delete(s);
+	  doh = Char(enc);
+	} else {
+	  enc = 0;
+	}
+	maxwidth = maxwidth + spec->nflen + (int) strlen((char *) doh);
+	if ((maxwidth + 1) < OBUFLEN) {
+	  stemp = obuffer;
+	} else {
+	  stemp = (char *) DohMalloc(maxwidth + 1);
+	}
+	nbytes += sprintf(stemp, spec->newformat, doh);
+	if (Writen(so, stemp, (int) strlen(stemp)) < 0)
+	  return -1;
+	if (stemp != obuffer) {
+	  DohFree(stemp);
+	}
+	if (enc)
+	  Delete(enc);
+      }
+    } else {
+      maxwidth = maxwidth + spec->nflen + 64;
+      if (maxwidth < OBUFLEN)
+	stemp = obuffer;
+      else
+	stemp = (char *) DohMalloc(maxwidth + 1);
+      switch (spec->code) {
+      case 'd':
+      case 'i':
+      case 'o':
+      case 'u':
+      case 'x':
+      case 'X':
+      case 'c':
+	ivalue = va_arg(ap, int);
+	nbytes += sprintf(stemp, spec->newformat, ivalue);
+	break;
+      case 'f':
+      case 'g':
+      case 'e':
+      case 'E':
+      case 'G':
+	dvalue = va_arg(ap, double);
+	nbytes += sprintf(stemp, spec->newformat, dvalue);
+	break;
+      case 'p':
+	pvalue = va_arg(ap, void *);
+	nbytes += sprintf(stemp, spec->newformat, pvalue);
+	break;
+      default:
+	break;
+      }
+      if (Writen(so, stemp, (int) strlen(stemp)) < 0)
+	return -1;
+      if (stemp != obuffer)
+	DohFree(stemp);
+    }
+  }
+  if (cf->taillen) {
+    if (Writen(so, cf->copy + cf->tailpos, cf->taillen) < 0)
+      return -1;
+    nbytes += cf->taillen;
+  }
+  return nbytes;
+}
+
 /* -----------------------------------------------------------------------------
  * DohvPrintf()
  *
@@ -124,6 +518,12 @@ int DohvPrintf(DOH *so, const char *format, va_list ap) {
   char encoder[128], *ec = 0;
   int plevel = 0;
 
+  {
+    CompiledFmt *cf = fmt_lookup(format);
+    if (!cf->interpret)
+      return fmt_exec(so, cf, ap);
+  }
+
   memset(newformat, 0, sizeof(newformat));
 
   while (*p) {
@@ -1,5 +1,5 @@
 /* -----------------------------------------------------------------------------
- * This file is part of SWIG, which is licensed as a whole under version 3 
+ * This file is part of SWIG, which is licensed as a whole under version 3
  * (or any later version) of the GNU General Public License. Some additional
  * terms also apply to certain portions of SWIG. The full details of the SWIG
  * license and copyrights can be found in the LICENSE and COPYRIGHT files
@@ -8,27 +8,58 @@
  *
  * hash.c
  *
- *     Implements a simple hash table object.
+ *     Implements a hash table object.  Entries live in a dense array in
+ *     insertion order; a sparse power-of-two index array holds entry
+ *     numbers and is probed linearly.  Each entry caches its key's hash
+ *     value, so probing and resizing never re-hash a key.  First/Next and
+ *     Keys walk the dense array, giving deterministic insertion-ordered
+ *     iteration with no per-call allocation.
+ *
+ *     Copies are made copy-on-write: Copy() merely bumps a share count on
+ *     the slot and entry arrays, and the first mutation of any sharer
+ *     clones them.  Template instantiation copies whole parse trees and
+ *     then rewrites only a fraction of the nodes, so most copies never
+ *     pay for the duplicate.
  * ----------------------------------------------------------------------------- */
 
 #include "dohint.h"
 
 extern DohObjInfo DohHashType;
 
-/* Hash node */
-typedef struct HashNode {
+/* Hash entry.  key == 0 marks a deleted entry that iteration skips. */
+typedef struct HashEntry {
   DOH *key;
   DOH *object;
-  struct HashNode *next;
-} HashNode;
+  int hashval;			/* Cached Hashval(key) */
+} HashEntry;
+
+/* Slot states in the sparse index.  Anything >= 0 is an entry number. */
+#define SLOT_EMPTY    (-1)
+#define SLOT_DELETED  (-2)
+
+/* Shared ownership header for the slot and entry arrays.  When a hash is
+   created the header, entries and slots are carved from one allocation;
+   the embedded flags record which arrays still live inside that block so
+   resizing and deletion know what may be freed individually. */
+typedef struct HashShare {
+  int count;			/* Number of Hash objects sharing the arrays */
+  int slots_embedded;
+  int entries_embedded;
+  int pad;			/* Keep the entry array 8-byte aligned */
+} HashShare;
 
 /* Hash object */
 typedef struct Hash {
   DOH *file;
   int line;
-  HashNode **hashtable;
-  int hashsize;
-  int nitems;
+  int *slots;			/* Sparse index into entries. Power-of-two sized */
+  HashEntry *entries;		/* Dense entry array in insertion order */
+  int hashsize;			/* Size of slots */
+  int nused;			/* Occupied slots, including tombstones */
+  int maxentries;		/* Capacity of entries */
+  int nentries;			/* Used entries, including deleted ones */
+  int nitems;			/* Live entries */
+  HashShare *share;		/* Shared ownership of slots/entries */
 } Hash;
 
 /* Key interning structure */
@@ -42,11 +73,31 @@ typedef struct KeyValue {
 static KeyValue *root = 0;
 static int max_expand = 1;
 
+/* Nearly every char* key lookup comes from a string literal ("name",
+   "sym:name", "type", ...) whose address is stable for the life of the
+   process, and the same few dozen literals account for almost all of the
+   traffic.  A small direct-mapped cache keyed on the pointer skips the
+   intern tree for them; one strcmp verifies the hit, so a recycled heap
+   pointer that happens to land on a filled slot cannot return the wrong
+   key. */
+#define KEY_PTR_CACHE_SIZE 512
+
+typedef struct KeyPtrCacheEntry {
+  const char *addr;		/* Caller's pointer as passed in */
+  KeyValue *kv;			/* Interned key it resolved to   */
+} KeyPtrCacheEntry;
+
+static KeyPtrCacheEntry key_ptr_cache[KEY_PTR_CACHE_SIZE];
+
 /* Find or create a key in the interned key table */
 static DOH *find_key(DOH *doh_c) {
   char *c = (char *) doh_c;
   KeyValue *r, *s;
+  KeyPtrCacheEntry *pc;
   int d = 0;
+  pc = &key_ptr_cache[(unsigned int) (((size_t) c) >> 3) & (KEY_PTR_CACHE_SIZE - 1)];
+  if (pc->addr == c && strcmp(pc->kv->cstr, c) == 0)
+    return pc->kv->sstr;
   /* OK, sure, we use a binary tree for maintaining interned
      symbols.  Then we use their hash values for accessing secondary
      hash tables. */
@@ -55,8 +106,11 @@ static DOH *find_key(DOH *doh_c) {
   while (r) {
     s = r;
     d = strcmp(r->cstr, c);
-    if (d == 0)
+    if (d == 0) {
+      pc->addr = c;
+      pc->kv = r;
       return r->sstr;
+    }
     if (d < 0)
       r = r->left;
     else
@@ -78,27 +132,151 @@ static DOH *find_key(DOH *doh_c) {
     else
       s->right = r;
   }
+  pc->addr = c;
+  pc->kv = r;
   return r->sstr;
 }
 
-#define HASH_INIT_SIZE   7
+#define HASH_INIT_SIZE   8
+
+/* Compare a lookup key against a live entry's key.  The cached hash value
+   has already matched, so most calls are on actual hits. */
+static int key_equal(DOH *ko, DOH *nk) {
+  DohObjInfo *k_type = ((DohBase *) ko)->type;
+  if (ko == nk)
+    return 1;
+  if (k_type != ((DohBase *) nk)->type)
+    return 0;
+  if (k_type->doh_equal)
+    return (k_type->doh_equal) (ko, nk);
+  return (k_type->doh_cmp) (ko, nk) == 0;
+}
 
-/* Create a new hash node */
-static HashNode *NewNode(DOH *k, void *obj) {
-  HashNode *hn = (HashNode *) DohMalloc(sizeof(HashNode));
-  hn->key = k;
-  Incref(hn->key);
-  hn->object = obj;
-  Incref(obj);
-  hn->next = 0;
-  return hn;
+static int *hash_alloc_slots(int size) {
+  int i;
+  int *slots = (int *) DohMalloc(size * sizeof(int));
+  for (i = 0; i < size; i++)
+    slots[i] = SLOT_EMPTY;
+  return slots;
 }
 
-/* Delete a hash node */
-static void DelNode(HashNode *hn) {
-  Delete(hn->key);
-  Delete(hn->object);
-  DohFree(hn);
+static HashShare *hash_new_share(void) {
+  HashShare *share = (HashShare *) DohMalloc(sizeof(HashShare));
+  share->count = 1;
+  share->slots_embedded = 0;
+  share->entries_embedded = 0;
+  return share;
+}
+
+/* Allocate a hash sized for about nitems entries, carving the share
+   header, entry array and slot array out of a single block */
+static Hash *hash_create(int nitems) {
+  Hash *h;
+  HashShare *share;
+  char *block;
+  int hashsize = HASH_INIT_SIZE;
+  int maxentries = HASH_INIT_SIZE;
+  int i;
+  while (4 * nitems >= 3 * hashsize)
+    hashsize *= 2;
+  while (maxentries < nitems)
+    maxentries *= 2;
+  h = (Hash *) DohMalloc(sizeof(Hash));
+  block = (char *) DohMalloc(sizeof(HashShare) + maxentries * sizeof(HashEntry) + hashsize * sizeof(int));
+  share = (HashShare *) block;
+  share->count = 1;
+  share->slots_embedded = 1;
+  share->entries_embedded = 1;
+  h->share = share;
+  h->entries = (HashEntry *) (block + sizeof(HashShare));
+  h->slots = (int *) (block + sizeof(HashShare) + maxentries * sizeof(HashEntry));
+  for (i = 0; i < hashsize; i++)
+    h->slots[i] = SLOT_EMPTY;
+  h->hashsize = hashsize;
+  h->maxentries = maxentries;
+  h->nentries = 0;
+  h->nitems = 0;
+  h->nused = 0;
+  h->file = 0;
+  h->line = 0;
+  return h;
+}
+
+/* Break copy-on-write sharing before a mutation.  Clones the slot and
+   entry arrays and takes a reference on every live entry; the remaining
+   sharers keep the originals. */
+static void hash_unshare(Hash *h) {
+  int i;
+  int *slots;
+  HashEntry *entries;
+
+  if (h->share->count == 1)
+    return;
+  slots = (int *) DohMalloc(h->hashsize * sizeof(int));
+  memcpy(slots, h->slots, h->hashsize * sizeof(int));
+  entries = (HashEntry *) DohMalloc(h->maxentries * sizeof(HashEntry));
+  memcpy(entries, h->entries, h->nentries * sizeof(HashEntry));
+  for (i = 0; i < h->nentries; i++) {
+    if (entries[i].key) {
+      Incref(entries[i].key);
+      Incref(entries[i].object);
+    }
+  }
+  h->share->count--;
+  h->slots = slots;
+  h->entries = entries;
+  h->share = hash_new_share();
+}
+
+/* Convert a hash value into a starting slot index.  A multiplicative mix
+   folded with its high bits spreads weak hash values across the
+   power-of-two table; String hashing is strong on its own these days, but
+   Hashval is an open interface and this keeps any lesser implementation
+   from clustering for one multiply. */
+static int hash_index(int hv, int mask) {
+  unsigned int u = (unsigned int) hv * 2654435761u;
+  return (int) ((u ^ (u >> 16)) & (unsigned int) mask);
+}
+
+/* Rebuild the sparse index, compacting the entry array first if it has
+   accumulated a significant number of deleted entries.  Cached hash values
+   mean no key is ever re-hashed. */
+static void rebuild(Hash *h) {
+  int newsize, mask, i;
+
+  if (h->nentries > 2 * h->nitems) {
+    /* Compact out deleted entries, preserving insertion order */
+    int j = 0;
+    for (i = 0; i < h->nentries; i++) {
+      if (h->entries[i].key) {
+	if (j != i)
+	  h->entries[j] = h->entries[i];
+	j++;
+      }
+    }
+    h->nentries = j;
+  }
+
+  newsize = h->hashsize;
+  while (4 * h->nitems >= 3 * newsize)
+    newsize *= 2;
+
+  if (h->share->slots_embedded)
+    h->share->slots_embedded = 0;
+  else
+    DohFree(h->slots);
+  h->slots = hash_alloc_slots(newsize);
+  mask = newsize - 1;
+  for (i = 0; i < h->nentries; i++) {
+    if (h->entries[i].key) {
+      int hv = hash_index(h->entries[i].hashval, mask);
+      while (h->slots[hv] != SLOT_EMPTY)
+	hv = (hv + 1) & mask;
+      h->slots[hv] = i;
+    }
+  }
+  h->hashsize = newsize;
+  h->nused = h->nitems;
 }
 
 /* -----------------------------------------------------------------------------
@@ -109,19 +287,23 @@ static void DelNode(HashNode *hn) {
 
 static void DelHash(DOH *ho) {
   Hash *h = (Hash *) ObjData(ho);
-  HashNode *n, *next;
   int i;
 
-  for (i = 0; i < h->hashsize; i++) {
-    n = h->hashtable[i];
-    while (n) {
-      next = n->next;
-      DelNode(n);
-      n = next;
+  if (--h->share->count == 0) {
+    for (i = 0; i < h->nentries; i++) {
+      if (h->entries[i].key) {
+	Delete(h->entries[i].key);
+	Delete(h->entries[i].object);
+      }
     }
+    if (!h->share->entries_embedded)
+      DohFree(h->entries);
+    if (!h->share->slots_embedded)
+      DohFree(h->slots);
+    DohFree(h->share);
   }
-  DohFree(h->hashtable);
-  h->hashtable = 0;
+  h->entries = 0;
+  h->slots = 0;
   h->hashsize = 0;
   DohFree(h);
 }
@@ -134,64 +316,32 @@ static void DelHash(DOH *ho) {
 
 static void Hash_clear(DOH *ho) {
   Hash *h = (Hash *) ObjData(ho);
-  HashNode *n, *next;
   int i;
 
-  for (i = 0; i < h->hashsize; i++) {
-    n = h->hashtable[i];
-    while (n) {
-      next = n->next;
-      DelNode(n);
-      n = next;
-    }
-    h->hashtable[i] = 0;
-  }
-  h->nitems = 0;
-}
-
-/* resize the hash table */
-static void resize(Hash *h) {
-  HashNode *n, *next, **table;
-  int oldsize, newsize;
-  int i, p, hv;
-
-  if (h->nitems < 2 * h->hashsize)
+  if (h->share->count > 1) {
+    /* Shared: just detach with fresh empty arrays */
+    h->share->count--;
+    h->share = hash_new_share();
+    h->hashsize = HASH_INIT_SIZE;
+    h->slots = hash_alloc_slots(h->hashsize);
+    h->maxentries = HASH_INIT_SIZE;
+    h->entries = (HashEntry *) DohMalloc(h->maxentries * sizeof(HashEntry));
+    h->nentries = 0;
+    h->nitems = 0;
+    h->nused = 0;
     return;
-
-  /* Too big. We have to rescale everything now */
-  oldsize = h->hashsize;
-
-  /* Calculate a new size */
-  newsize = 2 * oldsize + 1;
-  p = 3;
-  while (p < (newsize >> 1)) {
-    if (((newsize / p) * p) == newsize) {
-      newsize += 2;
-      p = 3;
-      continue;
-    }
-    p = p + 2;
-  }
-
-  table = (HashNode **) DohMalloc(newsize * sizeof(HashNode *));
-  for (i = 0; i < newsize; i++) {
-    table[i] = 0;
   }
-
-  /* Walk down the old set of nodes and re-place */
-  h->hashsize = newsize;
-  for (i = 0; i < oldsize; i++) {
-    n = h->hashtable[i];
-    while (n) {
-      hv = Hashval(n->key) % newsize;
-      next = n->next;
-      n->next = table[hv];
-      table[hv] = n;
-      n = next;
+  for (i = 0; i < h->nentries; i++) {
+    if (h->entries[i].key) {
+      Delete(h->entries[i].key);
+      Delete(h->entries[i].object);
     }
   }
-  DohFree(h->hashtable);
-  h->hashtable = table;
+  for (i = 0; i < h->hashsize; i++)
+    h->slots[i] = SLOT_EMPTY;
+  h->nentries = 0;
+  h->nitems = 0;
+  h->nused = 0;
 }
 
 /* -----------------------------------------------------------------------------
@@ -202,8 +352,8 @@ static void resize(Hash *h) {
  * ----------------------------------------------------------------------------- */
 
 static int Hash_setattr(DOH *ho, DOH *k, DOH *obj) {
-  int hv;
-  HashNode *n, *prev;
+  int hv, mask, pos, avail = -1;
+  HashEntry *e;
   Hash *h = (Hash *) ObjData(ho);
 
   if (!obj) {
@@ -215,33 +365,62 @@ static int Hash_setattr(DOH *ho, DOH *k, DOH *obj) {
     obj = NewString((char *) obj);
     Decref(obj);
   }
-  hv = (Hashval(k)) % h->hashsize;
-  n = h->hashtable[hv];
-  prev = 0;
-  while (n) {
-    if (Cmp(n->key, k) == 0) {
-      /* Node already exists.  Just replace its contents */
-      if (n->object == obj) {
-	/* Whoa. Same object.  Do nothing */
-	return 1;
-      }
-      Delete(n->object);
-      n->object = obj;
-      Incref(obj);
-      return 1;			/* Return 1 to indicate a replacement */
+  hash_unshare(h);
+  if (4 * (h->nused + 1) >= 3 * h->hashsize)
+    rebuild(h);
+  mask = h->hashsize - 1;
+  hv = Hashval(k);
+  pos = hash_index(hv, mask);
+  for (;;) {
+    int idx = h->slots[pos];
+    if (idx == SLOT_EMPTY)
+      break;
+    if (idx == SLOT_DELETED) {
+      if (avail < 0)
+	avail = pos;
     } else {
-      prev = n;
-      n = n->next;
+      e = &h->entries[idx];
+      if ((e->hashval == hv) && key_equal(k, e->key)) {
+	/* Node already exists.  Just replace its contents */
+	if (e->object == obj) {
+	  /* Whoa. Same object.  Do nothing */
+	  return 1;
+	}
+	Delete(e->object);
+	e->object = obj;
+	Incref(obj);
+	return 1;		/* Return 1 to indicate a replacement */
+      }
     }
+    pos = (pos + 1) & mask;
   }
   /* Add this to the table */
-  n = NewNode(k, obj);
-  if (prev)
-    prev->next = n;
-  else
-    h->hashtable[hv] = n;
+  if (h->nentries == h->maxentries) {
+    h->maxentries *= 2;
+    if (h->share->entries_embedded) {
+      HashEntry *entries = (HashEntry *) DohMalloc(h->maxentries * sizeof(HashEntry));
+      memcpy(entries, h->entries, h->nentries * sizeof(HashEntry));
+      h->entries = entries;
+      h->share->entries_embedded = 0;
+    } else {
+      h->entries = (HashEntry *) DohRealloc(h->entries, h->maxentries * sizeof(HashEntry));
+      assert(h->entries);
+    }
+  }
+  e = &h->entries[h->nentries];
+  e->key = k;
+  Incref(k);
+  e->object = obj;
+  Incref(obj);
+  e->hashval = hv;
+  if (avail >= 0) {
+    pos = avail;
+  } else {
+    h->nused++;
+  }
+  h->slots[pos] = h->nentries;
+  h->nentries++;
   h->nitems++;
-  resize(h);
   return 0;
 }
 
@@ -250,32 +429,24 @@ static int Hash_setattr(DOH *ho, DOH *k, DOH *obj) {
  *
  * Get an attribute from the hash table. Returns 0 if it doesn't exist.
  * ----------------------------------------------------------------------------- */
-typedef int (*binop) (DOH *obj1, DOH *obj2);
-
 
 static DOH *Hash_getattr(DOH *h, DOH *k) {
-  DOH *obj = 0;
   Hash *ho = (Hash *) ObjData(h);
   DOH *ko = DohCheck(k) ? k : find_key(k);
-  int hv = Hashval(ko) % ho->hashsize;
-  DohObjInfo *k_type = ((DohBase*)ko)->type;
-  HashNode *n = ho->hashtable[hv];
-  if (k_type->doh_equal) {
-    binop equal = k_type->doh_equal;
-    while (n) {
-      DohBase *nk = (DohBase *)n->key;
-      if ((k_type == nk->type) && equal(ko, nk)) obj = n->object;
-      n = n->next;
-    }
-  } else {
-    binop cmp = k_type->doh_cmp;
-    while (n) {
-      DohBase *nk = (DohBase *)n->key;
-      if ((k_type == nk->type) && (cmp(ko, nk) == 0)) obj = n->object;
-      n = n->next;
+  int hv = Hashval(ko);
+  int mask = ho->hashsize - 1;
+  int pos = hash_index(hv, mask);
+  for (;;) {
+    int idx = ho->slots[pos];
+    if (idx == SLOT_EMPTY)
+      return 0;
+    if (idx != SLOT_DELETED) {
+      HashEntry *e = &ho->entries[idx];
+      if ((e->hashval == hv) && key_equal(ko, e->key))
+	return e->object;
     }
+    pos = (pos + 1) & mask;
   }
-  return obj;
 }
 
 /* -----------------------------------------------------------------------------
@@ -285,32 +456,35 @@ static DOH *Hash_getattr(DOH *h, DOH *k) {
  * ----------------------------------------------------------------------------- */
 
 static int Hash_delattr(DOH *ho, DOH *k) {
-  HashNode *n, *prev;
-  int hv;
+  int hv, mask, pos;
   Hash *h = (Hash *) ObjData(ho);
 
   if (!DohCheck(k))
     k = find_key(k);
-  hv = Hashval(k) % h->hashsize;
-  n = h->hashtable[hv];
-  prev = 0;
-  while (n) {
-    if (Cmp(n->key, k) == 0) {
-      /* Found it, kill it */
-
-      if (prev) {
-	prev->next = n->next;
-      } else {
-	h->hashtable[hv] = n->next;
+  hash_unshare(h);
+  hv = Hashval(k);
+  mask = h->hashsize - 1;
+  pos = hash_index(hv, mask);
+  for (;;) {
+    int idx = h->slots[pos];
+    if (idx == SLOT_EMPTY)
+      return 0;
+    if (idx != SLOT_DELETED) {
+      HashEntry *e = &h->entries[idx];
+      if ((e->hashval == hv) && key_equal(k, e->key)) {
+	/* Found it, kill it */
+	Delete(e->key);
+	Delete(e->object);
+	e->key = 0;
+	e->object = 0;
+	e->hashval = 0;
+	h->slots[pos] = SLOT_DELETED;
+	h->nitems--;
+	return 1;
       }
-      DelNode(n);
-      h->nitems--;
-      return 1;
     }
-    prev = n;
-    n = n->next;
+    pos = (pos + 1) & mask;
   }
-  return 0;
 }
 
 static DohIterator Hash_firstiter(DOH *ho) {
@@ -320,50 +494,43 @@ static DohIterator Hash_firstiter(DOH *ho) {
   iter._current = 0;
   iter.item = 0;
   iter.key = 0;
-  iter._index = 0;		/* Index in hash table */
-  while ((iter._index < h->hashsize) && !h->hashtable[iter._index])
+  iter._index = 0;		/* Next entry to examine */
+  while ((iter._index < h->nentries) && !h->entries[iter._index].key)
     iter._index++;
 
-  if (iter._index >= h->hashsize) {
+  if (iter._index >= h->nentries) {
     return iter;
   }
-  iter._current = h->hashtable[iter._index];
-  iter.item = ((HashNode *) iter._current)->object;
-  iter.key = ((HashNode *) iter._current)->key;
+  iter.item = h->entries[iter._index].object;
+  iter.key = h->entries[iter._index].key;
 
-  /* Actually save the next slot in the hash.  This makes it possible to
+  /* Actually save the next entry in the hash.  This makes it possible to
      delete the item being iterated over without trashing the universe */
-  iter._current = ((HashNode *) iter._current)->next;
+  iter._index++;
   return iter;
 }
 
 static DohIterator Hash_nextiter(DohIterator iter) {
   Hash *h = (Hash *) ObjData(iter.object);
-  if (!iter._current) {
+  while ((iter._index < h->nentries) && !h->entries[iter._index].key) {
     iter._index++;
-    while ((iter._index < h->hashsize) && !h->hashtable[iter._index]) {
-      iter._index++;
-    }
-    if (iter._index >= h->hashsize) {
-      iter.item = 0;
-      iter.key = 0;
-      iter._current = 0;
-      return iter;
-    }
-    iter._current = h->hashtable[iter._index];
   }
-  iter.key = ((HashNode *) iter._current)->key;
-  iter.item = ((HashNode *) iter._current)->object;
-
-  /* Store the next node to iterator on */
-  iter._current = ((HashNode *) iter._current)->next;
+  if (iter._index >= h->nentries) {
+    iter.item = 0;
+    iter.key = 0;
+    iter._current = 0;
+    return iter;
+  }
+  iter.key = h->entries[iter._index].key;
+  iter.item = h->entries[iter._index].object;
+  iter._index++;
   return iter;
 }
 
 /* -----------------------------------------------------------------------------
  * Hash_keys()
  *
- * Return a list of keys
+ * Return a list of keys in insertion order
  * ----------------------------------------------------------------------------- */
 
 static DOH *Hash_keys(DOH *so) {
@@ -377,6 +544,55 @@ static DOH *Hash_keys(DOH *so) {
   return keys;
 }
 
+/* -----------------------------------------------------------------------------
+ * DohSortedKeys()
+ *
+ * Return a list of keys sorted with cmp, or by default string order when
+ * cmp is NULL.  Convenience for emitters that need alphabetical rather
+ * than insertion-ordered output.
+ * ----------------------------------------------------------------------------- */
+
+DOH *DohSortedKeys(DOH *obj, int (*cmp) (const DOH *, const DOH *)) {
+  DOH *keys = DohKeys(obj);
+  DohSortList(keys, cmp);
+  return keys;
+}
+
+/* -----------------------------------------------------------------------------
+ * DohHashProbeStats()
+ *
+ * Fill histogram[0..histmax-1] with the probe-distance distribution of a
+ * hash table: histogram[d] counts live entries sitting d slots past their
+ * ideal position (everything >= histmax-1 lands in the last bucket).
+ * nitems/nslots report occupancy and index size.  Returns the maximum
+ * probe distance, or -1 if obj is not a hash.  Walks the slot array once;
+ * intended for -debug-stats reporting, not hot paths.
+ * ----------------------------------------------------------------------------- */
+
+int DohHashProbeStats(DOH *ho, int *nitems, int *nslots, int histogram[], int histmax) {
+  Hash *h;
+  int i, mask, maxprobe = 0;
+  if (!DohCheck(ho) || ((DohBase *) ho)->type != &DohHashType)
+    return -1;
+  h = (Hash *) ObjData(ho);
+  for (i = 0; i < histmax; i++)
+    histogram[i] = 0;
+  mask = h->hashsize - 1;
+  for (i = 0; i < h->hashsize; i++) {
+    int idx = h->slots[i];
+    int d;
+    if (idx < 0)
+      continue;
+    d = (i - hash_index(h->entries[idx].hashval, mask)) & mask;
+    if (d > maxprobe)
+      maxprobe = d;
+    histogram[d < histmax ? d : histmax - 1]++;
+  }
+  *nitems = h->nitems;
+  *nslots = h->hashsize;
+  return maxprobe;
+}
+
 /* -----------------------------------------------------------------------------
  * DohSetMaxHashExpand()
  *
@@ -405,7 +621,6 @@ int DohGetMaxHashExpand(void) {
 
 static DOH *Hash_str(DOH *ho) {
   int i, j;
-  HashNode *n;
   DOH *s;
   static int expanded = 0;
   static const char *tab = "  ";
@@ -419,27 +634,22 @@ static DOH *Hash_str(DOH *ho) {
   if (expanded >= max_expand) {
     /* replace each hash attribute with a '.' */
     Printf(s, "Hash(%p) {", ho);
-    for (i = 0; i < h->hashsize; i++) {
-      n = h->hashtable[i];
-      while (n) {
-	Putc('.', s);
-	n = n->next;
-      }
+    for (i = 0; i < h->nitems; i++) {
+      Putc('.', s);
     }
     Putc('}', s);
     return s;
   }
   ObjSetMark(ho, 1);
   Printf(s, "Hash(%p) {\n", ho);
-  for (i = 0; i < h->hashsize; i++) {
-    n = h->hashtable[i];
-    while (n) {
+  for (i = 0; i < h->nentries; i++) {
+    HashEntry *n = &h->entries[i];
+    if (n->key) {
       for (j = 0; j < expanded + 1; j++)
 	Printf(s, tab);
       expanded += 1;
       Printf(s, "'%s' : %s, \n", n->key, n->object);
       expanded -= 1;
-      n = n->next;
     }
   }
   for (j = 0; j < expanded; j++)
@@ -463,37 +673,21 @@ static int Hash_len(DOH *ho) {
 /* -----------------------------------------------------------------------------
  * CopyHash()
  *
- * Make a copy of a hash table.  Note: this is a shallow copy.
+ * Make a copy of a hash table.  Note: this is a shallow copy, made lazily:
+ * the new hash shares the slot and entry arrays until either sharer is
+ * mutated, at which point hash_unshare() clones them.
  * ----------------------------------------------------------------------------- */
 
 static DOH *CopyHash(DOH *ho) {
   Hash *h, *nh;
-  HashNode *n;
-  DOH *nho;
 
-  int i;
   h = (Hash *) ObjData(ho);
   nh = (Hash *) DohMalloc(sizeof(Hash));
-  nh->hashsize = h->hashsize;
-  nh->hashtable = (HashNode **) DohMalloc(nh->hashsize * sizeof(HashNode *));
-  for (i = 0; i < nh->hashsize; i++) {
-    nh->hashtable[i] = 0;
-  }
-  nh->nitems = 0;
-  nh->line = h->line;
-  nh->file = h->file;
+  *nh = *h;
+  nh->share->count++;
   if (nh->file)
     Incref(nh->file);
-
-  nho = DohObjMalloc(&DohHashType, nh);
-  for (i = 0; i < h->hashsize; i++) {
-    n = h->hashtable[i];
-    while (n) {
-      Hash_setattr(nho, n->key, n->object);
-      n = n->next;
-    }
-  }
-  return nho;
+  return DohObjMalloc(&DohHashType, nh);
 }
 
 
@@ -571,16 +765,16 @@ DohObjInfo DohHashType = {
  * ----------------------------------------------------------------------------- */
 
 DOH *DohNewHash(void) {
-  Hash *h;
-  int i;
-  h = (Hash *) DohMalloc(sizeof(Hash));
-  h->hashsize = HASH_INIT_SIZE;
-  h->hashtable = (HashNode **) DohMalloc(h->hashsize * sizeof(HashNode *));
-  for (i = 0; i < h->hashsize; i++) {
-    h->hashtable[i] = 0;
-  }
-  h->nitems = 0;
-  h->file = 0;
-  h->line = 0;
-  return DohObjMalloc(&DohHashType, h);
+  return DohObjMalloc(&DohHashType, hash_create(0));
+}
+
+/* -----------------------------------------------------------------------------
+ * NewHashSized()
+ *
+ * Create a hash table pre-sized for about nitems entries, so the typical
+ * attribute load fits without any resize of the slot or entry arrays.
+ * ----------------------------------------------------------------------------- */
+
+DOH *DohNewHashSized(int nitems) {
+  return DohObjMalloc(&DohHashType, hash_create(nitems));
 }
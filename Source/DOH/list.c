@@ -13,45 +13,100 @@
 
 #include "dohint.h"
 
+/* Inline item array for short lists.  Most lists created during wrapper
+   generation - parameter lists, base-class lists, Keys() results - hold a
+   handful of items, so keeping the first few slots inside the List record
+   avoids a second allocation for them.  An inline list is never shared:
+   CopyList copies it eagerly (it is at most LIST_MAXINLINE pointers), so
+   the share count only goes on the heap once the item array does. */
+#define LIST_MAXINLINE 4
+
 typedef struct List {
   int maxitems;			/* Max size  */
   int nitems;			/* Num items */
   DOH *file;
   int line;
   DOH **items;
+  int *share;			/* Number of List objects sharing items (copy-on-write) */
+  int inline_share;		/* Initial share count (share == &inline_share) */
+  DOH *inline_items[LIST_MAXINLINE];	/* Inline data for short lists (items == inline_items) */
 } List;
 
 extern DohObjInfo DohListType;
 
-/* Doubles amount of memory in a list */
+static int *list_new_share(void) {
+  int *share = (int *) DohMalloc(sizeof(int));
+  *share = 1;
+  return share;
+}
+
+/* Break copy-on-write sharing before a mutation.  Clones the item array
+   and takes a reference on every item; the remaining sharers keep the
+   original. */
+static void list_unshare(List *l) {
+  int i;
+  DOH **items;
+
+  if (*l->share == 1)
+    return;
+  items = (DOH **) DohMalloc(l->maxitems * sizeof(void *));
+  memcpy(items, l->items, l->nitems * sizeof(void *));
+  for (i = 0; i < l->nitems; i++)
+    Incref(items[i]);
+  (*l->share)--;
+  l->items = items;
+  l->share = list_new_share();
+}
+
+/* Doubles amount of memory in a list, moving the items out of the inline
+   buffer on first growth */
 static
 void more(List *l) {
-  l->items = (void **) DohRealloc(l->items, l->maxitems * 2 * sizeof(void *));
-  assert(l->items);
+  if (l->items == l->inline_items) {
+    DOH **items = (DOH **) DohMalloc(l->maxitems * 2 * sizeof(void *));
+    assert(items);
+    memcpy(items, l->inline_items, l->nitems * sizeof(void *));
+    l->items = items;
+  } else {
+    l->items = (void **) DohRealloc(l->items, l->maxitems * 2 * sizeof(void *));
+    assert(l->items);
+  }
   l->maxitems *= 2;
 }
 
 /* -----------------------------------------------------------------------------
  * CopyList()
  *
- * Make a shallow copy of a list.
+ * Make a shallow copy of a list, made lazily: the new list shares the item
+ * array until either sharer is mutated, at which point list_unshare()
+ * clones it.
  * ----------------------------------------------------------------------------- */
 static DOH *CopyList(DOH *lo) {
   List *l, *nl;
-  int i;
   l = (List *) ObjData(lo);
   nl = (List *) DohMalloc(sizeof(List));
-  nl->nitems = l->nitems;
-  nl->maxitems = l->maxitems;
-  nl->items = (void **) DohMalloc(l->maxitems * sizeof(void *));
-  for (i = 0; i < l->nitems; i++) {
-    nl->items[i] = l->items[i];
-    Incref(nl->items[i]);
+  *nl = *l;
+  if (l->items == l->inline_items) {
+    /* Inline lists are copied eagerly; the struct copy already moved the
+       item pointers into the new inline buffer */
+    int i;
+    nl->items = nl->inline_items;
+    nl->share = &nl->inline_share;
+    nl->inline_share = 1;
+    for (i = 0; i < nl->nitems; i++)
+      Incref(nl->items[i]);
+  } else {
+    /* Promote the share count to the heap the first time a heap array is
+       shared, so it can outlive either sharer */
+    if (l->share == &l->inline_share) {
+      l->share = list_new_share();
+      *l->share = l->inline_share;
+    }
+    nl->share = l->share;
+    (*nl->share)++;
   }
-  nl->file = l->file;
   if (nl->file)
     Incref(nl->file);
-  nl->line = l->line;
   return DohObjMalloc(&DohListType, nl);
 }
 
@@ -64,9 +119,14 @@ static DOH *CopyList(DOH *lo) {
 static void DelList(DOH *lo) {
   List *l = (List *) ObjData(lo);
   int i;
-  for (i = 0; i < l->nitems; i++)
-    Delete(l->items[i]);
-  DohFree(l->items);
+  if (--(*l->share) == 0) {
+    for (i = 0; i < l->nitems; i++)
+      Delete(l->items[i]);
+    if (l->items != l->inline_items)
+      DohFree(l->items);
+    if (l->share != &l->inline_share)
+      DohFree(l->share);
+  }
   DohFree(l);
 }
 
@@ -79,6 +139,16 @@ static void DelList(DOH *lo) {
 static void List_clear(DOH *lo) {
   List *l = (List *) ObjData(lo);
   int i;
+  if (*l->share > 1) {
+    /* Shared: just detach back to the inline buffer */
+    (*l->share)--;
+    l->share = &l->inline_share;
+    l->inline_share = 1;
+    l->maxitems = LIST_MAXINLINE;
+    l->items = l->inline_items;
+    l->nitems = 0;
+    return;
+  }
   for (i = 0; i < l->nitems; i++) {
     Delete(l->items[i]);
   }
@@ -108,6 +178,7 @@ static int List_insert(DOH *lo, int pos, DOH *item) {
     pos = 0;
   if (pos > l->nitems)
     pos = l->nitems;
+  list_unshare(l);
   if (l->nitems == l->maxitems)
     more(l);
   for (i = l->nitems; i > pos; i--) {
@@ -133,6 +204,7 @@ static int List_remove(DOH *lo, int pos) {
   if (pos == DOH_BEGIN)
     pos = 0;
   assert(!((pos < 0) || (pos >= l->nitems)));
+  list_unshare(l);
   Delete(l->items[pos]);
   for (i = pos; i < l->nitems - 1; i++) {
     l->items[i] = l->items[i + 1];
@@ -183,6 +255,7 @@ static int List_set(DOH *lo, int n, DOH *val) {
     val = NewString(val);
     Decref(val);
   }
+  list_unshare(l);
   Delete(l->items[n]);
   l->items[n] = val;
   Incref(val);
@@ -343,18 +416,18 @@ DohObjInfo DohListType = {
  * Create a new list.
  * ----------------------------------------------------------------------------- */
 
-#define MAXLISTITEMS 8
-
 DOH *DohNewList(void) {
   List *l;
   int i;
   l = (List *) DohMalloc(sizeof(List));
   l->nitems = 0;
-  l->maxitems = MAXLISTITEMS;
-  l->items = (void **) DohMalloc(l->maxitems * sizeof(void *));
-  for (i = 0; i < MAXLISTITEMS; i++) {
+  l->maxitems = LIST_MAXINLINE;
+  l->items = l->inline_items;
+  for (i = 0; i < LIST_MAXINLINE; i++) {
     l->items[i] = 0;
   }
+  l->share = &l->inline_share;
+  l->inline_share = 1;
   l->file = 0;
   l->line = 0;
   return DohObjMalloc(&DohListType, l);
@@ -368,6 +441,7 @@ static int List_qsort_compare(const void *a, const void *b) {
 /* Sort a list */
 void DohSortList(DOH *lo, int (*cmp) (const DOH *, const DOH *)) {
   List *l = (List *) ObjData(lo);
+  list_unshare(l);
   if (cmp) {
     List_sort_compare_func = cmp;
   } else {
@@ -34,12 +34,30 @@ typedef struct pool {
   int current;			/* Current position for next allocation */
   char *pbeg;			/* Beg of pool */
   char *pend;			/* End of pool */
+  int arena;			/* Arena depth at which this pool was created */
   struct pool *next;		/* Next pool */
 } Pool;
 
-static DohBase *FreeList = 0;	/* List of free objects */
+#ifndef DOH_MAX_ARENA_DEPTH
+#define DOH_MAX_ARENA_DEPTH 16
+#endif
+
+/* With DOH_THREADSAFE the allocator state below is thread-local: each thread
+   allocates from its own pool and recycles into its own freelist, so no lock
+   is needed on the allocation fast path.  The global pool list (needed by
+   DohCheck) is only ever prepended to, atomically.  Freeing an object on a
+   different thread than the one that allocated it is fine - it simply joins
+   the freeing thread's freelist.  Arenas and deferred-delete scopes are
+   per-thread; pushing an arena while other threads allocate is not
+   supported. */
+
+static DOH_THREAD_LOCAL DohBase *FreeList = 0;	/* List of free objects */
+static DOH_THREAD_LOCAL Pool *AllocPool = 0;	/* Pool served by this thread */
 static Pool *Pools = 0;
 static int pools_initialized = 0;
+static DOH_THREAD_LOCAL int arena_depth = 0;	/* Current arena nesting level. 0 = global pool */
+static DOH_THREAD_LOCAL DohBase *arena_saved_freelist[DOH_MAX_ARENA_DEPTH];
+static DOH_THREAD_LOCAL Pool *arena_saved_allocpool[DOH_MAX_ARENA_DEPTH];
 
 /* ----------------------------------------------------------------------
  * CreatePool() - Create a new memory pool 
@@ -57,8 +75,16 @@ static void CreatePool() {
   p->current = 0;
   p->pbeg = ((char *) p->ptr);
   p->pend = p->pbeg + p->blen;
+  p->arena = arena_depth;
+#ifdef DOH_THREADSAFE
+  do {
+    p->next = __atomic_load_n(&Pools, __ATOMIC_RELAXED);
+  } while (!__atomic_compare_exchange_n(&Pools, &p->next, p, 0, __ATOMIC_RELEASE, __ATOMIC_RELAXED));
+#else
   p->next = Pools;
   Pools = p;
+#endif
+  AllocPool = p;
 }
 
 /* ----------------------------------------------------------------------
@@ -81,7 +107,11 @@ static void InitPools() {
  * ---------------------------------------------------------------------- */
 
 int DohCheck(const DOH *ptr) {
+#ifdef DOH_THREADSAFE
+  Pool *p = __atomic_load_n(&Pools, __ATOMIC_ACQUIRE);
+#else
   Pool *p = Pools;
+#endif
   char *cptr = (char *) ptr;
   while (p) {
     if ((cptr >= p->pbeg) && (cptr < p->pend)) {
@@ -109,6 +139,85 @@ void DohIntern(DOH *obj) {
   b->flag_intern = 1;
 }
 
+/* ----------------------------------------------------------------------
+ * Object accounting (-debug-memory)
+ *
+ * Opt-in instrumentation that keeps per-type object counts so that the
+ * memory consumption of each processing phase can be reported without an
+ * external heap profiler.  SWIG_main marks the phase boundaries with
+ * DohMemoryPhase(); each mark reports the allocations, peak and live
+ * object counts of the phase just ended.  All of this is dormant unless
+ * enabled with DohMemoryAccounting().
+ * ---------------------------------------------------------------------- */
+
+#define ACCT_MAX_TYPES 16
+
+typedef struct AcctType {
+  DohObjInfo *type;
+  int live;			/* Objects currently alive */
+  int peak;			/* Peak live count during the current phase */
+  int allocs;			/* Allocations during the current phase */
+} AcctType;
+
+static AcctType acct_types[ACCT_MAX_TYPES];
+static int acct_ntypes = 0;
+static int acct_enabled = 0;
+static const char *acct_phase = 0;
+
+static AcctType *acct_find(DohObjInfo *type) {
+  int i;
+  for (i = 0; i < acct_ntypes; i++) {
+    if (acct_types[i].type == type)
+      return &acct_types[i];
+  }
+  if (acct_ntypes == ACCT_MAX_TYPES)
+    return 0;
+  acct_types[acct_ntypes].type = type;
+  acct_types[acct_ntypes].live = 0;
+  acct_types[acct_ntypes].peak = 0;
+  acct_types[acct_ntypes].allocs = 0;
+  return &acct_types[acct_ntypes++];
+}
+
+static void acct_alloc(DohObjInfo *type) {
+  AcctType *a = acct_find(type);
+  if (a) {
+    a->live++;
+    a->allocs++;
+    if (a->live > a->peak)
+      a->peak = a->live;
+  }
+}
+
+static void acct_free(DohObjInfo *type) {
+  AcctType *a = type ? acct_find(type) : 0;
+  if (a)
+    a->live--;
+}
+
+void DohMemoryAccounting(int on) {
+  acct_enabled = on;
+}
+
+void DohMemoryPhase(const char *phase) {
+  int i;
+  if (!acct_enabled)
+    return;
+  if (acct_phase) {
+    printf("Memory phase '%s':\n", acct_phase);
+    printf("    %-16s %10s %10s %10s\n", "Type", "allocs", "peak", "live");
+    for (i = 0; i < acct_ntypes; i++) {
+      AcctType *a = &acct_types[i];
+      printf("    %-16s %10d %10d %10d\n", a->type->objname, a->allocs, a->peak, a->live);
+    }
+  }
+  acct_phase = phase;
+  for (i = 0; i < acct_ntypes; i++) {
+    acct_types[i].allocs = 0;
+    acct_types[i].peak = acct_types[i].live;
+  }
+}
+
 /* ----------------------------------------------------------------------
  * DohObjMalloc()
  *
@@ -125,14 +234,16 @@ DOH *DohObjMalloc(DohObjInfo *type, void *data) {
     FreeList = (DohBase *) obj->data;
   } else {
 #endif
-    while (Pools->current == Pools->len) {
+    while (!AllocPool || AllocPool->current == AllocPool->len) {
       CreatePool();
     }
-    obj = Pools->ptr + Pools->current;
-    ++Pools->current;
+    obj = AllocPool->ptr + AllocPool->current;
+    ++AllocPool->current;
 #ifndef DOH_DEBUG_MEMORY_POOLS
   }
 #endif
+  if (acct_enabled)
+    acct_alloc(type);
   obj->type = type;
   obj->data = data;
   obj->meta = 0;
@@ -153,6 +264,8 @@ void DohObjFree(DOH *ptr) {
   b = (DohBase *) ptr;
   if (b->flag_intern)
     return;
+  if (acct_enabled)
+    acct_free(b->type);
   meta = (DohBase *) b->meta;
   b->data = (void *) FreeList;
   b->meta = 0;
@@ -164,6 +277,175 @@ void DohObjFree(DOH *ptr) {
   }
 }
 
+/* ----------------------------------------------------------------------
+ * DohPushArena()
+ *
+ * Open a new allocation arena.  All objects created between this call and
+ * the matching DohPopArena() are placed in dedicated pools that are handed
+ * back to the system when the arena is popped.  This is intended for
+ * phases such as template expansion or typemap matching that create large
+ * numbers of transient objects; results that must outlive the arena have
+ * to be copied out before popping.  Objects must not be interned while an
+ * arena is active.
+ * ---------------------------------------------------------------------- */
+
+void DohPushArena(void) {
+  if (!pools_initialized)
+    InitPools();
+  assert(arena_depth < DOH_MAX_ARENA_DEPTH);
+  arena_saved_freelist[arena_depth] = FreeList;
+  arena_saved_allocpool[arena_depth] = AllocPool;
+  FreeList = 0;
+  arena_depth++;
+  CreatePool();
+}
+
+/* ----------------------------------------------------------------------
+ * DohPopArena()
+ *
+ * Close the innermost arena.  Any object allocated in it that is still
+ * alive has its destructor run and its storage, along with the arena's
+ * pools, is released in bulk.
+ * ---------------------------------------------------------------------- */
+
+void DohPopArena(void) {
+  Pool *p;
+  int i;
+  assert(arena_depth > 0);
+
+  /* Mark every object still alive in the arena as interned so that the
+     destructor pass below cannot delete one survivor from inside another's
+     destructor. */
+  for (p = Pools; p && (p->arena == arena_depth); p = p->next) {
+    for (i = 0; i < p->current; i++) {
+      DohBase *b = p->ptr + i;
+      if (b->type && (b->refcount > 0))
+	b->flag_intern = 1;
+    }
+  }
+
+  /* Run destructors on the survivors.  References held by a survivor either
+     point back into the arena (where the target is now interned, making any
+     recursive Delete a no-op) or outside of it (where the normal refcount
+     machinery applies). */
+  for (p = Pools; p && (p->arena == arena_depth); p = p->next) {
+    for (i = 0; i < p->current; i++) {
+      DohBase *b = p->ptr + i;
+      if (b->type && (b->refcount > 0)) {
+	if (b->type->doh_del) {
+	  (b->type->doh_del) (b);
+	} else if (b->data) {
+	  DohFree(b->data);
+	}
+	if (b->meta)
+	  Delete(b->meta);
+	if (acct_enabled)
+	  acct_free(b->type);
+	b->type = 0;
+      }
+    }
+  }
+
+  /* Restore the freelist saved at DohPushArena(), keeping entries for any
+     outer-pool objects freed during the arena epoch but dropping entries
+     that point into the pools about to be released. */
+  {
+    DohBase *b = FreeList;
+    FreeList = arena_saved_freelist[arena_depth - 1];
+    while (b) {
+      DohBase *next = (DohBase *) b->data;
+      int in_arena = 0;
+      for (p = Pools; p && (p->arena == arena_depth); p = p->next) {
+	if ((((char *) b) >= p->pbeg) && (((char *) b) < p->pend)) {
+	  in_arena = 1;
+	  break;
+	}
+      }
+      if (!in_arena) {
+	b->data = (void *) FreeList;
+	FreeList = b;
+      }
+      b = next;
+    }
+  }
+
+  /* Finally hand the arena pools back to the system */
+  while (Pools && (Pools->arena == arena_depth)) {
+    p = Pools;
+    Pools = p->next;
+    DohFree(p->ptr);
+    DohFree(p);
+  }
+  arena_depth--;
+  AllocPool = arena_saved_allocpool[arena_depth];
+}
+
+/* ----------------------------------------------------------------------
+ * DohPushDeferredDelete()
+ * DohPopDeferredDelete()
+ *
+ * Scoped deferred reclamation.  While a scope is open, objects whose
+ * reference count drops to zero are queued instead of being destroyed on
+ * the spot; the queue is drained when the scope is popped.  An object that
+ * has been queued but picks up a new reference before the pop has escaped
+ * the scope and is left alone.  This batches the destructor cascades that
+ * the per-node wrapper generation loops otherwise trigger after every
+ * temporary, at the cost of holding dead objects slightly longer.  Scopes
+ * nest; each pop drains only the deletions queued since its push.
+ * ---------------------------------------------------------------------- */
+
+static DOH_THREAD_LOCAL DohBase **deferred_objects = 0;
+static DOH_THREAD_LOCAL int ndeferred = 0;
+static DOH_THREAD_LOCAL int maxdeferred = 0;
+static DOH_THREAD_LOCAL int *defer_marks = 0;
+static DOH_THREAD_LOCAL int maxdefer_marks = 0;
+static DOH_THREAD_LOCAL int defer_depth = 0;
+
+/* Called by DohDelete() when a refcount hits zero.  Returns 1 if the
+   object was queued for later reclamation. */
+int DohDeferDelete(DOH *obj) {
+  if (!defer_depth)
+    return 0;
+  if (ndeferred == maxdeferred) {
+    maxdeferred = maxdeferred ? 2 * maxdeferred : 256;
+    deferred_objects = (DohBase **) DohRealloc(deferred_objects, maxdeferred * sizeof(DohBase *));
+    assert(deferred_objects);
+  }
+  deferred_objects[ndeferred++] = (DohBase *) obj;
+  return 1;
+}
+
+void DohPushDeferredDelete(void) {
+  if (defer_depth == maxdefer_marks) {
+    maxdefer_marks = maxdefer_marks ? 2 * maxdefer_marks : 64;
+    defer_marks = (int *) DohRealloc(defer_marks, maxdefer_marks * sizeof(int));
+    assert(defer_marks);
+  }
+  defer_marks[defer_depth++] = ndeferred;
+}
+
+void DohPopDeferredDelete(void) {
+  int i, base;
+  assert(defer_depth > 0);
+  base = defer_marks[--defer_depth];
+  /* Destructors run here may queue further deletions onto the end of this
+     range when an outer scope is still active; the live bound on the loop
+     drains those as well.  An object can be queued twice if it is rescued
+     and dropped again, so skip anything already destroyed. */
+  for (i = base; i < ndeferred; i++) {
+    DohBase *b = deferred_objects[i];
+    if (b->type && (b->refcount <= 0)) {
+      if (b->type->doh_del) {
+	(b->type->doh_del) (b);
+      } else if (b->data) {
+	DohFree(b->data);
+      }
+      DohObjFree(b);
+    }
+  }
+  ndeferred = base;
+}
+
 /* ----------------------------------------------------------------------
  * DohMemoryDebug()
  *
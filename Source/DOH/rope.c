@@ -0,0 +1,320 @@
+/* -----------------------------------------------------------------------------
+ * This file is part of SWIG, which is licensed as a whole under version 3
+ * (or any later version) of the GNU General Public License. Some additional
+ * terms also apply to certain portions of SWIG. The full details of the SWIG
+ * license and copyrights can be found in the LICENSE and COPYRIGHT files
+ * included with the SWIG source code as distributed by the SWIG developers
+ * and at http://www.swig.org/legal.html.
+ *
+ * rope.c
+ *
+ *     Implements an append-only string object stored as a chain of fixed
+ *     size chunks.  Appending never copies previously written data, which
+ *     makes it suitable for the large code sections (f_wrappers and
+ *     friends) that the language modules build up with many thousands of
+ *     Printv/Append calls and then dump to the output file exactly once.
+ *     Operations that need a contiguous view (Data/Char) coalesce the
+ *     chunks first.
+ * ----------------------------------------------------------------------------- */
+
+#include "dohint.h"
+
+extern DohObjInfo DohRopeType;
+
+#ifndef DOH_ROPE_CHUNK_SIZE
+#define DOH_ROPE_CHUNK_SIZE 32768
+#endif
+
+typedef struct RopeChunk {
+  char *data;			/* Chunk data */
+  int len;			/* Bytes used */
+  int maxsize;			/* Bytes allocated */
+  struct RopeChunk *next;	/* Next chunk */
+} RopeChunk;
+
+typedef struct Rope {
+  DOH *file;
+  int line;
+  int len;			/* Total length */
+  RopeChunk *head;		/* First chunk */
+  RopeChunk *tail;		/* Chunk receiving appends */
+} Rope;
+
+/* -----------------------------------------------------------------------------
+ * NewChunk() - Allocate a chunk with room for at least len bytes
+ * ----------------------------------------------------------------------------- */
+
+static RopeChunk *NewChunk(int len) {
+  RopeChunk *c = (RopeChunk *) DohMalloc(sizeof(RopeChunk));
+  c->maxsize = (len > DOH_ROPE_CHUNK_SIZE) ? len : DOH_ROPE_CHUNK_SIZE;
+  c->data = (char *) DohMalloc(c->maxsize);
+  c->len = 0;
+  c->next = 0;
+  return c;
+}
+
+/* -----------------------------------------------------------------------------
+ * Rope_write() - Append bytes to the rope
+ * ----------------------------------------------------------------------------- */
+
+static int Rope_write(DOH *so, const void *buffer, int len) {
+  Rope *r = (Rope *) ObjData(so);
+  const char *s = (const char *) buffer;
+  int nwritten = len;
+  if (len <= 0)
+    return 0;
+  if (!r->tail) {
+    r->head = r->tail = NewChunk(len);
+  }
+  while (len > 0) {
+    RopeChunk *t = r->tail;
+    int room = t->maxsize - t->len;
+    if (room == 0) {
+      t->next = NewChunk(len);
+      r->tail = t->next;
+      continue;
+    }
+    if (room > len)
+      room = len;
+    memcpy(t->data + t->len, s, room);
+    t->len += room;
+    s += room;
+    len -= room;
+  }
+  r->len += nwritten;
+  return nwritten;
+}
+
+/* -----------------------------------------------------------------------------
+ * Rope_putc() - Append a single character
+ * ----------------------------------------------------------------------------- */
+
+static int Rope_putc(DOH *so, int ch) {
+  char c = (char) ch;
+  Rope_write(so, &c, 1);
+  return ch;
+}
+
+/* -----------------------------------------------------------------------------
+ * Rope_dump() - Serialize the rope onto out, one chunk at a time
+ * ----------------------------------------------------------------------------- */
+
+static int Rope_dump(DOH *so, DOH *out) {
+  Rope *r = (Rope *) ObjData(so);
+  RopeChunk *c;
+  int nsent = 0;
+  for (c = r->head; c; c = c->next) {
+    int off = 0;
+    while (off < c->len) {
+      int ret = Write(out, c->data + off, c->len - off);
+      if (ret < 0)
+	return ret;
+      off += ret;
+    }
+    nsent += c->len;
+  }
+  return nsent;
+}
+
+/* -----------------------------------------------------------------------------
+ * Rope_flatten() - Coalesce all chunks into a single chunk
+ * ----------------------------------------------------------------------------- */
+
+static RopeChunk *Rope_flatten(Rope *r) {
+  RopeChunk *c, *n, *flat;
+  char *t;
+  flat = NewChunk(r->len + 1);
+  t = flat->data;
+  for (c = r->head; c; c = n) {
+    n = c->next;
+    memcpy(t, c->data, c->len);
+    t += c->len;
+    DohFree(c->data);
+    DohFree(c);
+  }
+  flat->len = r->len;
+  flat->data[flat->len] = 0;
+  r->head = r->tail = flat;
+  return flat;
+}
+
+/* -----------------------------------------------------------------------------
+ * Rope_data() - Return contiguous data, coalescing chunks if needed
+ * ----------------------------------------------------------------------------- */
+
+static void *Rope_data(DOH *so) {
+  Rope *r = (Rope *) ObjData(so);
+  RopeChunk *c = r->head;
+  if (!c || c->next || (c->len >= c->maxsize))
+    c = Rope_flatten(r);
+  c->data[c->len] = 0;
+  return (void *) c->data;
+}
+
+/* -----------------------------------------------------------------------------
+ * Rope_str() - Return the rope contents as a new String
+ * ----------------------------------------------------------------------------- */
+
+static DOH *Rope_str(DOH *so) {
+  Rope *r = (Rope *) ObjData(so);
+  RopeChunk *c;
+  DOH *s = NewStringEmpty();
+  for (c = r->head; c; c = c->next) {
+    Write(s, c->data, c->len);
+  }
+  return s;
+}
+
+/* -----------------------------------------------------------------------------
+ * Rope_len() - Total length
+ * ----------------------------------------------------------------------------- */
+
+static int Rope_len(DOH *so) {
+  Rope *r = (Rope *) ObjData(so);
+  return r->len;
+}
+
+/* -----------------------------------------------------------------------------
+ * Rope_clear() - Discard all data
+ * ----------------------------------------------------------------------------- */
+
+static void Rope_clear(DOH *so) {
+  Rope *r = (Rope *) ObjData(so);
+  RopeChunk *c, *n;
+  for (c = r->head; c; c = n) {
+    n = c->next;
+    DohFree(c->data);
+    DohFree(c);
+  }
+  r->head = r->tail = 0;
+  r->len = 0;
+}
+
+/* -----------------------------------------------------------------------------
+ * DelRope() - Delete a rope
+ * ----------------------------------------------------------------------------- */
+
+static void DelRope(DOH *so) {
+  Rope *r = (Rope *) ObjData(so);
+  Rope_clear(so);
+  if (r->file)
+    Delete(r->file);
+  DohFree(r);
+}
+
+/* -----------------------------------------------------------------------------
+ * CopyRope() - Copy a rope
+ * ----------------------------------------------------------------------------- */
+
+static DOH *CopyRope(DOH *so) {
+  Rope *r = (Rope *) ObjData(so);
+  RopeChunk *c;
+  DOH *nr = DohNewRope();
+  for (c = r->head; c; c = c->next) {
+    Rope_write(nr, c->data, c->len);
+  }
+  Setfile(nr, r->file);
+  Setline(nr, r->line);
+  return nr;
+}
+
+/* -----------------------------------------------------------------------------
+ * Rope_insert() - Sequence insert.  Only appending at DOH_END is supported
+ * ----------------------------------------------------------------------------- */
+
+static int Rope_insert(DOH *so, int pos, DOH *value) {
+  Rope *r = (Rope *) ObjData(so);
+  assert((pos == DOH_END) || (pos == r->len));
+  (void) r;
+  if (DohCheck(value)) {
+    return (Dump(value, so) >= 0) ? 0 : -1;
+  } else {
+    char *s = (char *) value;
+    Rope_write(so, s, (int) strlen(s));
+    return 0;
+  }
+}
+
+/* -----------------------------------------------------------------------------
+ * Positional methods
+ * ----------------------------------------------------------------------------- */
+
+static void Rope_setfile(DOH *so, DOH *file) {
+  Rope *r = (Rope *) ObjData(so);
+  Incref(file);
+  Delete(r->file);
+  r->file = file;
+}
+
+static DOH *Rope_getfile(DOH *so) {
+  Rope *r = (Rope *) ObjData(so);
+  return r->file;
+}
+
+static void Rope_setline(DOH *so, int line) {
+  Rope *r = (Rope *) ObjData(so);
+  r->line = line;
+}
+
+static int Rope_getline(DOH *so) {
+  Rope *r = (Rope *) ObjData(so);
+  return r->line;
+}
+
+static DohListMethods RopeListMethods = {
+  0,				/* doh_getitem */
+  0,				/* doh_setitem */
+  0,				/* doh_delitem */
+  Rope_insert,			/* doh_insitem */
+  0,				/* doh_delslice */
+};
+
+static DohFileMethods RopeFileMethods = {
+  0,				/* doh_read */
+  Rope_write,			/* doh_write */
+  Rope_putc,			/* doh_putc */
+  0,				/* doh_getc */
+  0,				/* doh_ungetc */
+  0,				/* doh_seek */
+  0,				/* doh_tell */
+};
+
+DohObjInfo DohRopeType = {
+  "Rope",			/* objname */
+  DelRope,			/* doh_del */
+  CopyRope,			/* doh_copy */
+  Rope_clear,			/* doh_clear */
+  Rope_str,			/* doh_str */
+  Rope_data,			/* doh_data */
+  Rope_dump,			/* doh_dump */
+  Rope_len,			/* doh_len */
+  0,				/* doh_hashval */
+  0,				/* doh_cmp */
+  0,				/* doh_equal    */
+  0,				/* doh_first    */
+  0,				/* doh_next     */
+  Rope_setfile,			/* doh_setfile */
+  Rope_getfile,			/* doh_getfile */
+  Rope_setline,			/* doh_setline */
+  Rope_getline,			/* doh_getline */
+  0,				/* doh_mapping */
+  &RopeListMethods,		/* doh_sequence */
+  &RopeFileMethods,		/* doh_file  */
+  0,				/* doh_string */
+  0,				/* doh_reserved */
+  0,				/* clientdata */
+};
+
+/* -----------------------------------------------------------------------------
+ * NewRope() - Create a new, empty rope
+ * ----------------------------------------------------------------------------- */
+
+DOH *DohNewRope(void) {
+  Rope *r = (Rope *) DohMalloc(sizeof(Rope));
+  r->file = 0;
+  r->line = 1;
+  r->len = 0;
+  r->head = 0;
+  r->tail = 0;
+  return DohObjMalloc(&DohRopeType, r);
+}
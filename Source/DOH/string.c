@@ -16,6 +16,12 @@
 
 extern DohObjInfo DohStringType;
 
+/* Inline buffer for short strings.  Most strings created during wrapper
+   generation are identifiers and type fragments well under this size, so
+   keeping the characters inside the String record avoids a second
+   allocation for them. */
+#define SSO_MAXSIZE 24
+
 typedef struct String {
   DOH *file;
   int line;
@@ -24,8 +30,109 @@ typedef struct String {
   int hashkey;			/* Hash key value     */
   int sp;			/* Current position   */
   char *str;			/* String data        */
+  char sso[SSO_MAXSIZE];	/* Inline data for short strings (str == sso) */
 } String;
 
+/* -----------------------------------------------------------------------------
+ * String_resize() - Grow the character buffer to at least newmaxsize bytes,
+ * moving the data out of the inline buffer on first growth.
+ * ----------------------------------------------------------------------------- */
+
+static void String_resize(String *s, int newmaxsize) {
+  if (s->str == s->sso) {
+    char *nstr = (char *) DohMalloc(newmaxsize);
+    assert(nstr);
+    memcpy(nstr, s->sso, s->len + 1);
+    s->str = nstr;
+  } else {
+    s->str = (char *) DohRealloc(s->str, newmaxsize);
+    assert(s->str);
+  }
+  s->maxsize = newmaxsize;
+}
+
+/* -----------------------------------------------------------------------------
+ * Line-break index
+ *
+ * Seeking a string maintains its line number by counting the newlines in
+ * the seeked-over range, which makes rewinding a large file buffer O(file
+ * size) every time.  For the few big strings that are scanned with long
+ * seeks (preprocessed file buffers, mostly) we lazily build a sorted array
+ * of newline offsets so the line adjustment becomes two binary searches.
+ * The index lives in a small side cache rather than in the String record
+ * itself - most strings are short identifiers that never seek and should
+ * not pay for two extra pointers.  Every mutating operation invalidates
+ * the string's cache entry, so a hit is always current.
+ * ----------------------------------------------------------------------------- */
+
+#define LINDEX_CACHE_SIZE 4
+#define LINDEX_MIN_SCAN   4096	/* Shorter seeks just use memchr */
+
+typedef struct LineIndex {
+  String *owner;		/* String record this index describes */
+  int *breaks;			/* Sorted offsets of '\n' characters  */
+  int nbreaks;
+} LineIndex;
+
+static DOH_THREAD_LOCAL LineIndex lindex_cache[LINDEX_CACHE_SIZE];
+static DOH_THREAD_LOCAL int lindex_clock = 0;
+
+static void lindex_invalidate(String *s) {
+  int i;
+  for (i = 0; i < LINDEX_CACHE_SIZE; i++) {
+    if (lindex_cache[i].owner == s) {
+      DohFree(lindex_cache[i].breaks);
+      lindex_cache[i].breaks = 0;
+      lindex_cache[i].owner = 0;
+      lindex_cache[i].nbreaks = 0;
+      return;
+    }
+  }
+}
+
+static LineIndex *lindex_get(String *s) {
+  int i, maxbreaks;
+  LineIndex *x;
+  char *p, *e;
+  for (i = 0; i < LINDEX_CACHE_SIZE; i++) {
+    if (lindex_cache[i].owner == s)
+      return &lindex_cache[i];
+  }
+  x = &lindex_cache[lindex_clock];
+  lindex_clock = (lindex_clock + 1) % LINDEX_CACHE_SIZE;
+  DohFree(x->breaks);
+  maxbreaks = 64;
+  x->breaks = (int *) DohMalloc(maxbreaks * sizeof(int));
+  assert(x->breaks);
+  x->nbreaks = 0;
+  p = s->str;
+  e = p + s->len;
+  while ((p = (char *) memchr(p, '\n', e - p))) {
+    if (x->nbreaks == maxbreaks) {
+      maxbreaks *= 2;
+      x->breaks = (int *) DohRealloc(x->breaks, maxbreaks * sizeof(int));
+      assert(x->breaks);
+    }
+    x->breaks[x->nbreaks++] = (int) (p - s->str);
+    p++;
+  }
+  x->owner = s;
+  return x;
+}
+
+/* Number of indexed newlines at offsets below pos */
+static int lindex_below(LineIndex *x, int pos) {
+  int lo = 0, hi = x->nbreaks;
+  while (lo < hi) {
+    int mid = (lo + hi) / 2;
+    if (x->breaks[mid] < pos)
+      lo = mid + 1;
+    else
+      hi = mid;
+  }
+  return lo;
+}
+
 /* -----------------------------------------------------------------------------
  * String_data() - Return as a 'void *'
  * ----------------------------------------------------------------------------- */
@@ -73,9 +180,14 @@ static DOH *CopyString(DOH *so) {
   str->file = s->file;
   if (str->file)
     Incref(str->file);
-  str->str = (char *) DohMalloc(s->len + 1);
+  if (s->len + 1 <= SSO_MAXSIZE) {
+    str->str = str->sso;
+    str->maxsize = SSO_MAXSIZE;
+  } else {
+    str->str = (char *) DohMalloc(s->len + 1);
+    str->maxsize = s->len + 1;
+  }
   memcpy(str->str, s->str, s->len);
-  str->maxsize = s->len;
   str->len = s->len;
   str->str[str->len] = 0;
 
@@ -88,7 +200,9 @@ static DOH *CopyString(DOH *so) {
 
 static void DelString(DOH *so) {
   String *s = (String *) ObjData(so);
-  DohFree(s->str);
+  lindex_invalidate(s);
+  if (s->str != s->sso)
+    DohFree(s->str);
   DohFree(s);
 }
 
@@ -173,6 +287,13 @@ static int String_equal(DOH *so1, DOH *so2) {
 
 /* -----------------------------------------------------------------------------
  * String_hash() - Compute string hash value
+ *
+ * A seeded 64-bit multiply-mix over 8-byte blocks (MurmurHash64A shape).
+ * The previous shift-add loop stopped after 50 characters, which made all
+ * long mangled type names sharing a prefix ("_p_std__vectorT_...") hash
+ * identically; this hashes the full string at 8 bytes per step, so it is
+ * also faster on those names.  The value is cached in hashkey, so each
+ * string pays for hashing once.
  * ----------------------------------------------------------------------------- */
 
 static int String_hash(DOH *so) {
@@ -180,23 +301,32 @@ static int String_hash(DOH *so) {
   if (s->hashkey >= 0) {
     return s->hashkey;
   } else {
-    char *c = s->str;
-    unsigned int len = s->len > 50 ? 50 : s->len;
-    unsigned int h = 0;
-    unsigned int mlen = len >> 2;
-    unsigned int i = mlen;
-    for (; i; --i) {
-      h = (h << 5) + *(c++);
-      h = (h << 5) + *(c++);
-      h = (h << 5) + *(c++);
-      h = (h << 5) + *(c++);
+    const char *c = s->str;
+    unsigned int len = (unsigned int) s->len;
+    const unsigned long long m = 0x9ddfea08eb382d69ULL;
+    unsigned long long h = 0x9e3779b97f4a7c15ULL ^ (m * len);
+    unsigned long long k;
+    while (len >= 8) {
+      memcpy(&k, c, 8);
+      k *= m;
+      k ^= k >> 47;
+      k *= m;
+      h ^= k;
+      h *= m;
+      c += 8;
+      len -= 8;
     }
-    for (i = len - (mlen << 2); i; --i) {
-      h = (h << 5) + *(c++);
+    if (len) {
+      k = 0;
+      memcpy(&k, c, len);
+      h ^= k;
+      h *= m;
     }
-    h &= 0x7fffffff;
-    s->hashkey = (int)h;
-    return h;
+    h ^= h >> 47;
+    h *= m;
+    h ^= h >> 32;
+    s->hashkey = (int) (h & 0x7fffffff);
+    return s->hashkey;
   }
 }
 
@@ -221,6 +351,7 @@ static void DohString_append(DOH *so, const DOHString_or_char *str) {
   if (!newstr)
     return;
   s->hashkey = -1;
+  lindex_invalidate(s);
 
   oldlen = s->len;
   newlen = oldlen + l + 1;
@@ -228,19 +359,18 @@ static void DohString_append(DOH *so, const DOHString_or_char *str) {
     newmaxsize = 2 * s->maxsize;
     if (newlen >= newmaxsize - 1)
       newmaxsize = newlen + 1;
-    s->str = (char *) DohRealloc(s->str, newmaxsize);
-    assert(s->str);
-    s->maxsize = newmaxsize;
+    String_resize(s, newmaxsize);
   }
   tc = s->str;
   memcpy(tc + oldlen, newstr, l + 1);
   sp = s->sp;
   if (sp >= oldlen) {
-    int i = oldlen + l - sp;
-    tc += sp;
-    for (; i; --i) {
-      if (*(tc++) == '\n')
-	s->line++;
+    /* Count newlines with memchr, which libc vectorizes */
+    char *p = tc + sp;
+    char *e = tc + oldlen + l;
+    while ((p = (char *) memchr(p, '\n', e - p))) {
+      s->line++;
+      p++;
     }
     s->sp = oldlen + l;
   }
@@ -255,6 +385,7 @@ static void DohString_append(DOH *so, const DOHString_or_char *str) {
 static void String_clear(DOH *so) {
   String *s = (String *) ObjData(so);
   s->hashkey = -1;
+  lindex_invalidate(s);
   s->len = 0;
   *(s->str) = 0;
   s->sp = 0;
@@ -278,6 +409,7 @@ static int String_insert(DOH *so, int pos, DOH *str) {
 
   s = (String *) ObjData(so);
   s->hashkey = -1;
+  lindex_invalidate(s);
   if (DohCheck(str)) {
     String *ss = (String *) ObjData(str);
     data = (char *) String_data(str);
@@ -294,10 +426,7 @@ static int String_insert(DOH *so, int pos, DOH *str) {
 
   /* See if there is room to insert the new data */
   while (s->maxsize <= s->len + len) {
-    int newsize = 2 * s->maxsize;
-    s->str = (char *) DohRealloc(s->str, newsize);
-    assert(s->str);
-    s->maxsize = newsize;
+    String_resize(s, 2 * s->maxsize);
   }
   memmove(s->str + pos + len, s->str + pos, (s->len - pos));
   memcpy(s->str + pos, data, len);
@@ -322,6 +451,7 @@ static int String_insert(DOH *so, int pos, DOH *str) {
 static int String_delitem(DOH *so, int pos) {
   String *s = (String *) ObjData(so);
   s->hashkey = -1;
+  lindex_invalidate(s);
   if (pos == DOH_END)
     pos = s->len - 1;
   if (pos == DOH_BEGIN)
@@ -351,6 +481,7 @@ static int String_delslice(DOH *so, int sindex, int eindex) {
   if (s->len == 0)
     return 0;
   s->hashkey = -1;
+  lindex_invalidate(s);
   if (eindex == DOH_END)
     eindex = s->len;
   if (sindex == DOH_BEGIN)
@@ -419,13 +550,12 @@ static int String_write(DOH *so, const void *buffer, int len) {
   int newlen;
   String *s = (String *) ObjData(so);
   s->hashkey = -1;
+  lindex_invalidate(s);
   if (s->sp > s->len)
     s->sp = s->len;
   newlen = s->sp + len + 1;
   if (newlen > s->maxsize) {
-    s->str = (char *) DohRealloc(s->str, newlen);
-    assert(s->str);
-    s->maxsize = newlen;
+    String_resize(s, newlen);
     s->len = s->sp + len;
   }
   if ((s->sp + len) > s->len)
@@ -461,33 +591,37 @@ static int String_seek(DOH *so, long offset, int whence) {
 
   inc = (nsp > s->sp) ? 1 : -1;
 
-  {
-#if 0
-    int sp = s->sp;
-    char *tc = s->str;
-    int len = s->len;
-    while (sp != nsp) {
-      int prev = sp + inc;
-      if (prev >= 0 && prev <= len && tc[prev] == '\n')
-	s->line += inc;
-      sp += inc;
-    }
-#else
+  if ((inc > 0 ? nsp - s->sp : s->sp - nsp) >= LINDEX_MIN_SCAN) {
+    /* Long seek: count the crossed newlines with two binary searches in
+       the line-break index instead of scanning the range */
+    LineIndex *x = lindex_get(s);
+    if (inc > 0)
+      s->line += lindex_below(x, nsp + 1) - lindex_below(x, s->sp + 1);
+    else
+      s->line -= lindex_below(x, s->sp) - lindex_below(x, nsp);
+    s->sp = nsp;
+  } else {
+    /* Adjust the line count by scanning for newlines with memchr, which
+       libc vectorizes, instead of examining every byte */
     int sp = s->sp;
     char *tc = s->str;
+    char *p, *e;
     if (inc > 0) {
-      while (sp != nsp) {
-	if (tc[++sp] == '\n')
-	  ++s->line;
+      p = tc + sp + 1;
+      e = tc + nsp + 1;
+      while ((p = (char *) memchr(p, '\n', e - p))) {
+	++s->line;
+	p++;
       }
     } else {
-      while (sp != nsp) {
-	if (tc[--sp] == '\n')
-	  --s->line;
+      p = tc + nsp;
+      e = tc + sp;
+      while ((p = (char *) memchr(p, '\n', e - p))) {
+	--s->line;
+	p++;
       }
     }
-#endif
-    s->sp = sp;
+    s->sp = nsp;
   }
   assert(s->sp >= 0);
   return 0;
@@ -511,17 +645,14 @@ static int String_putc(DOH *so, int ch) {
   int len = s->len;
   int sp = s->sp;
   s->hashkey = -1;
+  lindex_invalidate(s);
   if (sp >= len) {
     int maxsize = s->maxsize;
-    char *tc = s->str;
+    char *tc;
     if (len > (maxsize - 2)) {
-      maxsize *= 2;
-      tc = (char *) DohRealloc(tc, maxsize);
-      assert(tc);
-      s->maxsize = (int) maxsize;
-      s->str = tc;
+      String_resize(s, 2 * maxsize);
     }
-    tc += sp;
+    tc = s->str + sp;
     *tc = (char) ch;
     *(++tc) = 0;
     s->len = s->sp = sp + 1;
@@ -702,6 +833,7 @@ static int replace_simple(String *str, char *token, char *rep, int flags, int co
     return 0;			/* No matches.  Who cares */
 
   str->hashkey = -1;
+  lindex_invalidate(str);
 
   if (flags & DOH_REPLACE_NOQUOTE)
     noquote = 1;
@@ -998,7 +1130,8 @@ static int replace_simple(String *str, char *token, char *rep, int flags, int co
     str->len += expand;
     str->str[str->len] = 0;
     str->maxsize = newsize;
-    DohFree(c);
+    if (c != str->sso)
+      DohFree(c);
     return rcount;
   }
 }
@@ -1048,6 +1181,7 @@ static void String_chop(DOH *so) {
   str->str[str->len] = 0;
   assert(str->sp >= 0);
   str->hashkey = -1;
+  lindex_invalidate(str);
 }
 
 static void String_setfile(DOH *so, DOH *file) {
@@ -1097,6 +1231,118 @@ static DohFileMethods StringFileMethods = {
   String_tell,
 };
 
+/* -----------------------------------------------------------------------------
+ * DohReplaceMulti()
+ *
+ * Replace every occurrence of the keys of the 'patterns' hash with their
+ * values in a single left-to-right pass over s.  At each position the
+ * longest matching key wins and replacement text is never rescanned, so one
+ * call behaves like a sequence of independent Replaceall calls but reads
+ * the string only once.  Returns the number of replacements made.
+ * ----------------------------------------------------------------------------- */
+
+static void multi_append(char **ns, int *len, int *cap, const char *data, int l) {
+  if (*len + l + 1 > *cap) {
+    while (*len + l + 1 > *cap)
+      *cap *= 2;
+    *ns = (char *) DohRealloc(*ns, *cap);
+    assert(*ns);
+  }
+  memcpy(*ns + *len, data, l);
+  *len += l;
+}
+
+int DohReplaceMulti(DOH *stro, DOH *patterns) {
+  String *str;
+  int npat, i, nrep = 0;
+  char **tok, **rep;
+  int *toklen, *replen;
+  char firstset[256];
+  char fc[257];
+  int nfc = 0;
+  Iterator ki;
+  char *s, *send, *ns;
+  int nlen = 0, cap;
+
+  assert(DohIsString(stro));
+  npat = DohLen(patterns);
+  str = (String *) ObjData(stro);
+  if ((npat <= 0) || (str->len == 0))
+    return 0;
+
+  tok = (char **) DohMalloc(npat * sizeof(char *));
+  rep = (char **) DohMalloc(npat * sizeof(char *));
+  toklen = (int *) DohMalloc(npat * sizeof(int));
+  replen = (int *) DohMalloc(npat * sizeof(int));
+  memset(firstset, 0, sizeof(firstset));
+  i = 0;
+  for (ki = First(patterns); ki.key; ki = Next(ki)) {
+    char *t = Char(ki.key);
+    if (t && *t) {
+      unsigned char c = (unsigned char) *t;
+      tok[i] = t;
+      toklen[i] = Len(ki.key);
+      rep[i] = Char(ki.item);
+      replen[i] = Len(ki.item);
+      if (!firstset[c]) {
+	firstset[c] = 1;
+	fc[nfc++] = (char) c;
+      }
+      i++;
+    }
+  }
+  npat = i;
+  fc[nfc] = 0;
+
+  cap = str->len + 1;
+  ns = (char *) DohMalloc(cap);
+  s = str->str;
+  send = s + str->len;
+  while (s < send) {
+    int best = -1, bestlen = 0;
+    char *m = strpbrk(s, fc);
+    if (!m) {
+      multi_append(&ns, &nlen, &cap, s, (int) (send - s));
+      break;
+    }
+    multi_append(&ns, &nlen, &cap, s, (int) (m - s));
+    for (i = 0; i < npat; i++) {
+      if ((tok[i][0] == *m) && (toklen[i] > bestlen) && ((send - m) >= toklen[i]) && (memcmp(m, tok[i], toklen[i]) == 0)) {
+	best = i;
+	bestlen = toklen[i];
+      }
+    }
+    if (best >= 0) {
+      multi_append(&ns, &nlen, &cap, rep[best], replen[best]);
+      s = m + bestlen;
+      nrep++;
+    } else {
+      multi_append(&ns, &nlen, &cap, m, 1);
+      s = m + 1;
+    }
+  }
+  DohFree(tok);
+  DohFree(rep);
+  DohFree(toklen);
+  DohFree(replen);
+
+  if (!nrep) {
+    DohFree(ns);
+    return 0;
+  }
+  ns[nlen] = 0;
+  if (str->str != str->sso)
+    DohFree(str->str);
+  str->str = ns;
+  str->maxsize = cap;
+  str->len = nlen;
+  str->hashkey = -1;
+  lindex_invalidate(str);
+  if (str->sp > nlen)
+    str->sp = nlen;
+  return nrep;
+}
+
 static DohStringMethods StringStringMethods = {
   String_replace,
   String_chop,
@@ -1160,7 +1406,12 @@ DOHString *DohNewString(const DOHString_or_char *so) {
     if ((l + 1) > max)
       max = l + 1;
   }
-  str->str = (char *) DohMalloc(max);
+  if (max <= SSO_MAXSIZE) {
+    str->str = str->sso;
+    max = SSO_MAXSIZE;
+  } else {
+    str->str = (char *) DohMalloc(max);
+  }
   str->maxsize = max;
   if (s) {
     strcpy(str->str, s);
@@ -1181,11 +1432,16 @@ DOHString *DohNewString(const DOHString_or_char *so) {
 DOHString *DohNewStringEmpty(void) {
   int max = INIT_MAXSIZE;
   String *str = (String *) DohMalloc(sizeof(String));
-  str->hashkey = 0;
+  str->hashkey = -1;
   str->sp = 0;
   str->line = 1;
   str->file = 0;
-  str->str = (char *) DohMalloc(max);
+  if (max <= SSO_MAXSIZE) {
+    str->str = str->sso;
+    max = SSO_MAXSIZE;
+  } else {
+    str->str = (char *) DohMalloc(max);
+  }
   str->maxsize = max;
   str->str[0] = 0;
   str->len = 0;
@@ -1217,7 +1473,12 @@ DOHString *DohNewStringWithSize(const DOHString_or_char *so, int len) {
     if ((l + 1) > max)
       max = l + 1;
   }
-  str->str = (char *) DohMalloc(max);
+  if (max <= SSO_MAXSIZE) {
+    str->str = str->sso;
+    max = SSO_MAXSIZE;
+  } else {
+    str->str = (char *) DohMalloc(max);
+  }
   str->maxsize = max;
   if (s) {
     strncpy(str->str, s, len);
@@ -0,0 +1,210 @@
+/* -----------------------------------------------------------------------------
+ * This file is part of SWIG, which is licensed as a whole under version 3
+ * (or any later version) of the GNU General Public License. Some additional
+ * terms also apply to certain portions of SWIG. The full details of the SWIG
+ * license and copyrights can be found in the LICENSE and COPYRIGHT files
+ * included with the SWIG source code as distributed by the SWIG developers
+ * and at http://www.swig.org/legal.html.
+ *
+ * view.c
+ *
+ *     Implements an immutable substring view.  A view pins its parent
+ *     string with a reference and records an offset/length into it, so
+ *     extracting short-lived fragments (type elements, qualifier lists)
+ *     does not copy the characters.  Length, hashing, comparison and
+ *     dumping work directly on the parent buffer; Data/Char on a view
+ *     that is not a suffix of the parent materializes a private
+ *     nul-terminated copy on first use.  The parent must not be modified
+ *     while views of it are alive.
+ * ----------------------------------------------------------------------------- */
+
+#include "dohint.h"
+
+extern DohObjInfo DohStringViewType;
+
+typedef struct StringView {
+  DOH *parent;			/* Pinned parent string */
+  int offset;			/* Start of the view in the parent */
+  int len;			/* Length of the view */
+  int hashkey;			/* Cached hash value */
+  char *copy;			/* Private nul-terminated copy, made on demand */
+} StringView;
+
+/* Raw pointer to the viewed characters inside the parent buffer */
+static char *view_ptr(StringView *v) {
+  return ((char *) Data(v->parent)) + v->offset;
+}
+
+/* -----------------------------------------------------------------------------
+ * StringView_data() - Return the characters as a nul-terminated C string
+ * ----------------------------------------------------------------------------- */
+
+static void *StringView_data(DOH *so) {
+  StringView *v = (StringView *) ObjData(so);
+  if (v->copy)
+    return v->copy;
+  if (v->offset + v->len == Len(v->parent)) {
+    /* Suffix of the parent: the parent's own terminator serves */
+    return view_ptr(v);
+  }
+  v->copy = (char *) DohMalloc(v->len + 1);
+  memcpy(v->copy, view_ptr(v), v->len);
+  v->copy[v->len] = 0;
+  return v->copy;
+}
+
+/* -----------------------------------------------------------------------------
+ * StringView_dump() - Serialize onto out straight from the parent buffer
+ * ----------------------------------------------------------------------------- */
+
+static int StringView_dump(DOH *so, DOH *out) {
+  StringView *v = (StringView *) ObjData(so);
+  int nsent = 0;
+  char *p = view_ptr(v);
+  while (nsent < v->len) {
+    int ret = Write(out, p + nsent, v->len - nsent);
+    if (ret < 0)
+      return ret;
+    nsent += ret;
+  }
+  return nsent;
+}
+
+/* -----------------------------------------------------------------------------
+ * StringView_str() - Return a real String with the same contents
+ * ----------------------------------------------------------------------------- */
+
+static DOH *StringView_str(DOH *so) {
+  StringView *v = (StringView *) ObjData(so);
+  return NewStringWithSize(view_ptr(v), v->len);
+}
+
+static int StringView_len(DOH *so) {
+  StringView *v = (StringView *) ObjData(so);
+  return v->len;
+}
+
+/* Same mixing as String_hash so a view hashes like the equivalent string */
+static int StringView_hash(DOH *so) {
+  StringView *v = (StringView *) ObjData(so);
+  if (v->hashkey >= 0) {
+    return v->hashkey;
+  } else {
+    const char *c = view_ptr(v);
+    unsigned int len = (unsigned int) v->len;
+    const unsigned long long m = 0x9ddfea08eb382d69ULL;
+    unsigned long long h = 0x9e3779b97f4a7c15ULL ^ (m * len);
+    unsigned long long k;
+    while (len >= 8) {
+      memcpy(&k, c, 8);
+      k *= m;
+      k ^= k >> 47;
+      k *= m;
+      h ^= k;
+      h *= m;
+      c += 8;
+      len -= 8;
+    }
+    if (len) {
+      k = 0;
+      memcpy(&k, c, len);
+      h ^= k;
+      h *= m;
+    }
+    h ^= h >> 47;
+    h *= m;
+    h ^= h >> 32;
+    v->hashkey = (int) (h & 0x7fffffff);
+    return v->hashkey;
+  }
+}
+
+static int StringView_cmp(DOH *so1, DOH *so2) {
+  StringView *v1 = (StringView *) ObjData(so1);
+  StringView *v2 = (StringView *) ObjData(so2);
+  int minlen = (v1->len < v2->len) ? v1->len : v2->len;
+  int d = memcmp(view_ptr(v1), view_ptr(v2), minlen);
+  if (d)
+    return (d < 0) ? -1 : 1;
+  if (v1->len == v2->len)
+    return 0;
+  return (v1->len < v2->len) ? -1 : 1;
+}
+
+static int StringView_equal(DOH *so1, DOH *so2) {
+  StringView *v1 = (StringView *) ObjData(so1);
+  StringView *v2 = (StringView *) ObjData(so2);
+  return (v1->len == v2->len) && (memcmp(view_ptr(v1), view_ptr(v2), v1->len) == 0);
+}
+
+/* -----------------------------------------------------------------------------
+ * CopyStringView() - Copies detach from the parent and become real Strings
+ * ----------------------------------------------------------------------------- */
+
+static DOH *CopyStringView(DOH *so) {
+  return StringView_str(so);
+}
+
+static void DelStringView(DOH *so) {
+  StringView *v = (StringView *) ObjData(so);
+  Delete(v->parent);
+  if (v->copy)
+    DohFree(v->copy);
+  DohFree(v);
+}
+
+/* Positional information delegates to the parent */
+
+static DOH *StringView_getfile(DOH *so) {
+  StringView *v = (StringView *) ObjData(so);
+  return Getfile(v->parent);
+}
+
+static int StringView_getline(DOH *so) {
+  StringView *v = (StringView *) ObjData(so);
+  return Getline(v->parent);
+}
+
+DohObjInfo DohStringViewType = {
+  "StringView",			/* objname */
+  DelStringView,		/* doh_del */
+  CopyStringView,		/* doh_copy */
+  0,				/* doh_clear */
+  StringView_str,		/* doh_str */
+  StringView_data,		/* doh_data */
+  StringView_dump,		/* doh_dump */
+  StringView_len,		/* doh_len */
+  StringView_hash,		/* doh_hashval */
+  StringView_cmp,		/* doh_cmp */
+  StringView_equal,		/* doh_equal    */
+  0,				/* doh_first    */
+  0,				/* doh_next     */
+  0,				/* doh_setfile */
+  StringView_getfile,		/* doh_getfile */
+  0,				/* doh_setline */
+  StringView_getline,		/* doh_getline */
+  0,				/* doh_mapping */
+  0,				/* doh_sequence */
+  0,				/* doh_file  */
+  0,				/* doh_string */
+  0,				/* doh_reserved */
+  0,				/* clientdata */
+};
+
+/* -----------------------------------------------------------------------------
+ * NewStringView() - Create a view of len characters starting at offset
+ * ----------------------------------------------------------------------------- */
+
+DOH *DohNewStringView(DOH *parent, int offset, int len) {
+  StringView *v;
+  assert(DohIsString(parent));
+  assert((offset >= 0) && (len >= 0) && (offset + len <= Len(parent)));
+  v = (StringView *) DohMalloc(sizeof(StringView));
+  v->parent = parent;
+  Incref(parent);
+  v->offset = offset;
+  v->len = len;
+  v->hashkey = -1;
+  v->copy = 0;
+  return DohObjMalloc(&DohStringViewType, v);
+}
@@ -55,7 +55,18 @@ String *DoxygenTranslator::getDocumentation(Node *node, const_String_or_char_ptr
     return NewString("");
   }
 
-  String *documentation = makeDocumentation(node);
+  /* The tokenization and tree walk in makeDocumentation depend only on the
+     comment, but a node's documentation can be emitted from several places
+     (proxy method and flattened wrapper, getter and setter), so the
+     translation is remembered on the node and only the per-call indentation
+     is applied to a copy. */
+  String *documentation = Getattr(node, "doxygen:translated");
+  if (!documentation) {
+    documentation = makeDocumentation(node);
+    Setattr(node, "doxygen:translated", documentation);
+    Delete(documentation);
+  }
+  documentation = Copy(documentation);
   extraIndentation(documentation, indentationString);
   return documentation;
 }
@@ -252,6 +252,7 @@
 /* please leave 720-739 free for Scilab */
 
 #define WARN_PYTHON_INDENT_MISMATCH           740
+#define WARN_PYTHON_SLOTS_MULTIPLE_BASES      741
 
 /* please leave 740-759 free for Python */
 
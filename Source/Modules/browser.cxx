@@ -19,6 +19,12 @@ extern "C" {
 #include "swill.h"
 } static FILE *out = 0;
 static Node *view_top = 0;
+static int view_page = 0;
+
+/* Number of children rendered per page for the node being viewed.  Without a
+   cap, viewing the top node of a large interface renders one header line per
+   parse tree node and the page becomes too big for any browser. */
+#define BROWSER_PAGE_SIZE 500
 
 class Browser:public Dispatcher {
   void show_checkbox(Node *t, Node *n) {
@@ -27,9 +33,9 @@ class Browser:public Dispatcher {
       v = 1;
     }
     if (v) {
-      Printf(out, "<a name=\"n%p\"></a>[<a href=\"hide.html?node=%p&hn=%p#n%p\">-</a>] ", n, t, n, n);
+      Printf(out, "<a name=\"n%p\"></a>[<a href=\"hide.html?node=%p&hn=%p&page=%d#n%p\">-</a>] ", n, t, n, view_page, n);
     } else {
-      Printf(out, "<a name=\"n%p\"></a>[<a href=\"show.html?node=%p&hn=%p#n%p\">+</a>] ", n, t, n, n);
+      Printf(out, "<a name=\"n%p\"></a>[<a href=\"show.html?node=%p&hn=%p&page=%d#n%p\">+</a>] ", n, t, n, view_page, n);
     }
   }
   void show_attributes(Node *obj) {
@@ -94,7 +100,36 @@ public:
   virtual int emit_children(Node *n) {
     if (Getmeta(n, "visible")) {
       Printf(out, "<blockquote>\n");
-      Dispatcher::emit_children(n);
+      if (n == view_top) {
+	/* Paginate the children of the node being viewed so that a node with
+	   a huge number of children (the top node of a large interface, a
+	   class with thousands of members) stays browsable.  Nodes expanded
+	   further down render in full; they are expanded one at a time. */
+	Node *c;
+	int i = 0;
+	int start = view_page * BROWSER_PAGE_SIZE;
+	for (c = firstChild(n); c && (i < start + BROWSER_PAGE_SIZE); c = nextSibling(c), i++) {
+	  if (i >= start) {
+	    emit_one(c);
+	  }
+	}
+	if ((view_page > 0) || c) {
+	  int total = i;
+	  for (; c; c = nextSibling(c))
+	    total++;
+	  Printf(out, "<p>");
+	  if (view_page > 0) {
+	    Printf(out, "[<a href=\"index.html?node=%p&page=%d\">&lt;&lt; prev</a>] ", n, view_page - 1);
+	  }
+	  Printf(out, "children %d-%d of %d", start < total ? start + 1 : total, i, total);
+	  if (i < total) {
+	    Printf(out, " [<a href=\"index.html?node=%p&page=%d\">next &gt;&gt;</a>]", n, view_page + 1);
+	  }
+	  Printf(out, "\n");
+	}
+      } else {
+	Dispatcher::emit_children(n);
+      }
       Printf(out, "</blockquote>\n");
     }
     return SWIG_OK;
@@ -206,10 +241,13 @@ static void display(FILE *f, Node *n) {
 
 void node_handler(FILE *f) {
   Node *n = 0;
-  if (!swill_getargs("p(node)", &n)) {
+  int page = 0;
+  if (!swill_getargs("p(node)|i(page)", &n, &page)) {
     n = tree_top;
+    page = 0;
   }
   view_top = n;
+  view_page = page > 0 ? page : 0;
   display(f, n);
 }
 
@@ -94,6 +94,22 @@ void emit_parameter_variables(ParmList *l, Wrapper *f) {
   }
 }
 
+/* -----------------------------------------------------------------------------
+ * emit_argument_frame()
+ *
+ * Declare a fixed-size, stack-allocated argument frame as a local variable of
+ * a wrapper.  The frame size (typically the maxargs value computed by
+ * Swig_overload_dispatch) is known at generation time, so dispatchers can use
+ * this instead of heap-allocating an argument array on every call.  A size of
+ * zero still declares one element since C forbids zero-length arrays.
+ * ----------------------------------------------------------------------------- */
+
+void emit_argument_frame(Wrapper *f, const_String_or_char_ptr type, const_String_or_char_ptr name, int maxargs) {
+  String *decl = NewStringf("%s %s[%d]", type, name, maxargs > 0 ? maxargs : 1);
+  Wrapper_add_local(f, name, decl);
+  Delete(decl);
+}
+
 /* -----------------------------------------------------------------------------
  * emit_attach_parmmaps()
  *
@@ -1429,6 +1429,18 @@ private:
       ret_type = cgoTypeForGoValue(info->n, info->result, &c_struct_type);
     }
 
+    // Directives asserting that the C wrapper does not retain Go
+    // pointers or call back into Go, letting the Go 1.22+ runtime use a
+    // cheaper crossing.  These are opt-in per declaration because the
+    // assertions do not hold for directors or for %exception code that
+    // panics, and older toolchains reject unknown #cgo verbs.
+    if (GetFlag(info->n, "feature:go:cgo_noescape")) {
+      Printv(f_cgo_comment, "#cgo noescape ", info->wname, "\n", NULL);
+    }
+    if (GetFlag(info->n, "feature:go:cgo_nocallback")) {
+      Printv(f_cgo_comment, "#cgo nocallback ", info->wname, "\n", NULL);
+    }
+
     Printv(f_cgo_comment, "extern ", ret_type, " ", info->wname, "(", NULL);
 
     Delete(ret_type);
@@ -4862,7 +4862,6 @@ public:
       /* Emit the code to look up the class's methods, initialize the override array */
 
       Printf(w->code, "  bool derived = (jenv->IsSameObject(baseclass, jcls) ? false : true);\n");
-      Printf(w->code, "  for (int i = 0; i < %d; ++i) {\n", n_methods);
       // Generally, derived classes have a mix of overridden and
       // non-overridden methods and it is worth making a GetMethodID
       // check during initialization to determine if each method is
@@ -4878,16 +4877,25 @@ public:
       // The assumeoverride feature on a director controls whether or not
       // overrides are assumed.
       if (GetFlag(n, "feature:director:assumeoverride")) {
+        Printf(w->code, "  for (int i = 0; i < %d; ++i) {\n", n_methods);
         Printf(w->code, "  swig_override[i] = derived;\n");
+        Printf(w->code, "}\n");
       } else {
-        Printf(w->code, "  swig_override[i] = false;\n");
+        // The probing result only depends on the dynamic class, so repeated
+        // instances of the same subclass take their flags from a cache keyed
+        // by a weak global reference to the class.
         Printf(w->code, "  if (derived) {\n");
-        Printf(w->code, "    jmethodID methid = jenv->GetMethodID(jcls, methods[i].name, methods[i].desc);\n");
-        Printf(w->code, "    swig_override[i] = methods[i].methid && (methid != methods[i].methid);\n");
-        Printf(w->code, "    jenv->ExceptionClear();\n");
+        Printf(w->code, "    static Swig::OverrideCache<%d> override_cache;\n", n_methods);
+        Printf(w->code, "    if (!override_cache.lookup(jenv, jcls, swig_override)) {\n");
+        Printf(w->code, "      for (int i = 0; i < %d; ++i) {\n", n_methods);
+        Printf(w->code, "        jmethodID methid = jenv->GetMethodID(jcls, methods[i].name, methods[i].desc);\n");
+        Printf(w->code, "        swig_override[i] = methods[i].methid && (methid != methods[i].methid);\n");
+        Printf(w->code, "        jenv->ExceptionClear();\n");
+        Printf(w->code, "      }\n");
+        Printf(w->code, "      override_cache.store(jenv, jcls, swig_override);\n");
+        Printf(w->code, "    }\n");
         Printf(w->code, "  }\n");
       }
-      Printf(w->code, "}\n");
     } else {
       Printf(f_directors_h, "public:\n");
       Printf(f_directors_h, "    bool swig_overrides(int n) {\n");
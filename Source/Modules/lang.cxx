@@ -108,78 +108,127 @@ int Dispatcher::emit_one(Node *n) {
   if (wrn)
     Swig_warnfilter(wrn, 1);
 
-  /* ============================================================
-   * C/C++ parsing
-   * ============================================================ */
-
-  if (strcmp(tag, "extern") == 0) {
-    ret = externDeclaration(n);
-  } else if (strcmp(tag, "cdecl") == 0) {
-    ret = cDeclaration(n);
-  } else if (strcmp(tag, "enum") == 0) {
-    ret = enumDeclaration(n);
-  } else if (strcmp(tag, "enumitem") == 0) {
-    ret = enumvalueDeclaration(n);
-  } else if (strcmp(tag, "enumforward") == 0) {
-    ret = enumforwardDeclaration(n);
-  } else if (strcmp(tag, "class") == 0) {
-    ret = classDeclaration(n);
-  } else if (strcmp(tag, "classforward") == 0) {
-    ret = classforwardDeclaration(n);
-  } else if (strcmp(tag, "constructor") == 0) {
-    ret = constructorDeclaration(n);
-  } else if (strcmp(tag, "destructor") == 0) {
-    ret = destructorDeclaration(n);
-  } else if (strcmp(tag, "access") == 0) {
-    ret = accessDeclaration(n);
-  } else if (strcmp(tag, "using") == 0) {
-    ret = usingDeclaration(n);
-  } else if (strcmp(tag, "namespace") == 0) {
-    ret = namespaceDeclaration(n);
-  } else if (strcmp(tag, "template") == 0) {
-    ret = templateDeclaration(n);
-  } else if (strcmp(tag, "lambda") == 0) {
-    ret = lambdaDeclaration(n);
-  }
-
-  /* ===============================================================
-   *  SWIG directives
-   * =============================================================== */
-
-  else if (strcmp(tag, "top") == 0) {
-    ret = top(n);
-  } else if (strcmp(tag, "extend") == 0) {
-    ret = extendDirective(n);
-  } else if (strcmp(tag, "apply") == 0) {
-    ret = applyDirective(n);
-  } else if (strcmp(tag, "clear") == 0) {
-    ret = clearDirective(n);
-  } else if (strcmp(tag, "constant") == 0) {
-    ret = constantDirective(n);
-  } else if (strcmp(tag, "fragment") == 0) {
-    ret = fragmentDirective(n);
-  } else if (strcmp(tag, "import") == 0) {
-    ret = importDirective(n);
-  } else if (strcmp(tag, "include") == 0) {
-    ret = includeDirective(n);
-  } else if (strcmp(tag, "insert") == 0) {
-    ret = insertDirective(n);
-  } else if (strcmp(tag, "module") == 0) {
-    ret = moduleDirective(n);
-  } else if (strcmp(tag, "native") == 0) {
-    ret = nativeDirective(n);
-  } else if (strcmp(tag, "pragma") == 0) {
-    ret = pragmaDirective(n);
-  } else if (strcmp(tag, "typemap") == 0) {
-    ret = typemapDirective(n);
-  } else if (strcmp(tag, "typemapcopy") == 0) {
-    ret = typemapcopyDirective(n);
-  } else if (strcmp(tag, "typemapitem") == 0) {
-    ret = typemapitemDirective(n);
-  } else if (strcmp(tag, "types") == 0) {
-    ret = typesDirective(n);
-  } else {
-    Swig_error(input_file, line_number, "Unrecognized parse tree node type '%s'\n", tag);
+  /* Dispatch on the node type.  Every pass (typepass, allocate, the
+     language emitters) funnels every tree node through here, so switch on
+     the first character before confirming the tag instead of running the
+     full strcmp chain per node.  Both C/C++ parse nodes and SWIG directive
+     nodes are handled. */
+
+  switch (tag[0]) {
+  case 'a':
+    if (strcmp(tag, "access") == 0)
+      ret = accessDeclaration(n);
+    else if (strcmp(tag, "apply") == 0)
+      ret = applyDirective(n);
+    else
+      tag = 0;
+    break;
+  case 'c':
+    if (strcmp(tag, "cdecl") == 0)
+      ret = cDeclaration(n);
+    else if (strcmp(tag, "class") == 0)
+      ret = classDeclaration(n);
+    else if (strcmp(tag, "classforward") == 0)
+      ret = classforwardDeclaration(n);
+    else if (strcmp(tag, "constructor") == 0)
+      ret = constructorDeclaration(n);
+    else if (strcmp(tag, "constant") == 0)
+      ret = constantDirective(n);
+    else if (strcmp(tag, "clear") == 0)
+      ret = clearDirective(n);
+    else
+      tag = 0;
+    break;
+  case 'd':
+    if (strcmp(tag, "destructor") == 0)
+      ret = destructorDeclaration(n);
+    else
+      tag = 0;
+    break;
+  case 'e':
+    if (strcmp(tag, "extern") == 0)
+      ret = externDeclaration(n);
+    else if (strcmp(tag, "enum") == 0)
+      ret = enumDeclaration(n);
+    else if (strcmp(tag, "enumitem") == 0)
+      ret = enumvalueDeclaration(n);
+    else if (strcmp(tag, "enumforward") == 0)
+      ret = enumforwardDeclaration(n);
+    else if (strcmp(tag, "extend") == 0)
+      ret = extendDirective(n);
+    else
+      tag = 0;
+    break;
+  case 'f':
+    if (strcmp(tag, "fragment") == 0)
+      ret = fragmentDirective(n);
+    else
+      tag = 0;
+    break;
+  case 'i':
+    if (strcmp(tag, "import") == 0)
+      ret = importDirective(n);
+    else if (strcmp(tag, "include") == 0)
+      ret = includeDirective(n);
+    else if (strcmp(tag, "insert") == 0)
+      ret = insertDirective(n);
+    else
+      tag = 0;
+    break;
+  case 'l':
+    if (strcmp(tag, "lambda") == 0)
+      ret = lambdaDeclaration(n);
+    else
+      tag = 0;
+    break;
+  case 'm':
+    if (strcmp(tag, "module") == 0)
+      ret = moduleDirective(n);
+    else
+      tag = 0;
+    break;
+  case 'n':
+    if (strcmp(tag, "namespace") == 0)
+      ret = namespaceDeclaration(n);
+    else if (strcmp(tag, "native") == 0)
+      ret = nativeDirective(n);
+    else
+      tag = 0;
+    break;
+  case 'p':
+    if (strcmp(tag, "pragma") == 0)
+      ret = pragmaDirective(n);
+    else
+      tag = 0;
+    break;
+  case 't':
+    if (strcmp(tag, "template") == 0)
+      ret = templateDeclaration(n);
+    else if (strcmp(tag, "top") == 0)
+      ret = top(n);
+    else if (strcmp(tag, "typemap") == 0)
+      ret = typemapDirective(n);
+    else if (strcmp(tag, "typemapcopy") == 0)
+      ret = typemapcopyDirective(n);
+    else if (strcmp(tag, "typemapitem") == 0)
+      ret = typemapitemDirective(n);
+    else if (strcmp(tag, "types") == 0)
+      ret = typesDirective(n);
+    else
+      tag = 0;
+    break;
+  case 'u':
+    if (strcmp(tag, "using") == 0)
+      ret = usingDeclaration(n);
+    else
+      tag = 0;
+    break;
+  default:
+    tag = 0;
+    break;
+  }
+  if (!tag) {
+    Swig_error(input_file, line_number, "Unrecognized parse tree node type '%s'\n", Char(nodeType(n)));
     ret = SWIG_ERROR;
   }
   if (wrn)
@@ -207,7 +256,12 @@ int Dispatcher::emit_children(Node *n) {
 	continue;
       }
     }
+    /* Batch reclamation of the temporaries each handler churns through;
+       anything that ends up referenced from the parse tree or the output
+       escapes the scope untouched */
+    PushDeferredDelete();
     emit_one(c);
+    PopDeferredDelete();
   }
   return SWIG_OK;
 }
@@ -25,6 +25,7 @@
 #include <ctype.h>
 #include <errno.h>
 #include <limits.h>		// for INT_MAX
+#include <time.h>		// for clock, -profile
 
 // Global variables
 
@@ -70,6 +71,7 @@ static const char *usage1 = (const char *) "\
      -copyright      - Display copyright notices\n\
      -debug-classes  - Display information about the classes found in the interface\n\
      -debug-module <n>- Display module parse tree at stages 1-4, <n> is a csv list of stages\n\
+     -debug-stats    - Print typemap/symbol/typedef lookup counters as JSON at exit\n\
      -debug-symtabs  - Display symbol tables information\n\
      -debug-symbols  - Display target language symbols in the symbol tables\n\
      -debug-csymbols - Display C symbols in the symbol tables\n\
@@ -77,6 +79,9 @@ static const char *usage1 = (const char *) "\
      -debug-tags     - Display information about the tags found in the interface\n\
      -debug-template - Display information for debugging templates\n\
      -debug-top <n>  - Display entire parse tree at stages 1-4, <n> is a csv list of stages\n\
+     -debug-tree-attrs <list> - Only display node attributes in csv <list> in parse tree displays\n\
+     -debug-tree-depth <n> - Limit parse tree displays to <n> child levels below each selected node\n\
+     -debug-tree-types <list> - Only display subtrees rooted at nodes whose type or name is in csv <list>\n\
      -debug-typedef  - Display information about the types and typedefs in the interface\n\
      -debug-typemap  - Display typemap debugging information\n\
      -debug-tmsearch - Display typemap search debugging information\n\
@@ -88,9 +93,12 @@ static const char *usage1 = (const char *) "\
 
 static const char *usage2 = (const char *) "\
      -E              - Preprocess only, does not generate wrapper code\n\
+     -export-typetab <file> - Write a binary type manifest for use by other modules\n\
      -external-runtime [file] - Export the SWIG runtime stack\n\
      -fakeversion <v>- Make SWIG fake the program version number to <v>\n\
      -fcompact       - Compile in compact mode\n\
+     -fdedup         - Replace duplicate wrapper bodies with forwarding thunks\n\
+     -fpeephole      - Fold known-redundant text in generated wrapper bodies\n\
      -features <list>- Set global features, where <list> is a comma separated list of\n\
                        features, eg -features directors,autodoc=1\n\
                        If no explicit value is given to the feature, a default of 1 is used\n\
@@ -102,8 +110,10 @@ static const char *usage2 = (const char *) "\
      -I-             - Don't search the current directory\n\
      -I<dir>         - Look for SWIG files in directory <dir>\n\
      -ignoremissing  - Ignore missing include files\n\
+     -import-typetab <file> - Preload a binary type manifest written by -export-typetab\n\
      -importall      - Follow all #include statements as imports\n\
      -includeall     - Follow all #include statements\n\
+     -incremental    - Skip wrapper generation entirely when nothing has changed since the last run\n\
      -l<ifile>       - Include SWIG library file <ifile>\n\
 ";
 
@@ -133,11 +143,16 @@ static const char *usage3 = (const char *) "\
 static const char *usage4 = (const char *) "\
      -O              - Enable the optimization options:\n\
                         -fastdispatch -fvirtual\n\
-     -o <outfile>    - Set name of C/C++ output file to <outfile>\n\
+     -o <outfile>    - Set name of C/C++ output file to <outfile>; the null device\n\
+                       discards all generated files (validation-only run)\n\
      -oh <headfile>  - Set name of C++ output header file for directors to <headfile>\n\
      -outcurrentdir  - Set default output dir to current dir instead of input file's path\n\
      -outdir <dir>   - Set language specific files output directory to <dir>\n\
      -pcreversion    - Display PCRE version information\n\
+     -pp-cache <dir> - Cache preprocessor output in directory <dir>\n\
+     -profile        - Print a phase timing report when generation finishes\n\
+     -prune-ignored  - Drop %ignored subtrees before the type pass runs\n\
+     -prune-symbols <file> - Only generate wrappers reachable from the symbols listed in <file>\n\
      -small          - Compile in virtual elimination and compact mode\n\
      -swiglib        - Report location of SWIG library and exit\n\
      -templatereduce - Reduce all the typedefs in templates\n\
@@ -147,6 +162,7 @@ static const char *usage4 = (const char *) "\
      -Wallkw         - Enable keyword warnings for all the supported languages\n\
      -Werror         - Treat warnings as errors\n\
      -Wextra         - Adds the following additional warnings: " EXTRA_WARNINGS "\n\
+     -write-if-changed - Only overwrite output files whose content changed, preserving timestamps\n\
      -w<list>        - Suppress/add warning messages, eg -w401,+321 - see Warnings.html\n\
      -xmlout <file>  - Write XML version of the parse tree to <file> after normal processing\n\
 \n\
@@ -192,6 +208,9 @@ static int dump_lang_symbols = 0;
 static int dump_tags = 0;
 static int dump_module = 0;
 static int dump_top = 0;
+static const char *tree_filter_types = 0;
+static const char *tree_filter_attrs = 0;
+static int tree_filter_depth = -1;
 static int dump_xml = 0;
 static int browse = 0;
 static int dump_typedef = 0;
@@ -201,16 +220,105 @@ static int depend = 0;
 static int depend_only = 0;
 static int depend_phony = 0;
 static int memory_debug = 0;
+static int profile = 0;
+static int stats_debug = 0;
+static String *prune_symbols_file = 0;
+static int prune_ignored_flag = 0;
 static int allkw = 0;
 static DOH *cpps = 0;
+static String *pp_cache_dir = 0;
+static int incremental = 0;
+static String *incremental_stamp = 0;
 static String *dependencies_file = 0;
 static String *dependencies_target = 0;
 static int external_runtime = 0;
 static String *external_runtime_name = 0;
+static String *export_typetab_name = 0;
+static List *import_typetab_names = 0;
 enum { STAGE1=1, STAGE2=2, STAGE3=4, STAGE4=8, STAGEOVERFLOW=16 };
 static List *libfiles = 0;
 static List *all_output_files = 0;
 
+/* -----------------------------------------------------------------------------
+ * Phase profiling (-profile)
+ *
+ * Accumulates CPU time per front end phase and prints a report sorted by
+ * cost when generation finishes.
+ * ----------------------------------------------------------------------------- */
+
+#define MAX_PROFILE_PHASES 16
+
+static struct profile_phase {
+  const char *name;
+  double secs;
+} profile_phases[MAX_PROFILE_PHASES];
+static int profile_nphases = 0;
+
+/* Charge the time since 'start' to the named phase */
+static void profile_add(const char *name, clock_t start) {
+  int i;
+  double secs;
+  if (!profile)
+    return;
+  secs = (double) (clock() - start) / (double) CLOCKS_PER_SEC;
+  for (i = 0; i < profile_nphases; i++) {
+    if (strcmp(profile_phases[i].name, name) == 0) {
+      profile_phases[i].secs += secs;
+      return;
+    }
+  }
+  if (profile_nphases < MAX_PROFILE_PHASES) {
+    profile_phases[profile_nphases].name = name;
+    profile_phases[profile_nphases].secs = secs;
+    profile_nphases++;
+  }
+}
+
+static void profile_report(clock_t start) {
+  int i, j;
+  double total = (double) (clock() - start) / (double) CLOCKS_PER_SEC;
+  double accounted = 0;
+  if (!profile)
+    return;
+  /* sort descending by time */
+  for (i = 1; i < profile_nphases; i++) {
+    for (j = i; j > 0 && profile_phases[j].secs > profile_phases[j - 1].secs; j--) {
+      struct profile_phase tmp = profile_phases[j - 1];
+      profile_phases[j - 1] = profile_phases[j];
+      profile_phases[j] = tmp;
+    }
+  }
+  Printf(stderr, "SWIG phase profile (CPU seconds):\n");
+  for (i = 0; i < profile_nphases; i++) {
+    Printf(stderr, "  %-12s %8.3f\n", profile_phases[i].name, profile_phases[i].secs);
+    accounted += profile_phases[i].secs;
+  }
+  Printf(stderr, "  %-12s %8.3f\n", "other", total - accounted > 0 ? total - accounted : 0);
+  Printf(stderr, "  %-12s %8.3f\n", "total", total);
+}
+
+/* Append one named table's probe-distance report to the -debug-stats JSON.
+   Distances of 16 and beyond collapse into the last histogram bucket. */
+static void stats_hash_report(String *out, const char *name, DOH *table) {
+  int hist[16];
+  int nitems, nslots, maxprobe, last, i;
+  if (!table)
+    return;
+  maxprobe = HashProbeStats(table, &nitems, &nslots, hist, 16);
+  if (maxprobe < 0)
+    return;
+  Printf(out, "%s\"%s\": {\"nitems\": %d, \"slots\": %d, \"max_probe\": %d, \"probe_histogram\": [",
+	 Len(out) ? ", " : "", name, nitems, nslots, maxprobe);
+  last = 0;
+  for (i = 0; i < 16; i++) {
+    if (hist[i])
+      last = i;
+  }
+  for (i = 0; i <= last; i++)
+    Printf(out, "%s%d", i ? ", " : "", hist[i]);
+  Printf(out, "]}");
+}
+
 /* -----------------------------------------------------------------------------
  * check_extension()
  *
@@ -232,6 +340,283 @@ static bool check_extension(String *filename) {
   return wanted;
 }
 
+/* -----------------------------------------------------------------------------
+ * Preprocessor output cache (-pp-cache <dir>)
+ *
+ * Stores the preprocessed interface on disk keyed by a hash of the input
+ * set, the initial macro table and the command line.  A cache entry also
+ * records a content hash for every file the preprocessor read, so editing
+ * the module or anything it includes invalidates the entry.  On a hit the
+ * preprocessor stage is skipped entirely and its macro table is restored
+ * from the entry, as the parser still preprocesses %inline blocks.
+ * ----------------------------------------------------------------------------- */
+
+typedef unsigned long long pp_hash_t;
+
+#define PP_HASH_INIT 14695981039346656037ULL
+
+/* FNV-1a */
+static pp_hash_t pp_hash(pp_hash_t h, const char *data, size_t len) {
+  size_t i;
+  for (i = 0; i < len; i++) {
+    h ^= (unsigned char) data[i];
+    h *= 1099511628211ULL;
+  }
+  return h;
+}
+
+static int pp_hash_file(const char *path, pp_hash_t *hp) {
+  char buffer[8192];
+  size_t n;
+  pp_hash_t h = PP_HASH_INIT;
+  FILE *f = fopen(path, "rb");
+  if (!f)
+    return -1;
+  while ((n = fread(buffer, 1, sizeof(buffer), f)) > 0)
+    h = pp_hash(h, buffer, n);
+  fclose(f);
+  *hp = h;
+  return 0;
+}
+
+/* Compute the cache entry filename for this invocation */
+/* Hash the serialized preprocessor state, leaving out the SWIGOPT_* macros.
+   They are pure derivatives of the command line, which is hashed separately
+   with output locations excluded; hashing them here would make the key
+   depend on -o and friends (SWIGOPT_O holds the output file name). */
+static pp_hash_t pp_hash_pp_state(pp_hash_t h, String *state) {
+  const char *p = Char(state);
+  const char *end = p + Len(state);
+  while (p < end) {
+    const char *rec = p;
+    const char *name;
+    int nl, vl, al, fl, vfl, varargs, swigmacro, line, vline, nc, i;
+    if (*p == '-' || sscanf(p, "%d %d %d %d %d %d %d %d %d%n", &nl, &vl, &al, &fl, &vfl, &varargs, &swigmacro, &line, &vline, &nc) != 9)
+      break;			/* included-files tail: hash as-is */
+    p += nc + 1;
+    name = p;
+    p += nl + 1;
+    if (vl >= 0)
+      p += vl + 1;
+    if (fl >= 0)
+      p += fl + 1;
+    if (vfl >= 0)
+      p += vfl + 1;
+    for (i = 0; i < al; i++) {
+      int alen;
+      if (sscanf(p, "%d%n", &alen, &nc) != 1)
+	break;
+      p += nc + 1 + alen + 1;
+    }
+    if (p > end) {
+      p = rec;
+      break;
+    }
+    if (!(nl >= 8 && strncmp(name, "SWIGOPT_", 8) == 0))
+      h = pp_hash(h, rec, (int) (p - rec));
+  }
+  if (p < end)
+    h = pp_hash(h, p, (int) (end - p));
+  return h;
+}
+
+static String *pp_cache_entry(String *fs, int argc, char **argv) {
+  pp_hash_t h = PP_HASH_INIT;
+  String *state = Preprocessor_save_state();
+  List *spath = Swig_search_path();
+  int i;
+  h = pp_hash(h, Char(fs), Len(fs));
+  h = pp_hash_pp_state(h, state);
+  h = pp_hash(h, PACKAGE_VERSION, strlen(PACKAGE_VERSION));
+  for (i = 1; i < argc; i++) {
+    if (!argv[i])
+      continue;
+    /* The input interface (always the last argument) is named inside fs when
+       it matters; leaving it out of the argument hash lets the library
+       prefix entry be shared by every interface in a build */
+    if (i == argc - 1)
+      continue;
+    /* Output locations do not affect the preprocessed text */
+    if (strcmp(argv[i], "-o") == 0 || strcmp(argv[i], "-oh") == 0 || strcmp(argv[i], "-outdir") == 0 || strcmp(argv[i], "-pp-cache") == 0) {
+      i++;
+      continue;
+    }
+    h = pp_hash(h, argv[i], strlen(argv[i]));
+    h = pp_hash(h, "\001", 1);
+  }
+  for (i = 0; i < Len(spath); i++) {
+    String *dir = Getitem(spath, i);
+    h = pp_hash(h, Char(dir), Len(dir));
+    h = pp_hash(h, "\001", 1);
+  }
+  Delete(spath);
+  Delete(state);
+  {
+    char hex[17];
+    sprintf(hex, "%016llx", h);	/* DOH Printf has no %llx */
+    return NewStringf("%s%sswigpp-%s", pp_cache_dir, SWIG_FILE_DELIMITER, hex);
+  }
+}
+
+/* Returns the cached preprocessed interface, or 0 if there is no valid entry */
+static String *pp_cache_load(String *entry) {
+  String *result = 0;
+  char *buffer = 0;
+  char *p, *end, *nl;
+  long size;
+  int nfiles, nc, len, i;
+  FILE *f = fopen(Char(entry), "rb");
+  if (!f)
+    return 0;
+  fseek(f, 0, SEEK_END);
+  size = ftell(f);
+  fseek(f, 0, SEEK_SET);
+  if (size <= 0)
+    goto done;
+  buffer = (char *) DohMalloc(size);
+  if ((long) fread(buffer, 1, size, f) != size)
+    goto done;
+  p = buffer;
+  end = buffer + size;
+  if (sscanf(p, "SWIGPP1 %d%n", &nfiles, &nc) != 1 || p + nc >= end || p[nc] != '\n')
+    goto done;
+  p += nc + 1;
+  for (i = 0; i < nfiles; i++) {
+    pp_hash_t want, got;
+    nl = (char *) memchr(p, '\n', end - p);
+    if (!nl || nl - p < 18)
+      goto done;
+    *nl = 0;
+    if (sscanf(p, "%16llx", &want) != 1)
+      goto done;
+    if (pp_hash_file(p + 17, &got) < 0 || got != want)
+      goto done;
+    p = nl + 1;
+  }
+  if (sscanf(p, "STATE %d%n", &len, &nc) != 1 || p + nc >= end || p[nc] != '\n')
+    goto done;
+  p += nc + 1;
+  if (len < 0 || p + len + 1 > end)
+    goto done;
+  if (Preprocessor_restore_state(p, len) < 0)
+    goto done;
+  p += len + 1;
+  if (sscanf(p, "TEXT %d%n", &len, &nc) != 1 || p + nc >= end || p[nc] != '\n')
+    goto done;
+  p += nc + 1;
+  if (len < 0 || p + len > end)
+    goto done;
+  result = NewStringWithSize(p, len);
+
+done:
+  if (buffer)
+    DohFree(buffer);
+  fclose(f);
+  return result;
+}
+
+/* Record the preprocessed interface and the files it depends on */
+static void pp_cache_save(String *entry, String *pp) {
+  List *files = Preprocessor_depend();
+  String *state = Preprocessor_save_state();
+  int i, ok = 1;
+  FILE *f = fopen(Char(entry), "wb");
+  if (f) {
+    fprintf(f, "SWIGPP1 %d\n", Len(files));
+    for (i = 0; i < Len(files); i++) {
+      String *fn = Getitem(files, i);
+      pp_hash_t h;
+      if (pp_hash_file(Char(fn), &h) < 0) {
+	ok = 0;
+	break;
+      }
+      fprintf(f, "%016llx %s\n", h, Char(fn));
+    }
+    if (ok) {
+      fprintf(f, "STATE %d\n", Len(state));
+      fwrite(Char(state), 1, Len(state), f);
+      fprintf(f, "\nTEXT %d\n", Len(pp));
+      fwrite(Char(pp), 1, Len(pp), f);
+    }
+    fclose(f);
+    if (!ok)
+      remove(Char(entry));
+  }
+  Delete(state);
+}
+
+/* -----------------------------------------------------------------------------
+ * Incremental generation (-incremental)
+ *
+ * A stamp file next to the wrapper records a hash of the preprocessed
+ * interface and the command line, plus the list of files the run produced.
+ * When a later run hashes to the same value and every recorded output still
+ * exists, generation is skipped and the outputs are left untouched.  The
+ * preprocessed text already expands everything the wrappers are generated
+ * from, so the hash changes exactly when a declaration (or an option that
+ * shapes the output) changes.  -incremental implies -write-if-changed, so
+ * even a run that does regenerate only touches the files that differ.
+ * ----------------------------------------------------------------------------- */
+
+static pp_hash_t incremental_hash = 0;
+
+/* Hash the preprocessed interface and the command line for the stamp */
+static pp_hash_t incremental_entry(String *pp, int argc, char **argv) {
+  pp_hash_t h = PP_HASH_INIT;
+  int i;
+  h = pp_hash(h, Char(pp), Len(pp));
+  h = pp_hash(h, PACKAGE_VERSION, strlen(PACKAGE_VERSION));
+  for (i = 1; i < argc; i++) {
+    if (argv[i]) {
+      h = pp_hash(h, argv[i], strlen(argv[i]));
+      h = pp_hash(h, "\001", 1);
+    }
+  }
+  return h;
+}
+
+/* Returns 1 if the stamp matches this invocation and all its outputs exist */
+static int incremental_up_to_date(void) {
+  char line[4096];
+  pp_hash_t h;
+  int ok = 0;
+  FILE *f = fopen(Char(incremental_stamp), "r");
+  if (!f)
+    return 0;
+  if (fgets(line, sizeof line, f) && sscanf(line, "SWIGINC1 %16llx", &h) == 1 && h == incremental_hash) {
+    ok = 1;
+    while (fgets(line, sizeof line, f)) {
+      FILE *out;
+      size_t len = strlen(line);
+      if (len && line[len - 1] == '\n')
+	line[--len] = 0;
+      if (!len)
+	continue;
+      out = fopen(line, "r");
+      if (!out) {
+	ok = 0;
+	break;
+      }
+      fclose(out);
+    }
+  }
+  fclose(f);
+  return ok;
+}
+
+/* Record the invocation hash and the generated files for the next run.  A
+   stamp that cannot be written is not an error; the next run regenerates. */
+static void incremental_save(void) {
+  int i;
+  FILE *f = fopen(Char(incremental_stamp), "w");
+  if (!f)
+    return;
+  fprintf(f, "SWIGINC1 %016llx\n", incremental_hash);
+  for (i = 0; i < Len(all_output_files); i++)
+    fprintf(f, "%s\n", Char(Getitem(all_output_files, i)));
+  fclose(f);
+}
+
 /* -----------------------------------------------------------------------------
  * install_opts()
  *
@@ -500,6 +885,12 @@ static void getoptions(int argc, char *argv[]) {
 	// Undocumented
 	Swig_cparse_cplusplusout(1);
 	Swig_mark_arg(i);
+      } else if (strcmp(argv[i], "-fdedup") == 0) {
+	Wrapper_dedup_mode_set(1);
+	Swig_mark_arg(i);
+      } else if (strcmp(argv[i], "-fpeephole") == 0) {
+	Wrapper_peephole_mode_set(1);
+	Swig_mark_arg(i);
       } else if (strcmp(argv[i], "-fcompact") == 0) {
 	Wrapper_compact_print_mode_set(1);
 	Swig_mark_arg(i);
@@ -551,6 +942,30 @@ static void getoptions(int argc, char *argv[]) {
 	  Swig_mark_arg(i + 1);
 	  i++;
 	}
+      } else if (strcmp(argv[i], "-export-typetab") == 0) {
+	Swig_mark_arg(i);
+	if (argv[i + 1]) {
+	  export_typetab_name = NewString(argv[i + 1]);
+	  Swig_filename_correct(export_typetab_name);
+	  Swig_mark_arg(i + 1);
+	  i++;
+	} else {
+	  Swig_arg_error();
+	}
+      } else if (strcmp(argv[i], "-import-typetab") == 0) {
+	Swig_mark_arg(i);
+	if (argv[i + 1]) {
+	  String *name = NewString(argv[i + 1]);
+	  Swig_filename_correct(name);
+	  if (!import_typetab_names)
+	    import_typetab_names = NewList();
+	  Append(import_typetab_names, name);
+	  Delete(name);
+	  Swig_mark_arg(i + 1);
+	  i++;
+	} else {
+	  Swig_arg_error();
+	}
       } else if ((strcmp(argv[i], "-make_default") == 0) || (strcmp(argv[i], "-makedefault") == 0)) {
 	GenerateDefault = 1;
 	Swig_mark_arg(i);
@@ -599,6 +1014,11 @@ static void getoptions(int argc, char *argv[]) {
 	if (argv[i + 1]) {
 	  outfile_name = NewString(argv[i + 1]);
           Swig_filename_correct(outfile_name);
+	  /* Sending the main output to the null device turns the run into a
+	     validation pass: discard every generated file (including backend
+	     proxy files) instead of creating it */
+	  if (strcmp(argv[i + 1], "/dev/null") == 0 || strcmp(argv[i + 1], "NUL") == 0)
+	    FileDiscardOutputs(1);
 	  if (!outfile_name_h || !dependencies_file) {
 	    char *ext = strrchr(Char(outfile_name), '.');
 	    String *basename = ext ? NewStringWithSize(Char(outfile_name), (int)(Char(ext) - Char(outfile_name))) : NewString(outfile_name);
@@ -759,6 +1179,22 @@ static void getoptions(int argc, char *argv[]) {
 	} else {
 	  Swig_arg_error();
 	}
+      } else if (strcmp(argv[i], "-write-if-changed") == 0) {
+	Swig_mark_arg(i);
+	FileWriteIfChanged(1);
+      } else if (strcmp(argv[i], "-incremental") == 0) {
+	Swig_mark_arg(i);
+	incremental = 1;
+	FileWriteIfChanged(1);
+      } else if (strcmp(argv[i], "-pp-cache") == 0) {
+	Swig_mark_arg(i);
+	if (argv[i + 1]) {
+	  pp_cache_dir = NewString(argv[i + 1]);
+	  Swig_mark_arg(i + 1);
+	  i++;
+	} else {
+	  Swig_arg_error();
+	}
       } else if (strcmp(argv[i], "-outcurrentdir") == 0) {
 	Swig_mark_arg(i);
 	outcurrentdir = 1;
@@ -805,6 +1241,30 @@ static void getoptions(int argc, char *argv[]) {
 	} else {
 	  Swig_arg_error();
 	}
+      } else if (strcmp(argv[i], "-debug-tree-types") == 0) {
+	Swig_mark_arg(i);
+	if (argv[i + 1]) {
+	  tree_filter_types = argv[i + 1];
+	  Swig_mark_arg(i + 1);
+	} else {
+	  Swig_arg_error();
+	}
+      } else if (strcmp(argv[i], "-debug-tree-attrs") == 0) {
+	Swig_mark_arg(i);
+	if (argv[i + 1]) {
+	  tree_filter_attrs = argv[i + 1];
+	  Swig_mark_arg(i + 1);
+	} else {
+	  Swig_arg_error();
+	}
+      } else if (strcmp(argv[i], "-debug-tree-depth") == 0) {
+	Swig_mark_arg(i);
+	if (argv[i + 1]) {
+	  tree_filter_depth = atoi(argv[i + 1]);
+	  Swig_mark_arg(i + 1);
+	} else {
+	  Swig_arg_error();
+	}
       } else if (strcmp(argv[i], "-debug-module") == 0) {
 	Swig_mark_arg(i);
 	if (argv[i + 1]) {
@@ -856,6 +1316,26 @@ static void getoptions(int argc, char *argv[]) {
 	Swig_mark_arg(i);
       } else if ((strcmp(argv[i], "-debug-memory") == 0) || (strcmp(argv[i], "-dump_memory") == 0)) {
 	memory_debug = 1;
+	DohMemoryAccounting(1);
+	Swig_mark_arg(i);
+      } else if (strcmp(argv[i], "-profile") == 0) {
+	profile = 1;
+	Swig_mark_arg(i);
+      } else if (strcmp(argv[i], "-prune-ignored") == 0) {
+	prune_ignored_flag = 1;
+	Swig_mark_arg(i);
+      } else if (strcmp(argv[i], "-prune-symbols") == 0) {
+	Swig_mark_arg(i);
+	if (argv[i + 1]) {
+	  prune_symbols_file = NewString(argv[i + 1]);
+	  Swig_mark_arg(i + 1);
+	  i++;
+	} else {
+	  Swig_arg_error();
+	}
+      } else if (strcmp(argv[i], "-debug-stats") == 0) {
+	stats_debug = 1;
+	Swig_typemap_search_stats_permethod(1);
 	Swig_mark_arg(i);
       } else if (strcmp(argv[i], "-Fstandard") == 0) {
 	Swig_error_msg_format(EMF_STANDARD);
@@ -881,6 +1361,8 @@ static void getoptions(int argc, char *argv[]) {
 
 int SWIG_main(int argc, char *argv[], const TargetLanguageModule *tlm) {
   char *c;
+  clock_t profile_start = clock();
+  clock_t phase_start = profile_start;
 
   /* Initialize the SWIG core */
   Swig_init();
@@ -975,6 +1457,9 @@ int SWIG_main(int argc, char *argv[], const TargetLanguageModule *tlm) {
   // Don't check for an input file if -external-runtime is passed
   Swig_check_options(external_runtime ? 0 : 1);
 
+  if (tree_filter_types || tree_filter_attrs || tree_filter_depth >= 0)
+    Swig_print_tree_filter(tree_filter_types, tree_filter_attrs, tree_filter_depth);
+
   if (CPlusPlus && cparse_cplusplusout) {
     Printf(stderr, "The -c++out option is for C input but C++ input has been requested via -c++\n");
     SWIG_exit(EXIT_FAILURE);
@@ -1055,10 +1540,12 @@ int SWIG_main(int argc, char *argv[], const TargetLanguageModule *tlm) {
     // Run the preprocessor
     if (Verbose)
       Printf(stdout, "Preprocessing...\n");
+    phase_start = clock();
 
     {
       int i;
       String *fs = NewString("");
+      String *pp_cache_file = 0;
       FILE *df = Swig_open(input_file);
       if (!df) {
 	df = Swig_include_open(input_file);
@@ -1082,21 +1569,74 @@ int SWIG_main(int argc, char *argv[], const TargetLanguageModule *tlm) {
 	SWIG_exit(EXIT_FAILURE);
       }
 
+      if (memory_debug)
+	DohMemoryPhase("preprocess");
+
       if (!no_cpp) {
+	String *libfs = NewString("");
+	String *userfs = NewString("");
 	fclose(df);
-	Printf(fs, "%%include <swig.swg>\n");
+	Printf(libfs, "%%include <swig.swg>\n");
 	if (allkw) {
-	  Printf(fs, "%%include <allkw.swg>\n");
+	  Printf(libfs, "%%include <allkw.swg>\n");
 	}
 	if (lang_config) {
-	  Printf(fs, "\n%%include <%s>\n", lang_config);
+	  Printf(libfs, "\n%%include <%s>\n", lang_config);
 	}
-	Printf(fs, "%%include(maininput=\"%s\") \"%s\"\n", Swig_filename_escape(input_file), Swig_filename_escape(Swig_last_file()));
+	Printf(userfs, "%%include(maininput=\"%s\") \"%s\"\n", Swig_filename_escape(input_file), Swig_filename_escape(Swig_last_file()));
 	for (i = 0; i < Len(libfiles); i++) {
-	  Printf(fs, "\n%%include \"%s\"\n", Swig_filename_escape(Getitem(libfiles, i)));
+	  Printf(userfs, "\n%%include \"%s\"\n", Swig_filename_escape(Getitem(libfiles, i)));
 	}
+	Append(fs, libfs);
+	Append(fs, userfs);
 	Seek(fs, 0, SEEK_SET);
-	cpps = Preprocessor_parse(fs);
+	if (pp_cache_dir && !depend) {
+	  pp_cache_file = pp_cache_entry(fs, argc, argv);
+	  cpps = pp_cache_load(pp_cache_file);
+	}
+	if (!cpps && pp_cache_file) {
+	  /* Whole-input miss: the standard library prefix (swig.swg and the
+	     language configuration) is shared by every interface in a build,
+	     so cache its preprocessed text as its own entry.  A hit restores
+	     the macro table and include guards and only the user's interface
+	     is preprocessed. */
+	  String *lib_cache_file = pp_cache_entry(libfs, argc, argv);
+	  String *libpp = pp_cache_load(lib_cache_file);
+	  int libhit = libpp != 0;
+	  if (!libpp) {
+	    Seek(libfs, 0, SEEK_SET);
+	    libpp = Preprocessor_parse(libfs);
+	    if (libpp && !Swig_error_count())
+	      pp_cache_save(lib_cache_file, libpp);
+	  }
+	  if (libpp && !Swig_error_count()) {
+	    String *userpp;
+	    Seek(userfs, 0, SEEK_SET);
+	    userpp = Preprocessor_parse(userfs);
+	    cpps = libpp;
+	    if (userpp) {
+	      Append(cpps, userpp);
+	      Delete(userpp);
+	    }
+	    /* After a library hit the dependency list only covers the user's
+	       files, so a whole-input entry saved now could go stale; skip it
+	       and keep serving this interface from the library entry */
+	    if (!libhit && cpps && !Swig_error_count())
+	      pp_cache_save(pp_cache_file, cpps);
+	  } else {
+	    Delete(libpp);
+	  }
+	  Delete(lib_cache_file);
+	}
+	if (!cpps && !Swig_error_count()) {
+	  Seek(fs, 0, SEEK_SET);
+	  cpps = Preprocessor_parse(fs);
+	  if (pp_cache_file && cpps && !Swig_error_count())
+	    pp_cache_save(pp_cache_file, cpps);
+	}
+	Delete(pp_cache_file);
+	Delete(libfs);
+	Delete(userfs);
 	Delete(fs);
       } else {
 	cpps = Swig_read_file(df);
@@ -1182,6 +1722,23 @@ int SWIG_main(int argc, char *argv[], const TargetLanguageModule *tlm) {
       Seek(cpps, 0, SEEK_SET);
     }
 
+    if (incremental && !no_cpp) {
+      String *inputfile_filename = outcurrentdir ? Swig_file_filename(input_file) : Copy(input_file);
+      String *basename = Swig_file_basename(inputfile_filename);
+      incremental_hash = incremental_entry(cpps, argc, argv);
+      if (outfile_name)
+	incremental_stamp = NewStringf("%s.stamp", outfile_name);
+      else
+	incremental_stamp = NewStringf("%s_wrap.stamp", basename);
+      Delete(inputfile_filename);
+      Delete(basename);
+      if (incremental_up_to_date()) {
+	if (Verbose)
+	  Printf(stdout, "Outputs are up to date, skipping generation.\n");
+	SWIG_exit(EXIT_SUCCESS);
+      }
+    }
+
     /* Register a null file with the file handler */
     Swig_register_filebyname("null", NewString(""));
 
@@ -1191,7 +1748,20 @@ int SWIG_main(int argc, char *argv[], const TargetLanguageModule *tlm) {
       fflush(stdout);
     }
 
+    if (memory_debug)
+      DohMemoryPhase("parse");
+
+    profile_add("preprocess", phase_start);
+    phase_start = clock();
     Node *top = Swig_cparse(cpps);
+    profile_add("parse", phase_start);
+
+    /* The preprocessed text is fully consumed by the parser (the scanner
+       copies token text and drops its reference at EOF), so release it
+       here rather than carrying a translation-unit-sized string through
+       type processing and code generation. */
+    Delete(cpps);
+    cpps = 0;
 
     if (dump_top & STAGE1) {
       Printf(stdout, "debug-top stage 1\n");
@@ -1211,7 +1781,17 @@ int SWIG_main(int argc, char *argv[], const TargetLanguageModule *tlm) {
     if (Verbose) {
       Printf(stdout, "Processing types...\n");
     }
+    if (prune_ignored_flag) {
+      if (Verbose)
+	Printf(stdout, "Pruning ignored declarations...\n");
+      Swig_prune_ignored(top);
+    }
+
+    if (memory_debug)
+      DohMemoryPhase("typepass");
+    phase_start = clock();
     Swig_process_types(top);
+    profile_add("typepass", phase_start);
 
     if (dump_top & STAGE2) {
       Printf(stdout, "debug-top stage 2\n");
@@ -1225,6 +1805,7 @@ int SWIG_main(int argc, char *argv[], const TargetLanguageModule *tlm) {
     if (Verbose) {
       Printf(stdout, "C++ analysis...\n");
     }
+    phase_start = clock();
     Swig_default_allocators(top);
 
     if (CPlusPlus) {
@@ -1232,6 +1813,13 @@ int SWIG_main(int argc, char *argv[], const TargetLanguageModule *tlm) {
 	Printf(stdout, "Processing nested classes...\n");
       Swig_nested_process_classes(top);
     }
+    profile_add("allocate", phase_start);
+
+    if (prune_symbols_file) {
+      if (Verbose)
+	Printf(stdout, "Pruning unreachable declarations...\n");
+      Swig_prune_unused(top, prune_symbols_file);
+    }
 
     if (dump_top & STAGE3) {
       Printf(stdout, "debug-top stage 3\n");
@@ -1323,7 +1911,31 @@ int SWIG_main(int argc, char *argv[], const TargetLanguageModule *tlm) {
 	    tlm->help ? tlm->help : "", tlm->name);
 	}
 
+	if (memory_debug)
+	  DohMemoryPhase("emit");
+
+	if (import_typetab_names) {
+	  for (int ti = 0; ti < Len(import_typetab_names); ti++) {
+	    String *name = Getitem(import_typetab_names, ti);
+	    if (SwigType_import_type_manifest(name) < 0) {
+	      Printf(stderr, "Unable to read type manifest file '%s' - ", name);
+	      FileErrorDisplay(name);
+	      SWIG_exit(EXIT_FAILURE);
+	    }
+	  }
+	}
+
+	phase_start = clock();
 	lang->top(top);
+	profile_add("emit", phase_start);
+
+	if (export_typetab_name) {
+	  if (SwigType_export_type_manifest(export_typetab_name) < 0) {
+	    Printf(stderr, "Unable to write type manifest file '%s' - ", export_typetab_name);
+	    FileErrorDisplay(export_typetab_name);
+	    SWIG_exit(EXIT_FAILURE);
+	  }
+	}
 
 	if (browse) {
 	  Swig_browser(top, 0);
@@ -1352,8 +1964,10 @@ int SWIG_main(int argc, char *argv[], const TargetLanguageModule *tlm) {
   }
   if (tm_debug)
     Swig_typemap_debug();
-  if (memory_debug)
+  if (memory_debug) {
+    DohMemoryPhase(0);		/* report the final phase */
     DohMemoryDebug();
+  }
 
   char *outfiles = getenv("CCACHE_OUTFILES");
   if (outfiles) {
@@ -1385,6 +1999,47 @@ int SWIG_main(int argc, char *argv[], const TargetLanguageModule *tlm) {
   if (error_count != 0)
     SWIG_exit(error_count);
 
+  /* Flush write-if-changed outputs whose file objects stay referenced */
+  CommitAllPendingFiles();
+
+  if (incremental_stamp)
+    incremental_save();
+
+  if (stats_debug) {
+    unsigned long tm_calls, tm_hits, tm_reductions;
+    unsigned long sym_clookup, sym_qualified;
+    unsigned long ty_calls, ty_hits, ty_depth;
+    Swig_typemap_search_stats(&tm_calls, &tm_hits, &tm_reductions);
+    Swig_symbol_lookup_stats(&sym_clookup, &sym_qualified);
+    SwigType_resolve_stats(&ty_calls, &ty_hits, &ty_depth);
+    String *permethod = NewString("");
+    Hash *tm_methods = Swig_typemap_search_stats_methods();
+    if (tm_methods) {
+      List *keys = SortedKeys(tm_methods, Strcmp);
+      Iterator ki;
+      for (ki = First(keys); ki.item; ki = Next(ki)) {
+	Hash *entry = Getattr(tm_methods, ki.item);
+	Printf(permethod, "%s\"%s\": {\"calls\": %d, \"memo_hits\": %d, \"reduction_steps\": %d}",
+	       Len(permethod) ? ", " : "", ki.item, GetInt(entry, "calls"), GetInt(entry, "memo_hits"), GetInt(entry, "reduction_steps"));
+      }
+      Delete(keys);
+    }
+    String *hashtables = NewString("");
+    stats_hash_report(hashtables, "symtabs", Swig_symbol_symtabs());
+    stats_hash_report(hashtables, "global_scope", Swig_symbol_global_scope() ? Getattr(Swig_symbol_global_scope(), "symtab") : 0);
+    stats_hash_report(hashtables, "typemaps", Swig_typemap_registry());
+    Printf(stdout, "{\"typemap_search\": {\"calls\": %lu, \"memo_hits\": %lu, \"reduction_steps\": %lu}, "
+	   "\"typemap_search_methods\": {%s}, "
+	   "\"symbol_clookup\": {\"calls\": %lu, \"qualified_lookups\": %lu}, "
+	   "\"typedef_resolve\": {\"calls\": %lu, \"cache_hits\": %lu, \"resolve_all_max_depth\": %lu}, "
+	   "\"hash_tables\": {%s}}\n",
+	   tm_calls, tm_hits, tm_reductions, permethod, sym_clookup, sym_qualified, ty_calls, ty_hits, ty_depth, hashtables);
+    Delete(permethod);
+    Delete(hashtables);
+  }
+
+  profile_report(profile_start);
+
   return 0;
 }
 
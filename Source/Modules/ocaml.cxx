@@ -531,6 +531,63 @@ public:
     if (classmode && in_constructor) {
       Setattr(seen_constructors, mangled_name, "true");
     }
+
+    /* With %feature("ocaml:unboxed") a float-only global function also gets a
+       pair of raw stubs and an [@@unboxed] [@@noalloc] external, so the fast
+       path bypasses the c_obj boxing entirely.  Functions that do not qualify
+       (non-float arguments, methods, overloads, defaults, more than five
+       arguments) keep only the normal wrapper. */
+    if (GetFlag(n, "feature:ocaml:unboxed") && !classmode && !isOverloaded && !destructor) {
+      int nparms = ParmList_len(l);
+      bool unboxable = nparms >= 1 && nparms <= 5;
+      {
+	SwigType *rt = SwigType_typedef_resolve_all(d);
+	int t = SwigType_type(rt);
+	if (t != T_FLOAT && t != T_DOUBLE)
+	  unboxable = false;
+	Delete(rt);
+      }
+      for (p = l; unboxable && p; p = nextSibling(p)) {
+	SwigType *pt = SwigType_typedef_resolve_all(Getattr(p, "type"));
+	int t = SwigType_type(pt);
+	if ((t != T_FLOAT && t != T_DOUBLE) || Getattr(p, "value"))
+	  unboxable = false;
+	Delete(pt);
+      }
+      if (unboxable) {
+	String *fname = Getattr(n, "name");
+	String *natargs = NewString("");
+	String *natcall = NewString("");
+	String *bcargs = NewString("");
+	String *bccall = NewString("");
+	String *mlsig = NewString("");
+	int argn = 0;
+	for (p = l; p; p = nextSibling(p), argn++) {
+	  String *cast = SwigType_str(Getattr(p, "type"), 0);
+	  Printf(natargs, "%sdouble uarg%d", argn ? ", " : "", argn + 1);
+	  Printf(natcall, "%s(%s)uarg%d", argn ? ", " : "", cast, argn + 1);
+	  Printf(bcargs, "%sCAML_VALUE barg%d", argn ? ", " : "", argn + 1);
+	  Printf(bccall, "%sDouble_val(barg%d)", argn ? ", " : "", argn + 1);
+	  Printf(mlsig, "float -> ");
+	  Delete(cast);
+	}
+	Printf(mlsig, "float");
+	Printv(f_wrappers,
+	       "SWIGEXT double ", wname, "_unboxed (", natargs, ") {\n",
+	       "    return (double)", fname, "(", natcall, ");\n",
+	       "}\n",
+	       "SWIGEXT CAML_VALUE ", wname, "_unboxed_bc (", bcargs, ") {\n",
+	       "    return caml_copy_double(", wname, "_unboxed(", bccall, "));\n",
+	       "}\n\n", NIL);
+	Printf(f_mlbody, "external %s_unboxed : %s = \"%s_unboxed_bc\" \"%s_unboxed\" [@@unboxed] [@@noalloc]\n", mangled_name, mlsig, wname, wname);
+	Printf(f_mlibody, "val %s_unboxed : %s\n", mangled_name, mlsig);
+	Delete(natargs);
+	Delete(natcall);
+	Delete(bcargs);
+	Delete(bccall);
+	Delete(mlsig);
+      }
+    }
     // writing the function wrapper function
     Printv(f->def, "SWIGEXT CAML_VALUE ", wname, " (", NIL);
     Printv(f->def, "CAML_VALUE args", NIL);
@@ -724,10 +781,12 @@ public:
 	int maxargs;
 	Wrapper *df = NewWrapper();
 	String *dispatch = Swig_overload_dispatch(n,
-						  "free(argv);\n" "CAMLreturn(%s(args));\n",
+						  "CAMLreturn(%s(args));\n",
 						  &maxargs);
 
-	Wrapper_add_local(df, "argv", "CAML_VALUE *argv");
+	/* maxargs is known here, so the argument frame can live on the stack
+	   instead of being malloc'd and freed on every dispatch */
+	emit_argument_frame(df, "CAML_VALUE", "argv", maxargs);
 
 	/* Undifferentiate name .. this is the dispatch function */
 	wname = Swig_name_wrapper(iname);
@@ -737,10 +796,8 @@ public:
 
 	Printv(df->def,
 	       "SWIGEXT CAML_VALUE ", wname, "(CAML_VALUE args) {\n" "  CAMLparam1(args);\n" "  int i;\n" "  int argc = caml_list_length(args);\n", NIL);
-	Printv(df->code,
-	       "argv = (CAML_VALUE *)malloc( argc * sizeof( CAML_VALUE ) );\n"
-	       "for( i = 0; i < argc; i++ ) {\n" "  argv[i] = caml_list_nth(args,i);\n" "}\n", NIL);
-	Printv(df->code, dispatch, "\nfree(argv);\n", NIL);
+	Printf(df->code, "for( i = 0; i < argc && i < %d; i++ ) {\n" "  argv[i] = caml_list_nth(args,i);\n" "}\n", maxargs > 0 ? maxargs : 1);
+	Printv(df->code, dispatch, "\n", NIL);
 	Node *sibl = n;
 	while (Getattr(sibl, "sym:previousSibling"))
 	  sibl = Getattr(sibl, "sym:previousSibling");
@@ -21,10 +21,22 @@
 String *argv_template_string;
 String *argc_template_string;
 
+/* Precomputed rank key for one significant (numinputs != 0) parameter.
+ * Looking up and converting the typecheck precedence is done once per
+ * parameter here instead of once per overload pair in the ranking loops
+ * below, which matters for interfaces with many overloads per name. */
+struct RankParm {
+  Parm *p;			/* The parameter                      */
+  String *prec;			/* tmap:typecheck:precedence or NULL  */
+  int prec_val;			/* atoi(prec) when prec is set        */
+};
+
 struct Overloaded {
   Node *n;			/* Node                               */
   int argc;			/* Argument count                     */
   ParmList *parms;		/* Parameters used for overload check */
+  RankParm *rankparms;		/* Significant parms with rank keys   */
+  int nrankparms;		/* Number of entries in rankparms     */
   int error;			/* Ambiguity error                    */
   bool implicitconv_function;	/* For ordering implicitconv functions*/
 };
@@ -67,6 +79,51 @@ static void mark_implicitconv_function(Overloaded& onode) {
   }
 }
 
+/* -----------------------------------------------------------------------------
+ * build_rank_parms()
+ *
+ * Flatten the parameter list into the significant (numinputs != 0) parameters
+ * and record each one's typecheck precedence, so that ranking compares cached
+ * integers rather than repeating the attribute lookups for every overload pair.
+ *
+ * Note there is no per-module type -> precedence table behind this: the
+ * typecheck lookup that produces tmap:typecheck:precedence depends on scope,
+ * parameter name and any %typemap redefinition in effect, so memoizing on the
+ * type alone would be wrong.  The search itself is already cached at the
+ * right granularity in Swig/typemap.c (typemap_search_cache, invalidated on
+ * typemap registration and type system changes), which is what keeps the
+ * per-wrapper attach cheap.
+ * ----------------------------------------------------------------------------- */
+static void build_rank_parms(Overloaded &onode) {
+  int count = 0;
+  Parm *p = onode.parms;
+  while (p) {
+    if (checkAttribute(p, "tmap:in:numinputs", "0")) {
+      p = Getattr(p, "tmap:in:next");
+      continue;
+    }
+    count++;
+    Parm *np = Getattr(p, "tmap:in:next");
+    p = np ? np : nextSibling(p);
+  }
+  onode.nrankparms = count;
+  onode.rankparms = count ? new RankParm[count] : 0;
+  count = 0;
+  p = onode.parms;
+  while (p) {
+    if (checkAttribute(p, "tmap:in:numinputs", "0")) {
+      p = Getattr(p, "tmap:in:next");
+      continue;
+    }
+    RankParm &rp = onode.rankparms[count++];
+    rp.p = p;
+    rp.prec = Getattr(p, "tmap:typecheck:precedence");
+    rp.prec_val = rp.prec ? atoi(Char(rp.prec)) : 0;
+    Parm *np = Getattr(p, "tmap:in:next");
+    p = np ? np : nextSibling(p);
+  }
+}
+
 /* -----------------------------------------------------------------------------
  * Swig_overload_rank()
  *
@@ -114,6 +171,7 @@ List *Swig_overload_rank(Node *n, bool script_lang_wrapping) {
       nodes[nnodes].error = 0;
       nodes[nnodes].implicitconv_function = false;
 
+      build_rank_parms(nodes[nnodes]);
       mark_implicitconv_function(nodes[nnodes]);
       nnodes++;
     }
@@ -140,22 +198,20 @@ List *Swig_overload_rank(Node *n, bool script_lang_wrapping) {
     for (i = 0; i < nnodes - 1; i++) {
       if (nodes[i].argc == nodes[i + 1].argc) {
 	for (j = i + 1; (j < nnodes) && (nodes[j].argc == nodes[i].argc); j++) {
-	  Parm *p1 = nodes[i].parms;
-	  Parm *p2 = nodes[j].parms;
+	  /* Keep following the same two parameter streams even if the nodes
+	     are swapped below, just as the original parm pointers would */
+	  RankParm *rp1 = nodes[i].rankparms;
+	  RankParm *rp2 = nodes[j].rankparms;
+	  int n1 = nodes[i].nrankparms;
+	  int n2 = nodes[j].nrankparms;
 	  int differ = 0;
 	  int num_checked = 0;
-	  while (p1 && p2 && (num_checked < nodes[i].argc)) {
+	  while ((num_checked < n1) && (num_checked < n2) && (num_checked < nodes[i].argc)) {
+	    Parm *p1 = rp1[num_checked].p;
+	    Parm *p2 = rp2[num_checked].p;
 	    //    Printf(stdout,"p1 = '%s', p2 = '%s'\n", Getattr(p1,"type"), Getattr(p2,"type"));
-	    if (checkAttribute(p1, "tmap:in:numinputs", "0")) {
-	      p1 = Getattr(p1, "tmap:in:next");
-	      continue;
-	    }
-	    if (checkAttribute(p2, "tmap:in:numinputs", "0")) {
-	      p2 = Getattr(p2, "tmap:in:next");
-	      continue;
-	    }
-	    String *t1 = Getattr(p1, "tmap:typecheck:precedence");
-	    String *t2 = Getattr(p2, "tmap:typecheck:precedence");
+	    String *t1 = rp1[num_checked].prec;
+	    String *t2 = rp2[num_checked].prec;
 	    if ((!t1) && (!nodes[i].error)) {
 	      Swig_warning(WARN_TYPEMAP_TYPECHECK, Getfile(nodes[i].n), Getline(nodes[i].n),
 			   "Overloaded method %s not supported (incomplete type checking rule - no precedence level in typecheck typemap for '%s').\n",
@@ -168,10 +224,7 @@ List *Swig_overload_rank(Node *n, bool script_lang_wrapping) {
 	      nodes[j].error = 1;
 	    }
 	    if (t1 && t2) {
-	      int t1v, t2v;
-	      t1v = atoi(Char(t1));
-	      t2v = atoi(Char(t2));
-	      differ = t1v - t2v;
+	      differ = rp1[num_checked].prec_val - rp2[num_checked].prec_val;
 	    } else if (!t1 && t2)
 	      differ = 1;
 	    else if (t1 && !t2)
@@ -220,16 +273,6 @@ List *Swig_overload_rank(Node *n, bool script_lang_wrapping) {
 	    } else if (differ) {
 	      break;
 	    }
-	    if (Getattr(p1, "tmap:in:next")) {
-	      p1 = Getattr(p1, "tmap:in:next");
-	    } else {
-	      p1 = nextSibling(p1);
-	    }
-	    if (Getattr(p2, "tmap:in:next")) {
-	      p2 = Getattr(p2, "tmap:in:next");
-	    } else {
-	      p2 = nextSibling(p2);
-	    }
 	  }
 	  if (!differ) {
 	    /* See if declarations differ by const only */
@@ -357,6 +400,11 @@ List *Swig_overload_rank(Node *n, bool script_lang_wrapping) {
       }
     }
   }
+  {
+    int i;
+    for (i = 0; i < nnodes; i++)
+      delete[] nodes[i].rankparms;
+  }
   return result;
 }
 
@@ -789,70 +837,105 @@ String *Swig_overload_dispatch(Node *n, const_String_or_char_ptr fmt, int *maxar
 
   /* Loop over the functions */
 
-  for (i = 0; i < nfunc; i++) {
+  for (i = 0; i < nfunc;) {
     Node *ni = Getitem(dispatch, i);
     Parm *pi = Getattr(ni, "wrap:parms");
-    bool implicitconvtypecheckoff = GetFlag(ni, "implicitconvtypecheckoff") != 0;
     int num_required = emit_num_required(pi);
     int num_arguments = emit_num_arguments(pi);
     if (GetFlag(n, "wrap:this")) {
       num_required++;
       num_arguments++;
     }
-    if (num_arguments > *maxargs)
-      *maxargs = num_arguments;
 
+    /* Count the run of candidates taking exactly this many arguments so that
+       the argument count is tested once for the whole group instead of once
+       per candidate.  Candidates with default arguments cover a range of
+       argument counts and are dispatched individually as before. */
+    int group = 1;
     if (num_required == num_arguments) {
+      while (i + group < nfunc) {
+	Parm *pg = Getattr(Getitem(dispatch, i + group), "wrap:parms");
+	int nrg = emit_num_required(pg);
+	int nag = emit_num_arguments(pg);
+	if (GetFlag(n, "wrap:this")) {
+	  nrg++;
+	  nag++;
+	}
+	if (!(nrg == nag && nrg == num_required))
+	  break;
+	group++;
+      }
       Printf(f, "if (%s == %d) {\n", argc_template_string, num_required);
     } else {
       Printf(f, "if ((%s >= %d) && (%s <= %d)) {\n", argc_template_string, num_required, argc_template_string, num_arguments);
     }
 
-    if (num_arguments) {
-      Printf(f, "int _v = 0;\n");
-    }
-
-    int num_braces = 0;
-    j = 0;
-    Parm *pj = pi;
-    while (pj) {
-      if (checkAttribute(pj, "tmap:in:numinputs", "0")) {
-	pj = Getattr(pj, "tmap:in:next");
-	continue;
-      }
-      if (j >= num_required) {
-	String *lfmt = ReplaceFormat(fmt, num_arguments);
-	Printf(f, "if (%s <= %d) {\n", argc_template_string, j);
-	Printf(f, Char(lfmt), Getattr(ni, "wrap:name"));
-	Printf(f, "}\n");
-	Delete(lfmt);
+    int g;
+    for (g = 0; g < group; g++) {
+      ni = Getitem(dispatch, i + g);
+      pi = Getattr(ni, "wrap:parms");
+      bool implicitconvtypecheckoff = GetFlag(ni, "implicitconvtypecheckoff") != 0;
+      num_required = emit_num_required(pi);
+      num_arguments = emit_num_arguments(pi);
+      if (GetFlag(n, "wrap:this")) {
+	num_required++;
+	num_arguments++;
       }
-      if (print_typecheck(f, (GetFlag(n, "wrap:this") ? j + 1 : j), pj, implicitconvtypecheckoff)) {
-	Printf(f, "if (_v) {\n");
-	num_braces++;
+      if (num_arguments > *maxargs)
+	*maxargs = num_arguments;
+
+      if (group > 1)
+	Printf(f, "{\n");	/* scope for this candidate's _v */
+
+      if (num_arguments) {
+	Printf(f, "int _v = 0;\n");
       }
-      if (!Getattr(pj, "tmap:in:SWIGTYPE") && Getattr(pj, "tmap:typecheck:SWIGTYPE")) {
-	/* we emit  a warning if the argument defines the 'in' typemap, but not the 'typecheck' one */
-	Swig_warning(WARN_TYPEMAP_TYPECHECK_UNDEF, Getfile(ni), Getline(ni),
-		     "Overloaded method %s with no explicit typecheck typemap for arg %d of type '%s'\n",
-		     Swig_name_decl(n), j, SwigType_str(Getattr(pj, "type"), 0));
+
+      int num_braces = 0;
+      j = 0;
+      Parm *pj = pi;
+      while (pj) {
+	if (checkAttribute(pj, "tmap:in:numinputs", "0")) {
+	  pj = Getattr(pj, "tmap:in:next");
+	  continue;
+	}
+	if (j >= num_required) {
+	  String *lfmt = ReplaceFormat(fmt, num_arguments);
+	  Printf(f, "if (%s <= %d) {\n", argc_template_string, j);
+	  Printf(f, Char(lfmt), Getattr(ni, "wrap:name"));
+	  Printf(f, "}\n");
+	  Delete(lfmt);
+	}
+	if (print_typecheck(f, (GetFlag(n, "wrap:this") ? j + 1 : j), pj, implicitconvtypecheckoff)) {
+	  Printf(f, "if (_v) {\n");
+	  num_braces++;
+	}
+	if (!Getattr(pj, "tmap:in:SWIGTYPE") && Getattr(pj, "tmap:typecheck:SWIGTYPE")) {
+	  /* we emit  a warning if the argument defines the 'in' typemap, but not the 'typecheck' one */
+	  Swig_warning(WARN_TYPEMAP_TYPECHECK_UNDEF, Getfile(ni), Getline(ni),
+		       "Overloaded method %s with no explicit typecheck typemap for arg %d of type '%s'\n",
+		       Swig_name_decl(n), j, SwigType_str(Getattr(pj, "type"), 0));
+	}
+	Parm *pk = Getattr(pj, "tmap:in:next");
+	if (pk)
+	  pj = pk;
+	else
+	  pj = nextSibling(pj);
+	j++;
       }
-      Parm *pk = Getattr(pj, "tmap:in:next");
-      if (pk)
-	pj = pk;
-      else
-	pj = nextSibling(pj);
-      j++;
+      String *lfmt = ReplaceFormat(fmt, num_arguments);
+      Printf(f, Char(lfmt), Getattr(ni, "wrap:name"));
+      Delete(lfmt);
+      /* close braces */
+      for ( /* empty */ ; num_braces > 0; num_braces--)
+	Printf(f, "}\n");
+      if (group > 1)
+	Printf(f, "}\n");	/* closes this candidate's scope */
+      if (implicitconvtypecheckoff)
+	Delattr(ni, "implicitconvtypecheckoff");
     }
-    String *lfmt = ReplaceFormat(fmt, num_arguments);
-    Printf(f, Char(lfmt), Getattr(ni, "wrap:name"));
-    Delete(lfmt);
-    /* close braces */
-    for ( /* empty */ ; num_braces > 0; num_braces--)
-      Printf(f, "}\n");
-    Printf(f, "}\n");		/* braces closes "if" for this method */
-    if (implicitconvtypecheckoff)
-      Delattr(ni, "implicitconvtypecheckoff");
+    Printf(f, "}\n");		/* braces closes "if" for this group */
+    i += group;
   }
   Delete(dispatch);
   return f;
@@ -19,6 +19,7 @@ static const char *usage = "\
 Perl 5 Options (available with -perl5)\n\
      -compat         - Compatibility mode\n\
      -const          - Wrap constants as constants and not variables (implies -proxy)\n\
+     -autoloadconst  - Install constants on first access via AUTOLOAD instead of at module load\n\
      -nopm           - Do not generate the .pm file\n\
      -noproxy        - Don't create proxy classes\n\
      -proxy          - Create proxy classes\n\
@@ -94,6 +95,7 @@ static int          verbose = 0;
 
 static int blessed = 1;		/* Enable object oriented features */
 static int do_constants = 0;	/* Constant wrapping */
+static int lazy_constants = 0;	/* Install constants on first access instead of at boot */
 static List *classlist = 0;	/* List of classes */
 static int have_constructor = 0;
 static int have_destructor = 0;
@@ -107,6 +109,7 @@ static String *pcode = 0;	/* Perl code associated with each class */
 static int member_func = 0;	/* Set to 1 when wrapping a member function */
 static String *func_stubs = 0;	/* Function stubs */
 static String *const_stubs = 0;	/* Constant stubs */
+static String *lazy_const_code = 0;	/* Constant installation code deferred by -autoloadconst */
 static int num_consts = 0;	/* Number of constants */
 static String *var_stubs = 0;	/* Variable stubs */
 static String *exported = 0;	/* Exported symbols */
@@ -175,6 +178,9 @@ public:
 	  do_constants = 1;
 	  blessed = 1;
 	  Swig_mark_arg(i);
+	} else if (strcmp(argv[i], "-autoloadconst") == 0) {
+	  lazy_constants = 1;
+	  Swig_mark_arg(i);
 	} else if (strcmp(argv[i], "-nopm") == 0) {
 	  no_pmfile = 1;
 	  Swig_mark_arg(i);
@@ -308,6 +314,7 @@ public:
     func_stubs = NewString("");
     var_stubs = NewString("");
     const_stubs = NewString("");
+    lazy_const_code = NewString("");
     exported = NewString("");
     magic = NewString("");
     pragma_include = NewString("");
@@ -501,6 +508,23 @@ public:
     Printf(f_wrappers, "%s", type_table);
     Delete(type_table);
 
+    if (lazy_constants) {
+      /* Emit the deferred constant installation code as an ordinary XSUB so
+         that it runs with a thread context; it is registered through the
+         command table and invoked from the AUTOLOAD stub in the .pm file */
+      String *lazy_wrap = NewString("");
+      Printf(lazy_wrap, "XS(_swig_wrap_install_constants) {\n");
+      Printf(lazy_wrap, "dXSARGS;\n");
+      Printf(lazy_wrap, "(void) items;\n");
+      Printv(lazy_wrap, lazy_const_code, NIL);
+      Printf(lazy_wrap, "ST(0) = &PL_sv_yes;\n");
+      Printf(lazy_wrap, "XSRETURN(1);\n");
+      Printf(lazy_wrap, "}\n");
+      Wrapper_pretty_print(lazy_wrap, f_wrappers);
+      Delete(lazy_wrap);
+      Printf(command_tab, "{\"%s::_swig_install_constants\", _swig_wrap_install_constants},\n", cmodule);
+    }
+
     Printf(constant_tab, "{0,0,0,0,0,0}\n};\n");
     Printv(f_wrappers, constant_tab, NIL);
 
@@ -592,7 +616,7 @@ public:
       /* Emit package code for different classes */
       Printf(f_pm, "%s", pm);
 
-      if (num_consts > 0) {
+      if (num_consts > 0 && !lazy_constants) {
 	/* Emit constant stubs */
 	Printf(f_pm, "\n# ------- CONSTANT STUBS -------\n\n");
 	Printf(f_pm, "package %s;\n\n", namespace_module);
@@ -606,6 +630,33 @@ public:
       Printf(f_pm, "%s", var_stubs);
     }
 
+    if (lazy_constants) {
+      /* Install the whole constant table on the first access to any constant.
+         Constants are reached with function syntax (Module::NAME()); the
+         generated stub is then memoized so later calls bypass AUTOLOAD. */
+      Printf(f_pm, "\n# ------- LAZY CONSTANTS -------\n\n");
+      Printf(f_pm, "package %s;\n\n", namespace_module);
+      Printv(f_pm,
+	     "my $_swig_constants_installed = 0;\n",
+	     "sub AUTOLOAD {\n",
+	     tab4, "my $constname;\n",
+	     tab4, "($constname = $AUTOLOAD) =~ s/.*:://;\n",
+	     tab4, "return if $constname eq 'DESTROY';\n",
+	     tab4, "if (!$_swig_constants_installed) {\n",
+	     tab8, cmodule, "::_swig_install_constants();\n",
+	     tab8, "$_swig_constants_installed = 1;\n",
+	     tab4, "}\n",
+	     tab4, "my $val = do { no strict 'refs'; ${\"", cmodule, "::$constname\"} };\n",
+	     tab4, "if (!defined $val) {\n",
+	     tab8, "require Carp;\n",
+	     tab8, "Carp::croak(\"Undefined subroutine &$AUTOLOAD called\");\n",
+	     tab4, "}\n",
+	     tab4, "no strict 'refs';\n",
+	     tab4, "*$AUTOLOAD = sub () { $val };\n",
+	     tab4, "goto &$AUTOLOAD;\n",
+	     "}\n", NIL);
+    }
+
     /* Add additional Perl code at the end */
     Printf(f_pm, "%s", additional_perl_code);
 
@@ -1110,7 +1161,9 @@ public:
       } else {
 	Replaceall(tm, "$shadow", "0");
       }
-      Printf(f_init, "%s\n", tm);
+      /* With -autoloadconst the installation code is collected into a separate
+         XSUB run on first constant access rather than at module load */
+      Printf(lazy_constants ? lazy_const_code : f_init, "%s\n", tm);
     } else {
       Swig_warning(WARN_TYPEMAP_CONST_UNDEF, input_file, line_number, "Unsupported constant value.\n");
       return SWIG_NOWRAP;
@@ -28,6 +28,10 @@ PHP Options (available with -php7)\n\
 // Wrap as global PHP names.
 static bool wrap_nonclass_global = true;
 
+/* Index of the next director method in the per-instance dispatch cache
+ * (Swig::Director::swig_get_method); reset for each director class. */
+static int director_method_index = 0;
+
 // Wrap in a class to fake a namespace (for compatibility with SWIG's behaviour
 // before PHP added namespaces.
 static bool wrap_nonclass_fake_class = true;
@@ -1640,7 +1644,9 @@ public:
 	  Printv(r_init_prefix,
 		 "#ifndef SWIG_PHP_INTERFACE_", interface, "_CE\n",
 		 "  {\n",
-		 "    zend_class_entry *swig_interface_ce = zend_lookup_class(zend_string_init(\"", interface, "\", sizeof(\"", interface, "\") - 1, 0));\n",
+		 "    zend_string *swig_interface_name = zend_string_init(\"", interface, "\", sizeof(\"", interface, "\") - 1, 0);\n",
+		 "    zend_class_entry *swig_interface_ce = zend_lookup_class(swig_interface_name);\n",
+		 "    zend_string_release(swig_interface_name);\n",
 		 "    if (!swig_interface_ce) zend_throw_exception(zend_ce_error, \"Interface \\\"", interface, "\\\" not found\", 0);\n",
 		 "    zend_do_implement_interface(SWIGTYPE_", class_name, "_ce, swig_interface_ce);\n",
 		 "  }\n",
@@ -1826,6 +1832,7 @@ public:
   }
 
   int classDirectorInit(Node *n) {
+    director_method_index = 0;
     String *declaration = Swig_director_declaration(n);
     Printf(f_directors_h, "%s\n", declaration);
     Printf(f_directors_h, "public:\n");
@@ -2076,9 +2083,14 @@ public:
       Printf(w->code, "ZVAL_STRINGL(&swig_funcname, \"%s\", %d);\n", funcname, strlen(funcname));
       Printf(w->code, "call_user_function(EG(function_table), &swig_self, &swig_funcname, &swig_zval_result, %d, args);\n", idx);
       Append(w->code, "#else\n");
-      Printf(w->code, "zend_string *swig_funcname = zend_string_init(\"%s\", %d, 0);\n", funcname, strlen(funcname));
-      Append(w->code, "zend_function *swig_zend_func = zend_std_get_method(&Z_OBJ(swig_self), swig_funcname, NULL);\n");
-      Append(w->code, "zend_string_release(swig_funcname);\n");
+      // Intern the method name once per process instead of building a
+      // zend_string on every upcall.  The lookup with an interned string is
+      // also cheaper as the hash value is precomputed.  A racing second
+      // initialisation under ZTS is harmless - interning returns the same
+      // string.
+      Printf(w->code, "static zend_string *swig_funcname = NULL;\n");
+      Printf(w->code, "if (!swig_funcname) swig_funcname = zend_string_init_interned(\"%s\", %d, 1);\n", funcname, strlen(funcname));
+      Printf(w->code, "zend_function *swig_zend_func = swig_get_method(%d, swig_funcname);\n", director_method_index++);
       Printf(w->code, "if (swig_zend_func) zend_call_known_instance_method(swig_zend_func, Z_OBJ(swig_self), &swig_zval_result, %d, args);\n", idx);
       Append(w->code, "#endif\n");
 
@@ -0,0 +1,404 @@
+/* -----------------------------------------------------------------------------
+ * This file is part of SWIG, which is licensed as a whole under version 3
+ * (or any later version) of the GNU General Public License. Some additional
+ * terms also apply to certain portions of SWIG. The full details of the SWIG
+ * license and copyrights can be found in the LICENSE and COPYRIGHT files
+ * included with the SWIG source code as distributed by the SWIG developers
+ * and at http://www.swig.org/legal.html.
+ *
+ * prune.cxx
+ *
+ * Dead-wrapper elimination (-prune-symbols <file>).  Interfaces that wrap an
+ * entire vendor header often only need a small slice of it.  Given a file
+ * listing the entry symbols an application actually uses, this pass computes
+ * the set of declarations reachable from those entries - through parameter
+ * and return types and through the class hierarchy recorded by the type
+ * pass - and marks everything else with feature:ignore so that no wrapper,
+ * proxy method or supporting fragment is generated for it.  It runs after
+ * the type pass (which fully qualifies types and attaches base class links)
+ * and before the language module.
+ * ----------------------------------------------------------------------------- */
+
+#include "swigmod.h"
+
+static Hash *prune_classes = 0;	/* class name (and sym:name) -> class node */
+static Hash *prune_entries = 0;	/* symbols requested in the entry file */
+static List *prune_worklist = 0;	/* class nodes still to be kept in full */
+static int prune_count = 0;
+
+/* Keep a class and everything needed to use it.  The actual work happens
+   when the worklist is drained, so that mutually referencing classes
+   terminate. */
+static void keep_class(Node *cls) {
+  if (!cls || Getattr(cls, "prune:keep"))
+    return;
+  SetFlag(cls, "prune:keep");
+  Append(prune_worklist, cls);
+}
+
+/* Resolve a type down to its base name and keep the class it refers to,
+   if any.  Typedefs were already collected by the type pass, so the
+   resolved name matches the class node's fully qualified name. */
+static void keep_type(const SwigType *ty) {
+  if (!ty)
+    return;
+  SwigType *resolved = SwigType_typedef_resolve_all(ty);
+  String *base = SwigType_base(resolved);
+  Node *cls = Getattr(prune_classes, base);
+  if (cls)
+    keep_class(cls);
+  Delete(base);
+  Delete(resolved);
+}
+
+/* Keep the classes appearing in a declaration's signature */
+static void keep_signature(Node *n) {
+  keep_type(Getattr(n, "type"));
+  for (Parm *p = Getattr(n, "parms"); p; p = nextSibling(p)) {
+    keep_type(Getattr(p, "type"));
+  }
+}
+
+/* Mark one member as kept and chase the types it mentions */
+static void keep_member(Node *n) {
+  if (Getattr(n, "prune:keep"))
+    return;
+  SetFlag(n, "prune:keep");
+  keep_signature(n);
+}
+
+/* Keep all members of a class (recursing into %extend blocks) */
+static void keep_members(Node *cls) {
+  for (Node *c = firstChild(cls); c; c = nextSibling(c)) {
+    String *ntype = nodeType(c);
+    if (Equal(ntype, "extend")) {
+      keep_members(c);
+    } else if (Equal(ntype, "cdecl") || Equal(ntype, "constructor") || Equal(ntype, "destructor")) {
+      keep_member(c);
+    }
+  }
+}
+
+/* Drain the worklist: each kept class pulls in its base classes and the
+   classes referenced from its member signatures */
+static void process_worklist(void) {
+  for (int i = 0; i < Len(prune_worklist); i++) {
+    Node *cls = Getitem(prune_worklist, i);
+    keep_members(cls);
+    List *bases = Getattr(cls, "bases");
+    if (bases) {
+      for (Iterator b = First(bases); b.item; b = Next(b)) {
+	keep_class(b.item);
+      }
+    }
+  }
+}
+
+/* Record the classes of the whole interface, keyed by both the fully
+   qualified name and the target language symbol name */
+static void collect_classes(Node *n) {
+  for (Node *c = firstChild(n); c; c = nextSibling(c)) {
+    String *ntype = nodeType(c);
+    if (Equal(ntype, "class")) {
+      String *name = Getattr(c, "name");
+      String *symname = Getattr(c, "sym:name");
+      if (name)
+	Setattr(prune_classes, name, c);
+      if (symname && !Getattr(prune_classes, symname))
+	Setattr(prune_classes, symname, c);
+    }
+    if (firstChild(c))
+      collect_classes(c);
+  }
+}
+
+/* Does the entry file mention this declaration?  Global declarations match
+   on their symbol name, their C name or the namespace qualified C name;
+   members additionally match as Class::member. */
+static int entry_matches(Node *n, String *prefix) {
+  String *symname = Getattr(n, "sym:name");
+  String *name = Getattr(n, "name");
+  if (symname && Getattr(prune_entries, symname))
+    return 1;
+  if (name && Getattr(prune_entries, name))
+    return 1;
+  if (prefix && Len(prefix) > 0) {
+    String *qualified = 0;
+    if (symname) {
+      qualified = NewStringf("%s::%s", prefix, symname);
+      int hit = Getattr(prune_entries, qualified) != 0;
+      Delete(qualified);
+      if (hit)
+	return 1;
+    }
+    if (name) {
+      qualified = NewStringf("%s::%s", prefix, name);
+      int hit = Getattr(prune_entries, qualified) != 0;
+      Delete(qualified);
+      if (hit)
+	return 1;
+    }
+  }
+  return 0;
+}
+
+/* Seed the keep set from the entry file.  A listed class is kept in full;
+   a listed Class::member keeps the class shell, its constructors and
+   destructors and just that member; listed functions and variables keep
+   themselves and whatever their signatures reach. */
+static void seed_class(Node *cls, String *prefix) {
+  String *name = Getattr(cls, "name");
+  String *symname = Getattr(cls, "sym:name");
+  if (entry_matches(cls, prefix)) {
+    keep_class(cls);
+    return;
+  }
+  String *clsprefix = name ? name : symname;
+  for (Node *c = firstChild(cls); c; c = nextSibling(c)) {
+    String *ntype = nodeType(c);
+    if (Equal(ntype, "extend")) {
+      seed_class(c, clsprefix);
+    } else if (Equal(ntype, "cdecl")) {
+      if (entry_matches(c, clsprefix) || (symname && !Equal(clsprefix, symname) && entry_matches(c, symname))) {
+	if (!Getattr(cls, "prune:partial")) {
+	  SetFlag(cls, "prune:partial");
+	  List *bases = Getattr(cls, "bases");
+	  if (bases) {
+	    for (Iterator b = First(bases); b.item; b = Next(b)) {
+	      keep_class(b.item);
+	    }
+	  }
+	}
+	keep_member(c);
+      }
+    }
+  }
+}
+
+static void seed(Node *n, String *prefix) {
+  for (Node *c = firstChild(n); c; c = nextSibling(c)) {
+    String *ntype = nodeType(c);
+    if (Equal(ntype, "class")) {
+      seed_class(c, prefix);
+    } else if (Equal(ntype, "namespace")) {
+      String *nsname = Getattr(c, "name");
+      String *nsprefix = (prefix && Len(prefix) > 0) ? NewStringf("%s::%s", prefix, nsname) : Copy(nsname);
+      seed(c, nsprefix);
+      Delete(nsprefix);
+    } else if (Equal(ntype, "cdecl")) {
+      if (entry_matches(c, prefix))
+	keep_member(c);
+    } else if (firstChild(c)) {
+      seed(c, prefix);
+    }
+  }
+}
+
+/* Hide everything that was not kept.  Only nodes that would produce a
+   wrapper are touched: classes, and function or variable declarations.
+   Typedefs, enums, constants and inserts are left alone - they are cheap
+   and other kept declarations may depend on them. */
+static int prunable_cdecl(Node *n) {
+  if (Getattr(n, "prune:keep"))
+    return 0;
+  if (GetFlag(n, "feature:ignore"))
+    return 0;
+  String *storage = Getattr(n, "storage");
+  if (storage && (Equal(storage, "typedef") || Equal(storage, "friend")))
+    return 0;
+  return 1;
+}
+
+static void prune_members(Node *cls) {
+  for (Node *c = firstChild(cls); c; c = nextSibling(c)) {
+    String *ntype = nodeType(c);
+    if (Equal(ntype, "extend")) {
+      prune_members(c);
+    } else if (Equal(ntype, "cdecl")) {
+      if (prunable_cdecl(c)) {
+	SetFlag(c, "feature:ignore");
+	prune_count++;
+      }
+    }
+  }
+}
+
+static void prune(Node *n) {
+  for (Node *c = firstChild(n); c; c = nextSibling(c)) {
+    String *ntype = nodeType(c);
+    if (Equal(ntype, "class")) {
+      if (Getattr(c, "prune:keep")) {
+	/* kept in full */
+      } else if (Getattr(c, "prune:partial")) {
+	prune_members(c);
+      } else if (!GetFlag(c, "feature:ignore")) {
+	SetFlag(c, "feature:ignore");
+	prune_count++;
+      }
+    } else if (Equal(ntype, "cdecl")) {
+      if (prunable_cdecl(c)) {
+	SetFlag(c, "feature:ignore");
+	prune_count++;
+      }
+    } else if (firstChild(c)) {
+      prune(c);
+    }
+  }
+}
+
+/* -----------------------------------------------------------------------------
+ * Swig_prune_unused()
+ *
+ * Entry point.  The entry file lists one symbol per line; blank lines and
+ * lines starting with '#' are skipped.
+ * ----------------------------------------------------------------------------- */
+
+void Swig_prune_unused(Node *top, String *entryfile) {
+  FILE *f = fopen(Char(entryfile), "r");
+  if (!f) {
+    Printf(stderr, "Unable to open entry symbol file '%s'\n", entryfile);
+    SWIG_exit(EXIT_FAILURE);
+  }
+  prune_entries = NewHash();
+  char line[512];
+  while (fgets(line, sizeof(line), f)) {
+    char *s = line;
+    while (*s == ' ' || *s == '\t')
+      s++;
+    char *e = s + strlen(s);
+    while (e > s && (e[-1] == '\n' || e[-1] == '\r' || e[-1] == ' ' || e[-1] == '\t'))
+      *--e = '\0';
+    if (*s && *s != '#')
+      Setattr(prune_entries, s, "1");
+  }
+  fclose(f);
+
+  prune_classes = NewHash();
+  prune_worklist = NewList();
+  prune_count = 0;
+
+  collect_classes(top);
+  seed(top, 0);
+  process_worklist();
+  prune(top);
+
+  if (Verbose)
+    Printf(stdout, "Pruned %d declarations not reachable from %d entry symbols.\n", prune_count, Len(Keys(prune_entries)));
+
+  Delete(prune_worklist);
+  Delete(prune_classes);
+  Delete(prune_entries);
+  prune_worklist = 0;
+  prune_classes = 0;
+  prune_entries = 0;
+}
+
+/* -----------------------------------------------------------------------------
+ * Swig_prune_ignored()
+ *
+ * Early %ignore pruning (-prune-ignored).  Ignored declarations are normally
+ * parsed, typed and carried through the type pass before the language module
+ * skips them, which is wasted work when an interface %ignores entire
+ * implementation headers.  This pass physically removes ignored subtrees
+ * right after parsing, before the type pass runs.  Only removals that cannot
+ * change the meaning of the remaining interface are performed:
+ *
+ *  - an ignored class is dropped only when no other class in the parse tree
+ *    names it as a base, so inheritance processing and its diagnostics are
+ *    unaffected.  An ignored class referenced from a signature is wrapped
+ *    as an opaque pointer either way, and the typedef resolution tables
+ *    were already built by the parser;
+ *  - ignored file-scope functions and variables are dropped unless they sit
+ *    in an overload chain.  Typedefs and friends always stay.
+ *
+ * Ignored class members are deliberately left in place: they still decide
+ * abstractness of the class they belong to.
+ * ----------------------------------------------------------------------------- */
+
+static Hash *prune_basenames = 0;	/* names appearing in any class's base list */
+
+/* Record every name any class derives from, as written in the source */
+static void collect_basenames(Node *n) {
+  for (Node *c = firstChild(n); c; c = nextSibling(c)) {
+    String *ntype = nodeType(c);
+    if (Equal(ntype, "class")) {
+      static const char *const lists[] = { "baselist", "protectedbaselist", "privatebaselist" };
+      for (size_t i = 0; i < sizeof(lists) / sizeof(lists[0]); i++) {
+	List *bl = Getattr(c, lists[i]);
+	if (bl) {
+	  for (Iterator b = First(bl); b.item; b = Next(b)) {
+	    Setattr(prune_basenames, b.item, "1");
+	  }
+	}
+      }
+    }
+    if (firstChild(c))
+      collect_basenames(c);
+  }
+}
+
+/* Is this class named as somebody's base?  Base lists hold the names as
+   written, so check the qualified name, the symbol name and the last
+   component of the qualified name. */
+static int is_base_candidate(Node *cls) {
+  String *name = Getattr(cls, "name");
+  String *symname = Getattr(cls, "sym:name");
+  if (name && Getattr(prune_basenames, name))
+    return 1;
+  if (symname && Getattr(prune_basenames, symname))
+    return 1;
+  if (name) {
+    char *last = strrchr(Char(name), ':');
+    if (last && last[1] && Getattr(prune_basenames, last + 1))
+      return 1;
+  }
+  return 0;
+}
+
+static int droppable_ignored_cdecl(Node *n) {
+  String *storage;
+  if (!GetFlag(n, "feature:ignore"))
+    return 0;
+  if (Getattr(n, "sym:overloaded"))
+    return 0;
+  storage = Getattr(n, "storage");
+  if (storage && (Equal(storage, "typedef") || Equal(storage, "friend")))
+    return 0;
+  return 1;
+}
+
+static void prune_ignored(Node *n) {
+  Node *c = firstChild(n);
+  while (c) {
+    Node *next = nextSibling(c);
+    String *ntype = nodeType(c);
+    if (Equal(ntype, "class")) {
+      if (GetFlag(c, "feature:ignore") && !Getattr(c, "feature:onlychildren") && !is_base_candidate(c)) {
+	removeNode(c);
+	prune_count++;
+      }
+    } else if (Equal(ntype, "cdecl")) {
+      if (droppable_ignored_cdecl(c)) {
+	removeNode(c);
+	prune_count++;
+      }
+    } else if (firstChild(c)) {
+      prune_ignored(c);
+    }
+    c = next;
+  }
+}
+
+void Swig_prune_ignored(Node *top) {
+  prune_basenames = NewHash();
+  prune_count = 0;
+
+  collect_basenames(top);
+  prune_ignored(top);
+
+  if (Verbose)
+    Printf(stdout, "Pruned %d ignored declarations before the type pass.\n", prune_count);
+
+  Delete(prune_basenames);
+  prune_basenames = 0;
+}
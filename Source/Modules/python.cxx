@@ -83,14 +83,29 @@ static int nothreads = 0;
 
 /* Other options */
 static int dirvtable = 0;
+static int dirgilbatch = 0;
 static int doxygen = 0;
 static int fastunpack = 1;
+static int fastcall = 0;
 static int fastproxy = 0;
 static int olddefs = 0;
 static int castmode = 0;
 static int extranative = 0;
 static int nortti = 0;
 static int relativeimport = 0;
+static int use_slots = 0;
+static int limited_api = 0;
+
+/* Split compilation (-split <n>) */
+static int split_units = 0;
+static List *split_wrappers = 0;	/* wrapper buffer for each extra translation unit */
+static Hash *split_assignment = 0;	/* sym:name -> buffer holding that wrapper family */
+static Hash *split_externs_seen = 0;
+static String *split_externs = 0;	/* declarations for wrappers that moved out of the main unit */
+static List *split_inline_spans = 0;	/* file/line ranges covered by %inline blocks */
+static List *split_header_skips = 0;	/* f_header offset ranges the extra units must not repeat */
+static int split_redirected = 0;
+static int split_next_unit = 0;
 
 /* flags for the make_autodoc function */
 enum autodoc_t {
@@ -111,9 +126,11 @@ Python Options (available with -python)\n\
      -castmode       - Enable the casting mode, which allows implicit cast between types in Python\n\
      -debug-doxygen-parser     - Display doxygen parser module debugging information\n\
      -debug-doxygen-translator - Display doxygen translator module debugging information\n\
+     -dirgilbatch    - Let C++ code hold the GIL across a batch of director calls via Swig::DirectorGILContext (requires C++11)\n\
      -dirvtable      - Generate a pseudo virtual table for directors for faster dispatch\n\
      -doxygen        - Convert C++ doxygen comments to pydoc comments in proxy classes\n\
      -extranative    - Return extra native wrappers for C++ std containers wherever possible\n\
+     -fastcall       - Use METH_FASTCALL calling convention to avoid argument tuples (requires Python >= 3.7)\n\
      -fastproxy      - Use fast proxy mechanism for member methods\n\
      -globals <name> - Set <name> used to access C global variable (default: 'cvar')\n\
      -interface <mod>- Set low-level C/C++ module name to <mod> (default: module name prefixed by '_')\n\
@@ -126,8 +143,11 @@ static const char *usage3 = "\
      -nortti         - Disable the use of the native C++ RTTI with directors\n\
      -nothreads      - Disable thread support for the entire interface\n\
      -olddefs        - Keep the old method definitions when using -fastproxy\n\
+     -py-limited-api - Restrict generated code to the Python stable ABI (Py_LIMITED_API >= 3.10)\n\
      -py3            - Generate code with Python 3 specific features and syntax\n\
      -relativeimport - Use relative Python imports\n\
+     -slots          - Generate __slots__ proxy classes without per-instance dicts (proxies become non-dynamic)\n\
+     -split <n>      - Spread the wrapper functions over <n> C/C++ files so they can be compiled in parallel\n\
      -threads        - Add thread support for all the interface\n\
      -O              - Enable the following optimization options:\n\
                          -fastdispatch -fastproxy -fvirtual\n\
@@ -249,6 +269,8 @@ public:
       String *bb = Getattr(n, "feature:threadbeginblock");
       if (bb) {
 	Append(f, bb);
+      } else if (dirgilbatch) {
+	Append(f, "SWIG_PYTHON_DIRECTOR_THREAD_BEGIN_BLOCK;\n");
       } else {
 	Append(f, "SWIG_PYTHON_THREAD_BEGIN_BLOCK;\n");
       }
@@ -260,6 +282,8 @@ public:
       String *eb = Getattr(n, "feature:threadendblock");
       if (eb) {
 	Append(f, eb);
+      } else if (dirgilbatch) {
+	Append(f, "SWIG_PYTHON_DIRECTOR_THREAD_END_BLOCK;\n");
       } else {
 	Append(f, "SWIG_PYTHON_THREAD_END_BLOCK;\n");
       }
@@ -346,6 +370,9 @@ public:
 	} else if (strcmp(argv[i], "-dirvtable") == 0) {
 	  dirvtable = 1;
 	  Swig_mark_arg(i);
+	} else if (strcmp(argv[i], "-dirgilbatch") == 0) {
+	  dirgilbatch = 1;
+	  Swig_mark_arg(i);
 	} else if (strcmp(argv[i], "-doxygen") == 0) {
 	  doxygen = 1;
 	  scan_doxygen_comments = 1;
@@ -359,6 +386,12 @@ public:
 	} else if (strcmp(argv[i], "-nofastunpack") == 0) {
 	  fastunpack = 0;
 	  Swig_mark_arg(i);
+	} else if (strcmp(argv[i], "-fastcall") == 0) {
+	  fastcall = 1;
+	  Swig_mark_arg(i);
+	} else if (strcmp(argv[i], "-nofastcall") == 0) {
+	  fastcall = 0;
+	  Swig_mark_arg(i);
 	} else if (strcmp(argv[i], "-fastproxy") == 0) {
 	  fastproxy = 1;
 	  Swig_mark_arg(i);
@@ -393,6 +426,10 @@ public:
 	  py3 = 1;
 	  Preprocessor_define("SWIGPYTHON_PY3", 0);
 	  Swig_mark_arg(i);
+	} else if (strcmp(argv[i], "-py-limited-api") == 0) {
+	  limited_api = 1;
+	  Preprocessor_define("SWIGPYTHON_LIMITED_API", 0);
+	  Swig_mark_arg(i);
 	} else if (strcmp(argv[i], "-builtin") == 0) {
 	  builtin = 1;
 	  Preprocessor_define("SWIGPYTHON_BUILTIN", 0);
@@ -400,6 +437,25 @@ public:
 	} else if (strcmp(argv[i], "-relativeimport") == 0) {
 	  relativeimport = 1;
 	  Swig_mark_arg(i);
+	} else if (strcmp(argv[i], "-slots") == 0) {
+	  use_slots = 1;
+	  Swig_mark_arg(i);
+	} else if (strcmp(argv[i], "-noslots") == 0) {
+	  use_slots = 0;
+	  Swig_mark_arg(i);
+	} else if (strcmp(argv[i], "-split") == 0) {
+	  if (argv[i + 1]) {
+	    split_units = atoi(argv[i + 1]);
+	    Swig_mark_arg(i);
+	    Swig_mark_arg(i + 1);
+	    i++;
+	    if (split_units < 2) {
+	      Printf(stderr, "-split expects a translation unit count of at least 2\n");
+	      SWIG_exit(EXIT_FAILURE);
+	    }
+	  } else {
+	    Swig_arg_error();
+	  }
 	} else if (strcmp(argv[i], "-cppcast") == 0 ||
 		   strcmp(argv[i], "-fastinit") == 0 ||
 		   strcmp(argv[i], "-fastquery") == 0 ||
@@ -460,7 +516,46 @@ public:
    * top()
    * ------------------------------------------------------------ */
 
+  /* ------------------------------------------------------------
+   * markNoSlotsClasses()
+   *
+   * Python rejects class definitions whose bases carry conflicting
+   * __slots__ instance layouts, so any class inherited from by a
+   * multiple-inheritance proxy - and its whole ancestry - must keep
+   * dict-based instances when generating with -slots.
+   * ------------------------------------------------------------ */
+
+  void markNoSlotsAncestry(Node *cls) {
+    if (!cls || GetFlag(cls, "python:noslots"))
+      return;
+    SetFlag(cls, "python:noslots");
+    List *bases = Getattr(cls, "bases");
+    if (bases) {
+      Iterator b;
+      for (b = First(bases); b.item; b = Next(b))
+	markNoSlotsAncestry(b.item);
+    }
+  }
+
+  void markNoSlotsClasses(Node *n) {
+    Node *c;
+    for (c = firstChild(n); c; c = nextSibling(c)) {
+      if (Equal(nodeType(c), "class")) {
+	List *bases = Getattr(c, "bases");
+	if (bases && Len(bases) > 1) {
+	  Iterator b;
+	  for (b = First(bases); b.item; b = Next(b))
+	    markNoSlotsAncestry(b.item);
+	}
+      }
+      markNoSlotsClasses(c);
+    }
+  }
+
   virtual int top(Node *n) {
+    if (use_slots)
+      markNoSlotsClasses(n);
+
     /* check if directors are enabled for this module.  note: this
      * is a "master" switch, without which no director code will be
      * emitted.  %feature("director") statements are also required
@@ -523,6 +618,22 @@ public:
     /* Set comparison with none for ConstructorToFunction */
     setSubclassInstanceCheck(NewString("$arg != Py_None"));
 
+    if (split_units && (builtin || directorsEnabled())) {
+      Printf(stderr, "Ignoring -split: not supported with %s.\n", builtin ? "-builtin" : "directors");
+      split_units = 0;
+    }
+
+    if (limited_api) {
+      if (builtin) {
+	Printf(stderr, "-py-limited-api is not compatible with -builtin.\n");
+	SWIG_exit(EXIT_FAILURE);
+      }
+      if (fastproxy) {
+	Printf(stderr, "Ignoring -fastproxy: not supported with -py-limited-api.\n");
+	fastproxy = 0;
+      }
+    }
+
     /* Initialize all of the output files */
     String *outfile = Getattr(n, "outfile");
     String *outfile_h = !no_header_file ? Getattr(n, "outfile_h") : 0;
@@ -535,7 +646,7 @@ public:
     f_runtime = NewString("");
     f_init = NewString("");
     f_header = NewString("");
-    f_wrappers = NewString("");
+    f_wrappers = NewRope();
     f_directors_h = NewString("");
     f_directors = NewString("");
     builtin_getset = NewHash();
@@ -545,6 +656,21 @@ public:
     builtin_methods = NewString("");
     builtin_default_unref = NewString("delete $self;");
 
+    if (split_units) {
+      split_wrappers = NewList();
+      for (int unit = 1; unit < split_units; unit++) {
+	String *buffer = NewString("");
+	Append(split_wrappers, buffer);
+	Delete(buffer);
+      }
+      split_assignment = NewHash();
+      split_externs_seen = NewHash();
+      split_externs = NewString("");
+      split_inline_spans = NewList();
+      split_header_skips = NewList();
+      collect_split_inline_spans(n);
+    }
+
     if (builtin) {
       f_builtins = NewString("");
     }
@@ -592,6 +718,10 @@ public:
       Printf(f_runtime, "#define SWIG_PYTHON_DIRECTOR_NO_VTABLE\n");
     }
 
+    if (dirgilbatch) {
+      Printf(f_runtime, "#define SWIG_PYTHON_DIRECTOR_GIL_CONTEXT\n");
+    }
+
     if (nortti) {
       Printf(f_runtime, "#ifndef SWIG_DIRECTOR_NORTTI\n");
       Printf(f_runtime, "#define SWIG_DIRECTOR_NORTTI\n");
@@ -607,6 +737,13 @@ public:
       Printf(f_runtime, "#define SWIG_PYTHON_EXTRA_NATIVE_CONTAINERS\n");
     }
 
+    if (limited_api) {
+      Printf(f_runtime, "#ifndef Py_LIMITED_API\n");
+      Printf(f_runtime, "#define Py_LIMITED_API 0x030a0000\n");
+      Printf(f_runtime, "#endif\n");
+    }
+
+
     if (builtin) {
       Printf(f_runtime, "#define SWIGPYTHON_BUILTIN\n");
     }
@@ -618,6 +755,12 @@ public:
     Printf(f_header, "#endif\n");
     Printf(f_header, "#define SWIG_TypeQuery SWIG_Python_TypeQuery\n");
 
+    if (fastcall) {
+      Printf(f_header, "\n#if PY_VERSION_HEX < 0x03070000\n");
+      Printf(f_header, "# error \"This module was generated with -fastcall, which requires Python 3.7 or later\"\n");
+      Printf(f_header, "#endif\n");
+    }
+
 
     /* Set module name */
     module = Copy(Getattr(n, "name"));
@@ -754,6 +897,20 @@ public:
 	     tab4, "__setattr__ = _swig_setattr_nondynamic_class_variable(type.__setattr__)\n",
 	     "\n", NIL);
 
+      if (use_slots) {
+	/* All slotted proxy classes share this one instance layout, so
+	   Python code may multiply inherit from any two proxies of this
+	   module without a lay-out conflict.  The __swig_container__ slot
+	   holds the back-reference the std container typemaps attach to
+	   returned element references; its trailing underscores keep it
+	   out of private name mangling. */
+	Printv(f_shadow, "\n",
+	       "class _SwigSlotted(object):\n",
+	       tab4, "\"\"\"Shared instance layout for proxy classes generated with -slots\"\"\"\n",
+	       tab4, "__slots__ = [\"this\", \"__weakref__\", \"__swig_container__\"]\n",
+	       "\n", NIL);
+      }
+
       Printv(f_shadow, "\n", NIL);
 
       if (directorsEnabled()) {
@@ -798,6 +955,17 @@ public:
       Swig_insert_file("director.swg", f_runtime);
     }
 
+    if (split_units) {
+      /* Declare the diverted wrappers and the per-unit type table setters
+         ahead of the SwigMethods table, and hook the setters into the module
+         initializer once its own swig_types has been populated. */
+      for (int unit = 1; unit < split_units; unit++)
+	Printf(split_externs, "void SWIG_%s_split_init_%d(swig_type_info **types, size_t ntypes);\n", module, unit);
+      Printf(f_wrappers, "%s\n", split_externs);
+      for (int unit = 1; unit < split_units; unit++)
+	Printf(f_init, "SWIG_%s_split_init_%d(swig_types, sizeof(swig_types) / sizeof(swig_types[0]));\n", module, unit);
+    }
+
     /* Close language module */
     Append(methods, "\t { NULL, NULL, 0, NULL }\n");
     Append(methods, "};\n");
@@ -869,6 +1037,58 @@ public:
       Delete(f_shadow_py);
     }
 
+    /* Write the extra split translation units.  Each one repeats the runtime
+       section and the header section minus the %inline blocks: the runtime
+       and library header code are #defines, declarations and SWIGINTERN
+       definitions, so duplication across units is harmless, and the %{ %}
+       user code is under the documented contract of being #includes and
+       declarations.  %inline blocks, however, hold definitions with
+       external linkage, so only the main unit compiles them and their
+       wrappers stay there (split_unit_for).  Each extra unit has its own
+       static swig_types table, filled in from the main unit's module
+       initializer through the setter emitted at the bottom. */
+    if (split_units) {
+      String *shared_header = NewString("");
+      const char *header_text = Char(f_header);
+      int pos = 0;
+      for (Iterator skip = First(split_header_skips); skip.item; skip = Next(skip)) {
+	int begin = GetInt(skip.item, "begin");
+	Write(shared_header, header_text + pos, begin - pos);
+	pos = GetInt(skip.item, "end");
+      }
+      Write(shared_header, header_text + pos, Len(f_header) - pos);
+      for (int unit = 1; unit < split_units; unit++) {
+	String *code = Getitem(split_wrappers, unit - 1);
+	Replaceall(code, "SWIGINTERN PyObject *_wrap_", "PyObject *_wrap_");
+	char *coutfile = Char(outfile);
+	char *ext = strrchr(coutfile, '.');
+	String *base = ext ? NewStringWithSize(coutfile, (int)(ext - coutfile)) : Copy(outfile);
+	String *filen = NewStringf("%s_p%d%s", base, unit, ext ? ext : "");
+	File *f_unit = NewFile(filen, "w", SWIG_output_files());
+	if (!f_unit) {
+	  FileErrorDisplay(filen);
+	  SWIG_exit(EXIT_FAILURE);
+	}
+	Swig_banner(f_unit);
+	Printf(f_unit, "\n/* Wrapper translation unit %d of %d for module %s (-split). */\n", unit + 1, split_units, module);
+	Dump(f_runtime, f_unit);
+	Dump(shared_header, f_unit);
+	Printf(f_unit, "#ifdef __cplusplus\nextern \"C\" {\n#endif\n");
+	Dump(code, f_unit);
+	Printf(f_unit, "SWIGEXPORT void SWIG_%s_split_init_%d(swig_type_info **types, size_t ntypes) {\n", module, unit);
+	Printf(f_unit, "  size_t i;\n");
+	Printf(f_unit, "  (void)swig_module;\n");
+	Printf(f_unit, "  for (i = 0; i < ntypes && i < sizeof(swig_types) / sizeof(swig_types[0]); i++)\n");
+	Printf(f_unit, "    swig_types[i] = types[i];\n");
+	Printf(f_unit, "}\n");
+	Printf(f_unit, "#ifdef __cplusplus\n}\n#endif\n");
+	Delete(f_unit);
+	Delete(filen);
+	Delete(base);
+      }
+      Delete(shared_header);
+    }
+
     /* Close all of the files */
     Dump(f_runtime, f_begin);
     Dump(f_header, f_begin);
@@ -2431,10 +2651,21 @@ public:
    * add_method()
    * ------------------------------------------------------------ */
 
-  void add_method(String *name, String *function, int kw, Node *n = 0, int funpack = 0, int num_required = -1, int num_arguments = -1) {
+  void add_method(String *name, String *function, int kw, Node *n = 0, int funpack = 0, int num_required = -1, int num_arguments = -1, int fastcall_meth = 0) {
+    if (split_redirected && !Getattr(split_externs_seen, function)) {
+      /* The wrapper body lands in another translation unit; it must be
+         declared ahead of the SwigMethods table.  The PyCFunction-shaped
+         declaration is fine for entries registered through a cast as well,
+         since only the function's address is taken. */
+      Setattr(split_externs_seen, function, "1");
+      Printf(split_externs, "PyObject *%s(PyObject *, PyObject *);\n", function);
+    }
     String * meth_str = NewString("");
     if (!kw) {
-      if (funpack) {
+      if (fastcall_meth) {
+	// Cast via void(*)(void) as for METH_VARARGS|METH_KEYWORDS below.
+	Printf(meth_str, "\t { \"%s\", (PyCFunction)(void(*)(void))%s, METH_FASTCALL, ", name, function);
+      } else if (funpack) {
 	if (num_required == 0 && num_arguments == 0) {
 	  Printf(meth_str, "\t { \"%s\", %s, METH_NOARGS, ", name, function);
 	} else if (num_required == 1 && num_arguments == 1) {
@@ -2529,14 +2760,24 @@ public:
     String *symname = Getattr(n, "sym:name");
     String *wname = Swig_name_wrapper(symname);
 
+    /* Emit a METH_FASTCALL entry point for plain module/proxy dispatchers:
+       the argument vector arrives as a C array, so no tuple is unpacked */
+    bool fcall = fastcall && funpack && !builtin_self && !builtin_ctor;
+
     const char *builtin_kwargs = builtin_ctor ? ", PyObject *kwargs" : "";
-    Printv(f->def, linkage, builtin_ctor ? "int " : "PyObject *", wname, "(PyObject *self, PyObject *args", builtin_kwargs, ") {", NIL);
+    if (fcall)
+      Printv(f->def, linkage, "PyObject *", wname, "(PyObject *self, PyObject *const *args, Py_ssize_t nargs) {", NIL);
+    else
+      Printv(f->def, linkage, builtin_ctor ? "int " : "PyObject *", wname, "(PyObject *self, PyObject *args", builtin_kwargs, ") {", NIL);
 
     Wrapper_add_local(f, "argc", "Py_ssize_t argc");
     Printf(tmp, "PyObject *argv[%d] = {0}", maxargs + 1);
     Wrapper_add_local(f, "argv", tmp);
 
-    if (!fastunpack) {
+    if (fcall) {
+      Printf(f->code, "if (!(argc = SWIG_Python_UnpackFastcall(args, nargs, \"%s\", 0, %d, argv))) SWIG_fail;\n", symname, maxargs);
+      Append(f->code, "--argc;\n");
+    } else if (!fastunpack) {
       Wrapper_add_local(f, "ii", "Py_ssize_t ii");
 
       if (builtin_ctor)
@@ -2594,7 +2835,7 @@ public:
     Wrapper_print(f, f_wrappers);
     Node *p = Getattr(n, "sym:previousSibling");
     if (!builtin_self)
-      add_method(symname, wname, 0, p);
+      add_method(symname, wname, 0, p, 0, -1, -1, fcall ? 1 : 0);
 
     /* Create a shadow for this function (if enabled and not in a member function) */
     if (!builtin && (shadow) && (!(shadow & PYSHADOW_MEMBER))) {
@@ -2607,8 +2848,129 @@ public:
     Delete(wname);
   }
 
+  /* ------------------------------------------------------------
+   * collect_split_inline_spans()
+   *
+   * Record the file/line range of every %inline block.  The block's
+   * definitions have external linkage, so they may only be compiled
+   * into the main translation unit: the extra units skip the block
+   * text (see insertDirective) and split_from_inline() keeps every
+   * wrapper generated from declarations inside a block - they need
+   * those definitions - in the main unit with them.
+   * ------------------------------------------------------------ */
+
+  void collect_split_inline_spans(Node *n) {
+    for (Node *c = firstChild(n); c; c = nextSibling(c)) {
+      if (Equal(nodeType(c), "insert") && Getattr(c, "inline")) {
+	String *code = Getattr(c, "code");
+	String *file = code ? Getfile(code) : 0;
+	if (file) {
+	  int lines = 0;
+	  for (const char *s = Char(code); *s; s++)
+	    lines += *s == '\n';
+	  Hash *span = NewHash();
+	  Setattr(span, "file", file);
+	  SetInt(span, "begin", Getline(code));
+	  SetInt(span, "end", Getline(code) + lines + 1);
+	  Append(split_inline_spans, span);
+	  Delete(span);
+	}
+      }
+      collect_split_inline_spans(c);
+    }
+  }
+
+  bool split_from_inline(Node *n) {
+    for (Node *p = n; p; p = parentNode(p)) {
+      String *file = Getfile(p);
+      int line = Getline(p);
+      if (!file)
+	continue;
+      for (Iterator s = First(split_inline_spans); s.item; s = Next(s)) {
+	if (line >= GetInt(s.item, "begin") && line <= GetInt(s.item, "end") && Equal(file, Getattr(s.item, "file")))
+	  return true;
+      }
+    }
+    return false;
+  }
+
+  /* Mark [begin, end) of f_header as main-unit only; recorded in emission
+     order, so the offsets stay ascending and valid (f_header only grows) */
+  void split_skip_header_range(int begin, int end) {
+    if (end > begin) {
+      Hash *skip = NewHash();
+      SetInt(skip, "begin", begin);
+      SetInt(skip, "end", end);
+      Append(split_header_skips, skip);
+      Delete(skip);
+    }
+  }
+
+  /* ------------------------------------------------------------
+   * split_unit_for()
+   *
+   * Pick the translation unit receiving the wrappers for a node.
+   * Overloads share a sym:name and must stay in the same unit as
+   * their dispatcher, so the choice is remembered per name.  The
+   * main wrapper file takes its share along with everything that
+   * cannot move (method tables, constants, module init) and the
+   * wrappers of %inline declarations, whose definitions only the
+   * main unit compiles.
+   * ------------------------------------------------------------ */
+
+  File *split_unit_for(Node *n) {
+    String *iname = Getattr(n, "sym:name");
+    DOH *unit = iname ? Getattr(split_assignment, iname) : 0;
+    if (!unit) {
+      if (split_from_inline(n)) {
+	unit = (DOH *) f_wrappers;
+      } else {
+	int pick = split_next_unit++ % split_units;
+	unit = pick ? Getitem(split_wrappers, pick - 1) : (DOH *) f_wrappers;
+      }
+      if (iname)
+	Setattr(split_assignment, iname, unit);
+    }
+    return (File *) unit;
+  }
+
   /* ------------------------------------------------------------
    * functionWrapper()
+   *
+   * With -split, whole wrapper families are diverted into the
+   * extra translation units by swapping f_wrappers for the unit's
+   * buffer around the real work.
+   * ------------------------------------------------------------ */
+
+  virtual int functionWrapper(Node *n) {
+    if (!split_units)
+      return functionWrapperImpl(n);
+    File *unit = split_unit_for(n);
+    if (unit == f_wrappers) {
+      String *wrap = Getattr(n, "wrap:code");
+      if (wrap && split_from_inline(n) && Swig_filebyname("header") != Getattr(n, "wrap:code:done")) {
+	/* %extend helper bodies land in the header section; for an
+	   %inline class they reference definitions only the main unit
+	   compiles, so emit them here bracketed by a skip range instead
+	   of letting emit_action() write them into the shared header */
+	int begin = Len(f_header);
+	Printv(f_header, wrap, NIL);
+	split_skip_header_range(begin, Len(f_header));
+	Setattr(n, "wrap:code:done", Swig_filebyname("header"));
+      }
+      return functionWrapperImpl(n);
+    }
+    File *saved = f_wrappers;
+    f_wrappers = unit;
+    split_redirected = 1;
+    int result = functionWrapperImpl(n);
+    split_redirected = 0;
+    f_wrappers = saved;
+    return result;
+  }
+
+  /* ------------------------------------------------------------
+   * functionWrapperImpl()
    * ------------------------------------------------------------ */
 
   /*
@@ -2639,7 +3001,7 @@ public:
   }
 
 
-  virtual int functionWrapper(Node *n) {
+  int functionWrapperImpl(Node *n) {
 
     String *name = Getattr(n, "name");
     String *iname = Getattr(n, "sym:name");
@@ -2785,6 +3147,7 @@ public:
     int funpack = fastunpack && !varargs && !over_varargs && !allow_kwargs;
     int noargs = funpack && (tuple_required == 0 && tuple_arguments == 0);
     int onearg = funpack && (tuple_required == 1 && tuple_arguments == 1);
+    int fcall = 0;		/* set if a METH_FASTCALL entry point is emitted */
 
     if (builtin && funpack && !overname && !builtin_ctor) {
       int compactdefargs = ParmList_is_compactdefargs(l);
@@ -2936,16 +3299,24 @@ public:
 	  Printf(parse_args, "if ((nobjs < %d) || (nobjs > %d)) SWIG_fail;\n", num_required, num_arguments);
 	} else {
 	  int is_tp_call = Equal(Getattr(n, "feature:python:slot"), "tp_call");
-	  Printv(f->def, linkage, wrap_return, wname, "(PyObject *", self_param, ", PyObject *args", builtin_kwargs, ") {", NIL);
-	  if (builtin_ctor)
-	    Printf(parse_args, "if (!SWIG_Python_CheckNoKeywords(kwargs, \"%s\")) SWIG_fail;\n", iname);
-	  if (onearg && !builtin_ctor && !is_tp_call) {
-	    Printf(parse_args, "if (!args) SWIG_fail;\n");
-	    Append(parse_args, "swig_obj[0] = args;\n");
-	  } else if (!noargs) {
-	    Printf(parse_args, "if (!SWIG_Python_UnpackTuple(args, \"%s\", %d, %d, swig_obj)) SWIG_fail;\n", iname, num_fixed_arguments, tuple_arguments);
-	  } else if (noargs) {
-	    Printf(parse_args, "if (!SWIG_Python_UnpackTuple(args, \"%s\", %d, %d, 0)) SWIG_fail;\n", iname, num_fixed_arguments, tuple_arguments);
+	  /* METH_NOARGS/METH_O entry points are already tuple-free, so -fastcall
+	     only replaces the remaining METH_VARARGS entry points */
+	  if (fastcall && !builtin && !noargs && !(onearg && !is_tp_call)) {
+	    fcall = 1;
+	    Printv(f->def, linkage, wrap_return, wname, "(PyObject *", self_param, ", PyObject *const *args, Py_ssize_t nargs) {", NIL);
+	    Printf(parse_args, "if (!SWIG_Python_UnpackFastcall(args, nargs, \"%s\", %d, %d, swig_obj)) SWIG_fail;\n", iname, num_fixed_arguments, tuple_arguments);
+	  } else {
+	    Printv(f->def, linkage, wrap_return, wname, "(PyObject *", self_param, ", PyObject *args", builtin_kwargs, ") {", NIL);
+	    if (builtin_ctor)
+	      Printf(parse_args, "if (!SWIG_Python_CheckNoKeywords(kwargs, \"%s\")) SWIG_fail;\n", iname);
+	    if (onearg && !builtin_ctor && !is_tp_call) {
+	      Printf(parse_args, "if (!args) SWIG_fail;\n");
+	      Append(parse_args, "swig_obj[0] = args;\n");
+	    } else if (!noargs) {
+	      Printf(parse_args, "if (!SWIG_Python_UnpackTuple(args, \"%s\", %d, %d, swig_obj)) SWIG_fail;\n", iname, num_fixed_arguments, tuple_arguments);
+	    } else if (noargs) {
+	      Printf(parse_args, "if (!SWIG_Python_UnpackTuple(args, \"%s\", %d, %d, 0)) SWIG_fail;\n", iname, num_fixed_arguments, tuple_arguments);
+	    }
 	  }
 	}
       } else {
@@ -3262,7 +3633,7 @@ public:
     /* Now register the function with the interpreter.   */
     if (!Getattr(n, "sym:overloaded")) {
       if (!builtin_self)
-	add_method(iname, wname, allow_kwargs, n, funpack, num_required, num_arguments);
+	add_method(iname, wname, allow_kwargs, n, funpack, num_required, num_arguments, fcall);
 
       /* Create a shadow for this function (if enabled and not in a member function) */
       if (!builtin && (shadow) && (!(shadow & PYSHADOW_MEMBER))) {
@@ -3569,7 +3940,29 @@ public:
       value = wname;
     }
 
-    if ((tm = Swig_typemap_lookup("consttab", n, name, 0))) {
+    /* Enum items whose type resolves to a plain int (which includes the
+     * enum type itself) are compile-time integer constants, so pack them
+     * into swig_const_table and let SWIG_InstallConstants register the whole
+     * batch at module load instead of emitting one registration statement
+     * per value.  Items with another type keep the typemap path so their
+     * Python value is unchanged: a char-valued item (kchar = 'A') must
+     * surface as a one-char string, not its integer code.  Builtin class
+     * scopes also keep the typemap path, which places the value in the
+     * type dictionary. */
+    bool packed_enum = false;
+    if (!builtin && Equal(nodeType(n), "enumitem")) {
+      SwigType *qtype = SwigType_typedef_resolve_all(type);
+      SwigType *uqtype = SwigType_strip_qualifiers(qtype);
+      packed_enum = SwigType_type(uqtype) == T_INT;
+      Delete(qtype);
+      Delete(uqtype);
+    }
+    if (packed_enum) {
+      Printf(const_code, "{ SWIG_PY_INT, \"%s\", (long)(%s), 0, 0, 0 },\n", iname, value);
+      have_tm = 1;
+    }
+
+    if (!packed_enum && (tm = Swig_typemap_lookup("consttab", n, name, 0))) {
       Replaceall(tm, "$value", value);
       Printf(const_code, "%s,\n", tm);
       Delete(tm);
@@ -3583,7 +3976,7 @@ public:
       Setattr(n, "sym:name", Getattr(n, "pybuiltin:symname"));
     }
 
-    if ((tm = Swig_typemap_lookup("constcode", n, name, 0))) {
+    if (!packed_enum && (tm = Swig_typemap_lookup("constcode", n, name, 0))) {
       Replaceall(tm, "$value", value);
       if (needs_swigconstant(n) && !builtin && (shadow) && (!(shadow & PYSHADOW_MEMBER)) && (!in_class || !Getattr(n, "feature:python:callback"))) {
 	// Generate `*_swigconstant()` method which registers the new constant.
@@ -4384,6 +4777,7 @@ public:
 
       /* Handle inheritance */
       String *base_class = NewString("");
+      int num_proxy_bases = 0;
       List *baselist = Getattr(n, "bases");
       if (baselist && Len(baselist)) {
 	Iterator b;
@@ -4401,6 +4795,7 @@ public:
 	    continue;
 	  }
 	  Printv(base_class, bname, NIL);
+	  num_proxy_bases++;
 	  b = Next(b);
 	  if (b.item) {
             Printv(base_class, ", ", NIL);
@@ -4441,6 +4836,19 @@ public:
 	  Delete(rname);
 	}
       } else {
+	/* The slots (and the dict-free instances they buy) live in the
+	   shared _SwigSlotted root; every eligible proxy just declares an
+	   empty list.  Ineligible classes keep dict-based instances:
+	   exception proxies (BaseException instances always carry a dict),
+	   nondynamic classes (the _swig_add_metaclass decorator recreates
+	   the class from a copy of its dict, and the materialized slot
+	   descriptors then collide with __slots__), classes the user marks
+	   with %feature("python:noslots"), and bases of wrapped
+	   multiple-inheritance classes (marked by markNoSlotsClasses). */
+	int emit_slots = use_slots && !GetFlag(n, "feature:exceptionclass")
+	    && !GetFlag(n, "feature:python:nondynamic")
+	    && !GetFlag(n, "feature:python:noslots")
+	    && !GetFlag(n, "python:noslots");
 	if (!py3) {
 	  if (GetFlag(n, "feature:python:nondynamic"))
 	    Printv(f_shadow, "@_swig_add_metaclass(_SwigNonDynamicMeta)\n", NIL);
@@ -4453,7 +4861,7 @@ public:
 	  if (GetFlag(n, "feature:exceptionclass")) {
 	    Printf(f_shadow, "(Exception)");
 	  } else {
-	    Printf(f_shadow, "(object");
+	    Printf(f_shadow, "(%s", emit_slots ? "_SwigSlotted" : "object");
 	    if (py3 && GetFlag(n, "feature:python:nondynamic")) {
 	      Printf(f_shadow, ", metaclass=_SwigNonDynamicMeta");
 	    }
@@ -4470,6 +4878,17 @@ public:
 	    Printv(f_shadow, tab4, str, "\n\n", NIL);
 	}
 
+	if (emit_slots) {
+	  if (num_proxy_bases > 1) {
+	    /* The wrapped bases were kept dict-based by markNoSlotsClasses,
+	       so this class's instances carry a dict through them */
+	    Swig_warning(WARN_PYTHON_SLOTS_MULTIPLE_BASES, Getfile(n), Getline(n),
+			 "__slots__ not generated for '%s': multiple proxy base classes.\n", class_name);
+	  } else {
+	    Printv(f_shadow, tab4, "__slots__ = []\n", NIL);
+	  }
+	}
+
 	Printv(f_shadow, tab4, "thisown = property(lambda x: x.this.own(), ", "lambda x, v: x.this.own(v), doc=\"The membership flag\")\n", NIL);
 	/* Add static attribute */
 	if (GetFlag(n, "feature:python:nondynamic")) {
@@ -5155,6 +5574,15 @@ public:
 	Printv(f_shadow_begin, pycode, NIL);
 	Delete(pycode);
       }
+    } else if (split_units && Getattr(n, "inline")) {
+      /* %inline definitions have external linkage, so only the main unit
+         may compile them.  Remember the span the block occupies in the
+         header section; the extra units are written with these spans cut
+         out, and split_unit_for() keeps the block's wrappers in the main
+         unit with the definitions. */
+      int begin = Len(f_header);
+      Language::insertDirective(n);
+      split_skip_header_range(begin, Len(f_header));
     } else {
       Language::insertDirective(n);
     }
@@ -5351,7 +5779,7 @@ int PYTHON::classDirectorMethod(Node *n, Node *parent, String *super) {
       Printf(w->code, "%s;\n", super_call);
       Delete(super_call);
     } else {
-      Printf(w->code, "Swig::DirectorPureVirtualException::raise(\"Attempted to invoke pure virtual method %s::%s\");\n", SwigType_namestr(c_classname),
+      Printf(w->code, "Swig::DirectorPureVirtualException::raise_literal(\"Attempted to invoke pure virtual method %s::%s\");\n", SwigType_namestr(c_classname),
 	     SwigType_namestr(name));
     }
   } else {
@@ -5516,7 +5944,7 @@ int PYTHON::classDirectorMethod(Node *n, Node *parent, String *super) {
 
 
     Append(w->code, "if (!swig_get_self()) {\n");
-    Printf(w->code, "  Swig::DirectorException::raise(\"'self' uninitialized, maybe you forgot to call %s.__init__.\");\n", classname);
+    Printf(w->code, "  Swig::DirectorException::raise_literal(\"'self' uninitialized, maybe you forgot to call %s.__init__.\");\n", classname);
     Append(w->code, "}\n");
     Append(w->code, "#if defined(SWIG_PYTHON_DIRECTOR_VTABLE)\n");
     Printf(w->code, "const size_t swig_method_index = %d;\n", director_method_index++);
@@ -5564,7 +5992,7 @@ int PYTHON::classDirectorMethod(Node *n, Node *parent, String *super) {
       Printv(w->code, Str(tm), "\n", NIL);
     } else {
       Append(w->code, "  if (error) {\n");
-      Printf(w->code, "    Swig::DirectorMethodException::raise(\"Error detected when calling '%s.%s'\");\n", classname, pyname);
+      Printf(w->code, "    Swig::DirectorMethodException::raise_literal(\"Error detected when calling '%s.%s'\");\n", classname, pyname);
       Append(w->code, "  }\n");
     }
     Append(w->code, "}\n");
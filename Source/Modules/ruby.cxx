@@ -2996,7 +2996,9 @@ public:
       Wrapper_add_localv(w, "args", "Swig::body_args", "args", NIL);
       Wrapper_add_localv(w, "status", "int", "status", NIL);
       Printv(w->code, "args.recv = swig_get_self();\n", NIL);
-      Printf(w->code, "args.id = rb_intern(\"%s\");\n", methodName);
+      // Intern the method name once per process rather than on every upcall
+      Printf(w->code, "static ID swig_method_id = rb_intern(\"%s\");\n", methodName);
+      Printv(w->code, "args.id = swig_method_id;\n", NIL);
       Printf(w->code, "args.argc = %d;\n", argc);
       if (argc > 0) {
 	Printf(w->code, "args.argv = new VALUE[%d];\n", argc);
@@ -3019,10 +3021,11 @@ public:
       Wrapper_print(body, f_directors_helpers);
       Wrapper_print(rescue, f_directors_helpers);
     } else {
+      Printf(w->code, "static ID swig_method_id = rb_intern(\"%s\");\n", methodName);
       if (argc > 0) {
-	Printf(w->code, "%s = rb_funcall(swig_get_self(), rb_intern(\"%s\"), %d%s);\n", Swig_cresult_name(), methodName, argc, args);
+	Printf(w->code, "%s = rb_funcall(swig_get_self(), swig_method_id, %d%s);\n", Swig_cresult_name(), argc, args);
       } else {
-	Printf(w->code, "%s = rb_funcall(swig_get_self(), rb_intern(\"%s\"), 0, Qnil);\n", Swig_cresult_name(), methodName);
+	Printf(w->code, "%s = rb_funcall(swig_get_self(), swig_method_id, 0, Qnil);\n", Swig_cresult_name());
       }
       if ( initstack ) Printf(w->code, "SWIG_RELEASE_STACK;\n");
     }
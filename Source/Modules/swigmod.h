@@ -385,6 +385,7 @@ int emit_num_required(ParmList *);
 int emit_isvarargs(ParmList *p);
 bool emit_isvarargs_function(Node *n);
 void emit_attach_parmmaps(ParmList *, Wrapper *f);
+void emit_argument_frame(Wrapper *f, const_String_or_char_ptr type, const_String_or_char_ptr name, int maxargs);
 void emit_mark_varargs(ParmList *l);
 String *emit_action(Node *n);
 int emit_action_code(Node *n, String *wrappercode, String *action);
@@ -437,6 +438,8 @@ int Swig_contract_mode_get();
 void Swig_browser(Node *n, int);
 void Swig_default_allocators(Node *n);
 void Swig_process_types(Node *n);
+void Swig_prune_unused(Node *top, String *entryfile);
+void Swig_prune_ignored(Node *top);
 
 /* Nested classes */
 void Swig_nested_process_classes(Node *n);
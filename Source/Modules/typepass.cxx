@@ -37,6 +37,7 @@ class TypePass:private Dispatcher {
   String *nssymname;
   Hash *classhash;
   List *normalize;
+  Hash *remembered_bases;
 
   TypePass() :
     inclass(0),
@@ -45,7 +46,8 @@ class TypePass:private Dispatcher {
     nsname(0),
     nssymname(0),
     classhash(0),
-    normalize(0) {
+    normalize(0),
+    remembered_bases(0) {
   }
 
   /* Normalize a type. Replaces type with fully qualified version */
@@ -305,13 +307,28 @@ class TypePass:private Dispatcher {
 	    Swig_warning(WARN_LANG_SMARTPTR_MISSING, Getfile(first), Getline(first), "Derived class '%s' of '%s' is not similarly marked as a smart pointer.\n", SwigType_namestr(Getattr(first, "name")), SwigType_namestr(Getattr(bclass, "name")));
 	}
       }
-      if (!importmode) {
+      if (!importmode && !Getattr(remembered_bases, bname)) {
+	/* This runs once per (class, ancestor) pair and SwigType_remember
+	   re-runs the full type resolution each time, which adds up to
+	   cubic work on a deep hierarchy.  Base class names are fully
+	   qualified at this point, so remembering each one once per
+	   module is enough. */
 	String *btype = Copy(bname);
 	SwigType_add_pointer(btype);
 	SwigType_remember(btype);
 	Delete(btype);
+	Setattr(remembered_bases, bname, "1");
       }
-      if (scopes) {
+      if (scopes && cls == first) {
+	/* Only link the type scope of a direct base.  Indirect bases are
+	   reachable transitively, since each base linked its own direct
+	   bases when it was processed, and the current scope here is
+	   always the scope of 'first', so linking inside the recursion
+	   would attach every ancestor directly.  That makes every
+	   ancestor reachable along many paths and scope lookups in
+	   Swig/typesys.c then take time exponential in the inheritance
+	   depth.  One edge per direct base matches how the symbol table
+	   inheritance is set up below. */
 	SwigType_inherit_scope(scopes);
       }
       /* Set up inheritance in the symbol table */
@@ -373,9 +390,12 @@ class TypePass:private Dispatcher {
     nsname = 0;
     nssymname = 0;
     classhash = Getattr(n, "classes");
+    remembered_bases = NewHash();
     emit_children(n);
     normalize_list();
     SwigType_set_scope(0);
+    Delete(remembered_bases);
+    remembered_bases = 0;
     return SWIG_OK;
   }
 
@@ -15,6 +15,7 @@
 
 static const char *usage = "\
 XML Options (available with -xml)\n\
+     -xmljson        - Write the tree as JSON-lines (one node per line) instead of XML\n\
      -xmllang <lang> - Typedef language\n\
      -xmllite        - More lightweight version of XML\n\
      ------\n\
@@ -22,6 +23,7 @@ XML Options (available with -xml)\n\
 
 static File *out = 0;
 static int xmllite = 0;
+static int xmljson = 0;
 
 
 class XML:public Language {
@@ -70,6 +72,10 @@ public:
 	Swig_mark_arg(iX);
 	xmllite = 1;
       }
+      if (strcmp(argv[iX], "-xmljson") == 0) {
+	Swig_mark_arg(iX);
+	xmljson = 1;
+      }
     }
 
     // Add a symbol to the parser for conditional compilation
@@ -85,13 +91,17 @@ public:
       // If there's an extension, ext will include the ".".
       Delslice(outfile, Len(outfile) - Len(ext), DOH_END);
       Delete(ext);
-      Append(outfile, ".xml");
+      Append(outfile, xmljson ? ".jsonl" : ".xml");
       out = NewFile(outfile, "w", SWIG_output_files());
       if (!out) {
 	FileErrorDisplay(outfile);
 	SWIG_exit(EXIT_FAILURE);
       }
     }
+    if (xmljson) {
+      Json_print_tree(n, 0);
+      return SWIG_OK;
+    }
     Printf(out, "<?xml version=\"1.0\" ?> \n");
     Xml_print_tree(n);
     return SWIG_OK;
@@ -289,6 +299,151 @@ public:
     Printf(out, "</%s >\n", markup);
   }
 
+  /* The JSON-lines variant (-xmljson) writes one JSON object per node,
+     streamed straight to the output file, so downstream tooling can mmap
+     the result and index it by line.  Nodes carry their parent's id, so
+     the tree can be rebuilt without parsing more than one line at a time. */
+
+  void Json_print_tree(DOH *obj, long parent) {
+    while (obj) {
+      Json_print_node(obj, parent);
+      obj = nextSibling(obj);
+    }
+  }
+
+  void Json_print_node(Node *obj, long parent) {
+    long nid = ++id;
+    Printf(out, "{\"id\":%ld,\"parent\":%ld,\"type\":\"%s\",\"attrs\":{", nid, parent, nodeType(obj));
+    Json_print_attributes(obj);
+    Printf(out, "}}\n");
+    Json_print_tree(firstChild(obj), nid);
+  }
+
+  void Json_print_escaped(String *str) {
+    if (!str)
+      return;
+    const char *c = Char(str);
+    for (; *c; c++) {
+      switch (*c) {
+      case '"':
+	Printf(out, "\\\"");
+	break;
+      case '\\':
+	Printf(out, "\\\\");
+	break;
+      case '\n':
+	Printf(out, "\\n");
+	break;
+      case '\r':
+	Printf(out, "\\r");
+	break;
+      case '\t':
+	Printf(out, "\\t");
+	break;
+      default:
+	if ((unsigned char) *c < 0x20) {
+	  Printf(out, "\\u%04x", (int) (unsigned char) *c);
+	} else {
+	  Putc(*c, out);
+	}
+      }
+    }
+  }
+
+  void Json_print_member(int *first, String *key) {
+    if (!*first) {
+      Printf(out, ",");
+    }
+    *first = 0;
+    Printf(out, "\"");
+    Json_print_escaped(key);
+    Printf(out, "\":");
+  }
+
+  void Json_print_attributes(Node *obj) {
+    int first = 1;
+    Iterator ki;
+    for (ki = First(obj); ki.key; ki = Next(ki)) {
+      String *k = ki.key;
+      if ((Cmp(k, "nodeType") == 0)
+	  || (Cmp(k, "firstChild") == 0)
+	  || (Cmp(k, "lastChild") == 0)
+	  || (Cmp(k, "parentNode") == 0)
+	  || (Cmp(k, "nextSibling") == 0)
+	  || (Cmp(k, "previousSibling") == 0)
+	  || (*(Char(k)) == '$')) {
+	/* Do nothing */
+      } else if (Cmp(k, "module") == 0) {
+	/* may be the module node or, on nested imports, a plain string */
+	DOH *mod = Getattr(obj, k);
+	Json_print_member(&first, k);
+	Printf(out, "\"");
+	Json_print_escaped(DohIsString(mod) ? (String *) mod : (String *) Getattr(mod, "name"));
+	Printf(out, "\"");
+      } else if (Cmp(k, "baselist") == 0) {
+	Json_print_member(&first, k);
+	Printf(out, "[");
+	Iterator s;
+	int bfirst = 1;
+	for (s = First(Getattr(obj, k)); s.item; s = Next(s)) {
+	  Printf(out, "%s\"", bfirst ? "" : ",");
+	  Json_print_escaped(s.item);
+	  Printf(out, "\"");
+	  bfirst = 0;
+	}
+	Printf(out, "]");
+      } else if (!xmllite && (Cmp(k, "typescope") == 0 || Cmp(k, "typetab") == 0)) {
+	Json_print_member(&first, k);
+	Json_print_hash(Getattr(obj, k));
+      } else if (xmllite && (Cmp(k, "typescope") == 0 || Cmp(k, "typetab") == 0)) {
+	/* Do nothing */
+      } else if (Cmp(k, "kwargs") == 0) {
+	Json_print_member(&first, k);
+	Json_print_hash(Getattr(obj, k));
+      } else if (Cmp(k, "parms") == 0 || Cmp(k, "pattern") == 0 || Cmp(k, "catchlist") == 0 || Cmp(k, "templateparms") == 0) {
+	Json_print_member(&first, k);
+	Printf(out, "[");
+	Parm *p = Getattr(obj, k);
+	int pfirst = 1;
+	while (p) {
+	  Printf(out, "%s{", pfirst ? "" : ",");
+	  Json_print_attributes(p);
+	  Printf(out, "}");
+	  pfirst = 0;
+	  p = nextSibling(p);
+	}
+	Printf(out, "]");
+      } else if (DohIsString(Getattr(obj, k))) {
+	Json_print_member(&first, k);
+	Printf(out, "\"");
+	Json_print_escaped(Getattr(obj, k));
+	Printf(out, "\"");
+      } else {
+	Json_print_member(&first, k);
+	Printf(out, "\"@%p\"", Getattr(obj, k));
+      }
+    }
+  }
+
+  void Json_print_hash(Hash *p) {
+    Printf(out, "{");
+    int first = 1;
+    Iterator n;
+    for (n = First(p); n.key; n = Next(n)) {
+      Json_print_member(&first, n.key);
+      if (DohIsString(n.item)) {
+	Printf(out, "\"");
+	Json_print_escaped(n.item);
+	Printf(out, "\"");
+      } else {
+	Printf(out, "{");
+	Json_print_attributes(n.item);
+	Printf(out, "}");
+      }
+    }
+    Printf(out, "}");
+  }
+
 };
 
 /* -----------------------------------------------------------------------------
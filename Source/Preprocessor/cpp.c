@@ -36,6 +36,19 @@ static int macro_level = 0;
 static int macro_start_line = 0;
 static const String * macro_start_file = 0;
 
+/* Cache of completed macro expansions, keyed by macro name and raw argument
+   text.  Only valid for a given state of the symbol table; invalidated on
+   every define/undef/include. */
+static Hash *expansion_cache = 0;
+static int cpp_generation = 0;	/* Bumped whenever the symbol table changes */
+static int expansion_uncacheable = 0;	/* Expansion consulted __LINE__/__FILE__ */
+
+static void cpp_cache_invalidate(void) {
+  cpp_generation++;
+  if (expansion_cache)
+    Clear(expansion_cache);
+}
+
 /* Test a character to see if it starts an identifier */
 #define isidentifier(c) ((isalpha(c)) || (c == '_') || (c == '$'))
 
@@ -56,10 +69,55 @@ static void skip_whitespace(String *s, String *out) {
   }
 }
 
+/* Copy characters from s to out in bulk until one of the delimiter
+   characters (or end of input) is reached.  The delimiter itself is not
+   consumed.  Scanning runs over the raw buffer with strcspn so long runs
+   of ordinary text are not copied a byte at a time; Seek takes care of
+   the line accounting. */
+static void copy_to_delim(String *s, const char *delim, String *out) {
+  char *base = Char(s);
+  int pos = Tell(s);
+  size_t n = strcspn(base + pos, delim);
+  if (n > 0) {
+    int line = Getline(s);
+    const char *p = base + pos;
+    const char *e = p + n;
+    while ((p = (const char *) memchr(p, '\n', e - p)) != 0) {
+      line++;
+      p++;
+    }
+    if (out)
+      Write(out, base + pos, (int) n);
+    Seek(s, (long) n, SEEK_CUR);
+    /* Seek counts newlines over (pos, pos+n], not the consumed range
+       [pos, pos+n), so set the line explicitly to match Getc */
+    Setline(s, line);
+  }
+}
+
+/* Like copy_to_delim but for text inside a false conditional: the input
+   is skipped rather than copied, and only its newlines are emitted (as
+   blank lines) so line numbering is preserved.  This avoids buffering
+   excluded regions into a chunk that add_chunk would immediately blank. */
+static void skip_to_delim(String *s, const char *delim, String *out) {
+  int line = Getline(s);
+  copy_to_delim(s, delim, 0);
+  for (line = Getline(s) - line; line > 0; line--)
+    Putc('\n', out);
+}
+
 /* Skip to a specified character taking line breaks into account */
 static int skip_tochar(String *s, int ch, String *out) {
+  char delim[3];
   int c;
-  while ((c = Getc(s)) != EOF) {
+  delim[0] = (char) ch;
+  delim[1] = '\\';
+  delim[2] = 0;
+  for (;;) {
+    copy_to_delim(s, delim, out);
+    c = Getc(s);
+    if (c == EOF)
+      return -1;
     if (out)
       Putc(c, out);
     if (c == ch)
@@ -70,8 +128,6 @@ static int skip_tochar(String *s, int ch, String *out) {
 	Putc(c, out);
     }
   }
-  if (c == EOF)
-    return -1;
   return 0;
 }
 
@@ -80,16 +136,98 @@ static void copy_location(const DOH *s1, DOH *s2) {
   Setline(s2, Getline((DOH *) s1));
 }
 
+static Hash *include_resolution = 0;	/* Include spec -> resolved path, per search path state */
+
+/* Key identifying an include directive together with the search path state
+   that resolves it, so a repeat of the same directive can be skipped without
+   re-opening the file. */
+static String *cpp_include_key(const_String_or_char_ptr fn, int sysfile) {
+  String *key = NewStringf("%d\037%s", sysfile, fn);
+  List *sp = Swig_search_path();
+  int i, ilen = Len(sp);
+  for (i = 0; i < ilen; i++) {
+    Putc('\037', key);
+    Append(key, Getitem(sp, i));
+  }
+  Delete(sp);
+  return key;
+}
+
+/* Scan the raw text of a freshly loaded file for include directives and ask
+   the kernel to start reading the named files (Swig_file_prefetch), so their
+   I/O overlaps with preprocessing of this file.  This is a cheap textual
+   scan and purely advisory: a false positive inside a comment or an
+   inactive #if branch at worst warms the cache with an unneeded file. */
+static void cpp_prefetch_includes(String *s) {
+  char *c = Char(s);
+  while (*c) {
+    while (*c == ' ' || *c == '\t')
+      c++;
+    if (*c == '#' || *c == '%') {
+      char *d = c + 1;
+      while (*d == ' ' || *d == '\t')
+	d++;
+      if (strncmp(d, "include", 7) == 0)
+	d += 7;
+      else if (strncmp(d, "import", 6) == 0)
+	d += 6;
+      else
+	d = 0;
+      if (d) {
+	while (*d == ' ' || *d == '\t')
+	  d++;
+	if (*d == '"' || *d == '<') {
+	  char term = (*d == '<') ? '>' : '"';
+	  char *start = ++d;
+	  while (*d && *d != term && *d != '\n')
+	    d++;
+	  if (*d == term && d > start) {
+	    String *fn = NewStringWithSize(start, (int) (d - start));
+	    Swig_file_prefetch(fn, term == '>');
+	    Delete(fn);
+	  }
+	}
+	c = d;
+      }
+    }
+    while (*c && *c != '\n')
+      c++;
+    if (*c)
+      c++;
+  }
+}
+
 static String *cpp_include(const_String_or_char_ptr fn, int sysfile) {
-  String *s = sysfile ? Swig_include_sys(fn) : Swig_include(fn);
+  String *s;
+  String *key = 0;
+
+  if (single_include) {
+    /* If this exact directive resolved before to a file we have already
+       included (or one that said #pragma once), skip the file open entirely */
+    key = cpp_include_key(fn, sysfile);
+    if (include_resolution) {
+      String *resolved = Getattr(include_resolution, key);
+      if (resolved && Getattr(included_files, resolved)) {
+	Delete(key);
+	return 0;
+      }
+    }
+  }
+  s = sysfile ? Swig_include_sys(fn) : Swig_include(fn);
+  cpp_cache_invalidate();
   if (s && single_include) {
     String *file = Getfile(s);
+    if (!include_resolution)
+      include_resolution = NewHash();
+    Setattr(include_resolution, key, file);
     if (Getattr(included_files, file)) {
       Delete(s);
+      Delete(key);
       return 0;
     }
     Setattr(included_files, file, file);
   }
+  Delete(key);
   if (!s) {
     if (ignore_missing) {
       Swig_warning(WARN_PP_MISSING_FILE, Getfile(fn), Getline(fn), "Unable to find '%s'\n", fn);
@@ -105,6 +243,7 @@ static String *cpp_include(const_String_or_char_ptr fn, int sysfile) {
     lf = Copy(Swig_last_file());
     Append(dependencies, lf);
     Delete(lf);
+    cpp_prefetch_includes(s);
   }
   return s;
 }
@@ -255,6 +394,10 @@ void Preprocessor_delete(void) {
 
   Delete(cpp);
   Delete(included_files);
+  Delete(include_resolution);
+  include_resolution = 0;
+  Delete(expansion_cache);
+  expansion_cache = 0;
   Preprocessor_expr_delete();
   DelScanner(id_scan);
 
@@ -540,6 +683,7 @@ Hash *Preprocessor_define(const_String_or_char_ptr _str, int swigmacro) {
   } else {
     Setattr(symbols, macroname, macro);
     Delete(macro);
+    cpp_cache_invalidate();
   }
 
   Delete(macroname);
@@ -558,6 +702,225 @@ macro_error:
   return 0;
 }
 
+/* -----------------------------------------------------------------------------
+ * Preprocessor_save_state()
+ *
+ * Serialize the macro symbol table into a string.  Together with
+ * Preprocessor_restore_state() this lets a cached preprocessed interface
+ * restore the macros its preprocessor run defined, which the parser still
+ * needs when it re-preprocesses %inline blocks.  The include guard set is
+ * saved too, so text preprocessed on top of a restored state does not
+ * re-include files the cached run already pulled in.  The format is private
+ * to this pair of functions: one length-prefixed record per macro, then a
+ * record starting with -1 listing the included files.
+ * ----------------------------------------------------------------------------- */
+
+String *Preprocessor_save_state(void) {
+  String *out = NewStringEmpty();
+  Hash *symbols;
+  Iterator m;
+
+  assert(cpp);
+  symbols = Getattr(cpp, kpp_symbols);
+  for (m = First(symbols); m.key; m = Next(m)) {
+    Hash *macro = m.item;
+    String *value = Getattr(macro, kpp_value);
+    List *args = Getattr(macro, kpp_args);
+    String *file = Getfile(macro);
+    String *vfile = value ? Getfile(value) : 0;
+    int i, nargs = args ? Len(args) : -1;
+    Printf(out, "%d %d %d %d %d %d %d %d %d\n", Len(m.key), value ? Len(value) : -1, nargs,
+	   file ? Len(file) : -1, vfile ? Len(vfile) : -1,
+	   Getattr(macro, kpp_varargs) ? 1 : 0, Getattr(macro, kpp_swigmacro) ? 1 : 0, Getline(macro), value ? Getline(value) : 0);
+    Append(out, m.key);
+    Putc('\n', out);
+    if (value) {
+      Append(out, value);
+      Putc('\n', out);
+    }
+    if (file) {
+      Append(out, file);
+      Putc('\n', out);
+    }
+    if (vfile) {
+      Append(out, vfile);
+      Putc('\n', out);
+    }
+    for (i = 0; i < nargs; i++) {
+      String *a = Getitem(args, i);
+      Printf(out, "%d\n", Len(a));
+      Append(out, a);
+      Putc('\n', out);
+    }
+  }
+  Printf(out, "-1 %d\n", Len(included_files));
+  for (m = First(included_files); m.key; m = Next(m)) {
+    Printf(out, "%d\n", Len(m.key));
+    Append(out, m.key);
+    Putc('\n', out);
+  }
+  return out;
+}
+
+/* -----------------------------------------------------------------------------
+ * Preprocessor_restore_state()
+ *
+ * Replace the macro symbol table with one previously serialized by
+ * Preprocessor_save_state().  Nothing is modified unless the whole buffer
+ * parses, so a corrupt cache entry degrades into a cache miss.  Returns 0
+ * on success, -1 on a malformed buffer.
+ * ----------------------------------------------------------------------------- */
+
+/* Pull a length-prefixed field (followed by '\n') out of the buffer */
+static String *restore_field(const char **pp, const char *end, int len) {
+  String *s;
+  if (len < 0 || *pp + len + 1 > end || (*pp)[len] != '\n')
+    return 0;
+  s = NewStringWithSize(*pp, len);
+  *pp += len + 1;
+  return s;
+}
+
+int Preprocessor_restore_state(const char *buf, int len) {
+  Hash *newsymbols = NewHash();
+  Hash *newincluded = 0;
+  const char *p = buf;
+  const char *end = buf + len;
+
+  assert(cpp);
+  while (p < end) {
+    int nl, vl, al, fl, vfl, varargs, swigmacro, line, vline, nc, i;
+    Hash *macro;
+    String *name, *value, *file, *vfile;
+    if (*p == '-') {
+      /* The -1 record terminates the macro records and lists the files the
+         saved run included; macro records always start with a digit */
+      int nfiles;
+      if (sscanf(p, "-1 %d%n", &nfiles, &nc) != 1)
+	goto restore_error;
+      p += nc;
+      if (p >= end || *p != '\n')
+	goto restore_error;
+      p++;
+      newincluded = NewHash();
+      for (i = 0; i < nfiles; i++) {
+	int flen;
+	String *f;
+	if (sscanf(p, "%d%n", &flen, &nc) != 1)
+	  goto restore_error;
+	p += nc;
+	if (p >= end || *p != '\n')
+	  goto restore_error;
+	p++;
+	f = restore_field(&p, end, flen);
+	if (!f)
+	  goto restore_error;
+	Setattr(newincluded, f, f);
+	Delete(f);
+      }
+      if (p != end)
+	goto restore_error;
+      break;
+    }
+    if (sscanf(p, "%d %d %d %d %d %d %d %d %d%n", &nl, &vl, &al, &fl, &vfl, &varargs, &swigmacro, &line, &vline, &nc) != 9)
+      goto restore_error;
+    p += nc;
+    if (p >= end || *p != '\n')
+      goto restore_error;
+    p++;
+    macro = NewHash();
+    Setline(macro, line);
+    name = restore_field(&p, end, nl);
+    if (!name) {
+      Delete(macro);
+      goto restore_error;
+    }
+    Setattr(macro, kpp_name, name);
+    if (vl >= 0) {
+      value = restore_field(&p, end, vl);
+      if (value) {
+	Setline(value, vline);
+	Setattr(macro, kpp_value, value);
+      }
+    } else {
+      value = DohNone;		/* Non-null marker: a macro always has a value */
+    }
+    if (fl >= 0) {
+      file = restore_field(&p, end, fl);
+      if (file) {
+	Setfile(macro, file);
+	Delete(file);
+      }
+    } else {
+      file = DohNone;
+    }
+    if (vfl >= 0) {
+      vfile = restore_field(&p, end, vfl);
+      if (vfile) {
+	if (vl >= 0)
+	  Setfile(Getattr(macro, kpp_value), vfile);
+	Delete(vfile);
+      }
+    } else {
+      vfile = DohNone;
+    }
+    if (!value || !file || !vfile) {
+      Delete(name);
+      Delete(macro);
+      goto restore_error;
+    }
+    if (al >= 0) {
+      List *arglist = NewList();
+      for (i = 0; i < al; i++) {
+	int alen;
+	String *a;
+	if (sscanf(p, "%d%n", &alen, &nc) != 1)
+	  break;
+	p += nc;
+	if (p >= end || *p != '\n')
+	  break;
+	p++;
+	a = restore_field(&p, end, alen);
+	if (!a)
+	  break;
+	Append(arglist, a);
+	Delete(a);
+      }
+      if (i < al) {
+	Delete(arglist);
+	Delete(name);
+	Delete(value == DohNone ? 0 : value);
+	Delete(macro);
+	goto restore_error;
+      }
+      Setattr(macro, kpp_args, arglist);
+      Delete(arglist);
+      if (varargs)
+	Setattr(macro, kpp_varargs, "1");
+    }
+    if (swigmacro)
+      Setattr(macro, kpp_swigmacro, "1");
+    if (value != DohNone)
+      Delete(value);
+    Setattr(newsymbols, name, macro);
+    Delete(macro);
+    Delete(name);
+  }
+  Setattr(cpp, kpp_symbols, newsymbols);
+  Delete(newsymbols);
+  if (newincluded) {
+    Delete(included_files);
+    included_files = newincluded;
+  }
+  cpp_cache_invalidate();
+  return 0;
+
+restore_error:
+  Delete(newsymbols);
+  Delete(newincluded);
+  return -1;
+}
+
 /* -----------------------------------------------------------------------------
  * Preprocessor_undef()
  *
@@ -568,6 +931,7 @@ void Preprocessor_undef(const_String_or_char_ptr str) {
   assert(cpp);
   symbols = Getattr(cpp, kpp_symbols);
   Delattr(symbols, str);
+  cpp_cache_invalidate();
 }
 
 /* -----------------------------------------------------------------------------
@@ -772,6 +1136,9 @@ static String *expand_macro(String *name, List *args, String *line_file) {
   DOH *symbols, *macro, *margs, *mvalue, *temp, *tempa, *e;
   int i, l;
   int isvarargs = 0;
+  String *ckey = 0;
+  int cgen = 0;
+  int cerrors = 0;
 
   symbols = Getattr(cpp, kpp_symbols);
   if (!symbols)
@@ -782,7 +1149,28 @@ static String *expand_macro(String *name, List *args, String *line_file) {
   if (!macro)
     return 0;
 
+  /* Completed expansions are cached while the symbol table stays unchanged.
+     Only top-level expansions take part: no recursion guards are active and
+     any __LINE__/__FILE__ use is tracked and disqualifies the result. */
   if (macro_level == 0) {
+    ckey = NewString(name);
+    if (args) {
+      for (i = 0; i < Len(args); i++) {
+	Putc('\037', ckey);
+	Append(ckey, Getitem(args, i));
+      }
+    }
+    if (expansion_cache) {
+      String *cached = Getattr(expansion_cache, ckey);
+      if (cached) {
+	Delete(ckey);
+	return Copy(cached);
+      }
+    }
+    cgen = cpp_generation;
+    cerrors = Swig_error_count();
+    expansion_uncacheable = 0;
+
     /* Store the start of the macro should the macro contain __LINE__ and __FILE__ for expansion */
     macro_start_line = Getline(args ? args : line_file);
     macro_start_file = Getfile(args ? args : line_file);
@@ -805,6 +1193,7 @@ static String *expand_macro(String *name, List *args, String *line_file) {
 	Putc(')', ns);
     }
     macro_level--;
+    Delete(ckey);
     return ns;
   }
 
@@ -858,12 +1247,14 @@ static String *expand_macro(String *name, List *args, String *line_file) {
     else
       Swig_error(macro_start_file, macro_start_line, "Macro '%s' expects no arguments\n", name);
     macro_level--;
+    Delete(ckey);
     return 0;
   }
 
   /* If the macro expects arguments, but none were supplied, we leave it in place */
   if (!args && margs) {
     macro_level--;
+    Delete(ckey);
     return NewString(name);
   }
 
@@ -882,7 +1273,6 @@ static String *expand_macro(String *name, List *args, String *line_file) {
       DOH *arg, *aname;
       String *reparg;
       arg = Getitem(args, i);	/* Get an argument value */
-      reparg = Preprocessor_replace(arg);
       aname = Getitem(margs, i);	/* Get macro argument name */
       if (strstr(Char(ns), "\001")) {
 	/* Try to replace a quoted version of the argument */
@@ -976,9 +1366,16 @@ static String *expand_macro(String *name, List *args, String *line_file) {
 	}
       }
       /*      Replace(ns, aname, arg, DOH_REPLACE_ID); */
-      Replace(ns, aname, reparg, DOH_REPLACE_ID);	/* Replace expanded args */
+      if (strstr(Char(ns), Char(aname))) {
+	/* Only expand the argument if the body still uses it at this point.
+	   Stringified, mangled and concatenated uses were consumed by the
+	   marker substitutions above and take the raw argument, so purely
+	   discarded or quoted arguments skip expansion entirely. */
+	reparg = Preprocessor_replace(arg);
+	Replace(ns, aname, reparg, DOH_REPLACE_ID);	/* Replace expanded args */
+	Delete(reparg);
+      }
       Replace(ns, "\003", arg, DOH_REPLACE_ANY);	/* Replace unexpanded arg */
-      Delete(reparg);
     }
   }
   Replace(ns, "\002", "", DOH_REPLACE_ANY);	/* Get rid of concatenation tokens */
@@ -1022,6 +1419,16 @@ static String *expand_macro(String *name, List *args, String *line_file) {
   macro_level--;
   Delete(temp);
   Delete(tempa);
+  if (ckey) {
+    /* Cache the result unless the expansion depended on the invocation site
+       or had side effects (a define/undef/include or an error) */
+    if (e && !expansion_uncacheable && (cpp_generation == cgen) && (Swig_error_count() == cerrors)) {
+      if (!expansion_cache)
+	expansion_cache = NewHash();
+      Setattr(expansion_cache, ckey, e);
+    }
+    Delete(ckey);
+  }
   return e;
 }
 
@@ -1157,11 +1564,13 @@ static DOH *Preprocessor_replace(DOH *s) {
 	  state = 0;
 	  break;
 	} else if (Equal(kpp_LINE, id)) {
+	  expansion_uncacheable = 1;
 	  Printf(ns, "%d", macro_level > 0 ? macro_start_line : Getline(s));
 	  state = 0;
 	  break;
 	} else if (Equal(kpp_FILE, id)) {
 	  String *fn = Copy(macro_level > 0 ? macro_start_file : Getfile(s));
+	  expansion_uncacheable = 1;
 	  Replaceall(fn, "\\", "\\\\");
 	  Printf(ns, "\"%s\"", fn);
 	  Delete(fn);
@@ -1253,9 +1662,11 @@ static DOH *Preprocessor_replace(DOH *s) {
     if (Equal(kpp_defined, id)) {
       Swig_error(Getfile(s), Getline(s), "No arguments given to defined()\n");
     } else if (Equal(kpp_LINE, id)) {
+      expansion_uncacheable = 1;
       Printf(ns, "%d", macro_level > 0 ? macro_start_line : Getline(s));
     } else if (Equal(kpp_FILE, id)) {
       String *fn = Copy(macro_level > 0 ? macro_start_file : Getfile(s));
+      expansion_uncacheable = 1;
       Replaceall(fn, "\\", "\\\\");
       Printf(ns, "\"%s\"", fn);
       Delete(fn);
@@ -1432,6 +1843,10 @@ String *Preprocessor_parse(String *s) {
 	}
       } else if (c == '/')
 	state = 30;		/* Comment */
+      else if (allow)
+	copy_to_delim(s, "%\n\"\'/", chunk);
+      else
+	skip_to_delim(s, "%\n\"\'/", ns);
       break;
 
     case 30:			/* Possibly a comment string of some sort */
@@ -1448,11 +1863,19 @@ String *Preprocessor_parse(String *s) {
       Putc(c, chunk);
       if (c == '\n')
 	state = 0;
+      else if (allow)
+	copy_to_delim(s, "\n", chunk);
+      else
+	skip_to_delim(s, "\n", ns);
       break;
     case 32:
       Putc(c, chunk);
       if (c == '*')
 	state = 33;
+      else if (allow)
+	copy_to_delim(s, "*", chunk);
+      else
+	skip_to_delim(s, "*", ns);
       break;
     case 33:
       Putc(c, chunk);
@@ -1525,6 +1948,8 @@ String *Preprocessor_parse(String *s) {
 	Putc(c, value);
 	if (c == '\\')
 	  state = 44;
+	else
+	  copy_to_delim(s, "\n/\"\'\\", value);
       }
       break;
 
@@ -1560,14 +1985,18 @@ String *Preprocessor_parse(String *s) {
       if (c == '\n') {
 	Ungetc(c, s);
 	state = 50;
-      } else
+      } else {
 	Putc(c, comment);
+	copy_to_delim(s, "\n", comment);
+      }
       break;
     case 47: /* in C comment */
       if (c == '*')
 	state = 48;
-      else
+      else {
 	Putc(c, comment);
+	copy_to_delim(s, "*", comment);
+      }
       break;
     case 48:
       if (c == '/')
@@ -1812,6 +2241,16 @@ String *Preprocessor_parse(String *s) {
               Swig_error(Getfile(s), Getline(id), "Unknown SWIG pragma: %s\n", c);
             }
 	  }
+	} else if (allow) {
+	  char *c = Char(value);
+	  while (*c && (isspace((int) *c)))
+	    c++;
+	  if ((strncmp(c, "once", 4) == 0) && !isidchar((int) c[4])) {
+	    /* #pragma once: mark this file as included so any further
+	       include of it is skipped */
+	    String *file = Getfile(s);
+	    Setattr(included_files, file, file);
+	  }
 	}
       } else if (Equal(id, kpp_level)) {
 	Swig_error(Getfile(s), Getline(id), "cpp debug: level = %d, startlevel = %d\n", level, start_level);
@@ -1862,6 +2301,10 @@ String *Preprocessor_parse(String *s) {
       Putc(c, chunk);
       if (c == '%')
 	state = 106;
+      else if (allow)
+	copy_to_delim(s, "%", chunk);
+      else
+	skip_to_delim(s, "%", ns);
       break;
 
     case 106:
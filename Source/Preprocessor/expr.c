@@ -34,6 +34,10 @@ static int sp = 0;		/* Stack pointer       */
 static int prec[256];		/* Precedence rules    */
 static int expr_init = 0;	/* Initialization flag */
 static const char *errmsg = 0;	/* Parsing error       */
+static Hash *expr_cache = 0;	/* Memoized results, keyed by expression text */
+
+/* Don't bother memoizing unusually long expressions */
+#define EXPR_CACHE_MAXLEN 128
 
 /* Initialize the precedence table for various operators.  Low values have higher precedence */
 static void init_precedence() {
@@ -235,10 +239,14 @@ void Preprocessor_expr_init(void) {
     init_precedence();
   if (!scan)
     scan = NewScanner();
+  if (!expr_cache)
+    expr_cache = NewHash();
 }
 
 void Preprocessor_expr_delete(void) {
   DelScanner(scan);
+  Delete(expr_cache);
+  expr_cache = 0;
 }
 
 
@@ -273,6 +281,17 @@ int Preprocessor_expr(DOH *s, int *error) {
   Seek(s, 0, SEEK_SET);
   /* Printf(stdout,"evaluating : '%s'\n", s); */
   *error = 0;
+
+  /* Callers hand us fully macro-expanded text (including the defined()
+     operator), so the result depends only on the expression string itself
+     and identical expressions can be memoized.  The same version and
+     language guard checks appear in nearly every library file. */
+  if (expr_cache && Len(s) <= EXPR_CACHE_MAXLEN) {
+    String *cached = Getattr(expr_cache, s);
+    if (cached)
+      return (int) atol(Char(cached));
+  }
+
   Scanner_clear(scan);
   Scanner_push(scan, s);
 
@@ -342,6 +361,11 @@ int Preprocessor_expr(DOH *s, int *error) {
 	  } else
 	    goto syntax_error;
 	}
+	if (expr_cache && Len(s) <= EXPR_CACHE_MAXLEN) {
+	  String *result = NewStringf("%ld", stack[sp].value);
+	  Setattr(expr_cache, s, result);
+	  Delete(result);
+	}
 	return stack[sp].value;
       }
       /* Token must be an operator */
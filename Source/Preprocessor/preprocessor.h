@@ -31,6 +31,8 @@ extern "C" {
   extern void Preprocessor_ignore_missing(int);
   extern void Preprocessor_error_as_warning(int);
   extern List *Preprocessor_depend(void);
+  extern String *Preprocessor_save_state(void);
+  extern int Preprocessor_restore_state(const char *buf, int len);
   extern void Preprocessor_expr_init(void);
   extern void Preprocessor_expr_delete(void);
 
@@ -46,6 +46,24 @@ static int warnall = 0;
 static int nwarning = 0;
 static int nerrors = 0;
 
+/* Cache of filter verdicts indexed by warning number.  Scanning the filter
+ * string is linear in its length and happens once per emitted warning, which
+ * adds up when -Wall or heavy %warnfilter use suppresses warnings by the
+ * thousand.  The verdict for a given number only changes when the filter
+ * string itself changes, so remember it and flush on modification.
+ * Warning numbers are three digit codes (see Source/Include/swigwarn.h);
+ * anything out of range falls back to scanning the string directly. */
+#define FILTER_CACHE_SIZE 1000
+static signed char filter_cache[FILTER_CACHE_SIZE];
+static int filter_cache_init = 0;
+
+static void filter_cache_flush(void) {
+  int i;
+  for (i = 0; i < FILTER_CACHE_SIZE; i++)
+    filter_cache[i] = -1;
+  filter_cache_init = 1;
+}
+
 static int init_fmt = 0;
 static char wrn_wnum_fmt[64];
 static char wrn_nnum_fmt[64];
@@ -88,20 +106,30 @@ void Swig_warning(int wnum, const_String_or_char_ptr filename, int line, const c
 
   /* Check in the warning filter */
   if (filter) {
-    char temp[32];
-    char *c;
-    char *f = Char(filter);
-    sprintf(temp, "%d", wnum);
-    while (*f != '\0' && (c = strstr(f, temp))) {
-      if (*(c - 1) == '-') {
-	wrn = 0;		/* Warning disabled */
-        break;
+    int cacheable = (wnum >= 0 && wnum < FILTER_CACHE_SIZE);
+    if (cacheable && filter_cache_init && filter_cache[wnum] != -1) {
+      wrn = filter_cache[wnum];
+    } else {
+      char temp[32];
+      char *c;
+      char *f = Char(filter);
+      sprintf(temp, "%d", wnum);
+      while (*f != '\0' && (c = strstr(f, temp))) {
+	if (*(c - 1) == '-') {
+	  wrn = 0;		/* Warning disabled */
+	  break;
+	}
+	if (*(c - 1) == '+') {
+	  wrn = 1;		/* Warning enabled */
+	  break;
+	}
+	f += strlen(temp);
       }
-      if (*(c - 1) == '+') {
-	wrn = 1;		/* Warning enabled */
-        break;
+      if (cacheable) {
+	if (!filter_cache_init)
+	  filter_cache_flush();
+	filter_cache[wnum] = (signed char) wrn;
       }
-      f += strlen(temp);
     }
   }
   if (warnall || wrn) {
@@ -222,6 +250,7 @@ void Swig_warnfilter(const_String_or_char_ptr wlist, int add) {
     c = strtok(NULL, ", ");
   }
   Delete(s);
+  filter_cache_flush();
 }
 
 void Swig_warnall(void) {
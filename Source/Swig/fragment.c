@@ -22,6 +22,7 @@
 
 static Hash *fragments = 0;
 static Hash *looking_fragments = 0;
+static Hash *emitted_fragment_bodies = 0;
 static int debug = 0;
 
 
@@ -109,6 +110,17 @@ void Swig_fragment_emit(Node *n) {
     mangle = Swig_string_mangle(type);
   }
 
+  /* Fast path: once a fragment has been emitted its table entry is replaced
+     by "ignore", and almost every call after the first few wrappers asks for
+     fragments that are already out.  Answer those with one lookup instead of
+     copying and tokenizing the name.  Comma lists miss the lookup (their
+     entry is keyed per component) and fall through to the full path. */
+  if (!type) {
+    code = Getattr(fragments, name);
+    if (code && Strcmp(code, "ignore") == 0)
+      return;
+  }
+
   if (debug)
     Printf(stdout, "looking fragment %s %s\n", name, type);
   t = Copy(name);
@@ -147,13 +159,27 @@ void Swig_fragment_emit(Node *n) {
 	if (!f) {
 	  Swig_error(Getfile(code), Getline(code), "Bad section '%s' in %%fragment declaration for code fragment '%s'\n", section, name);
 	} else {
-	  if (debug)
-	    Printf(stdout, "emitting subfragment %s %s\n", name, section);
-	  if (debug)
-	    Printf(f, "/* begin fragment %s */\n", name);
-	  Printf(f, "%s\n", code);
-	  if (debug)
-	    Printf(f, "/* end fragment %s */\n\n", name);
+	  /* Generated interfaces sometimes register byte-identical bodies
+	     under different names; emit such a body into a section once.
+	     The fragment itself is still marked emitted and its fragment
+	     kwargs above were still followed, so dependencies are kept */
+	  String *bodykey = NewStringf("%s%c%s", section, 1, code);
+	  if (!emitted_fragment_bodies)
+	    emitted_fragment_bodies = NewHash();
+	  if (Getattr(emitted_fragment_bodies, bodykey)) {
+	    if (debug)
+	      Printf(stdout, "skipping duplicate fragment body %s %s\n", name, section);
+	  } else {
+	    Setattr(emitted_fragment_bodies, bodykey, "1");
+	    if (debug)
+	      Printf(stdout, "emitting subfragment %s %s\n", name, section);
+	    if (debug)
+	      Printf(f, "/* begin fragment %s */\n", name);
+	    Printf(f, "%s\n", code);
+	    if (debug)
+	      Printf(f, "/* end fragment %s */\n\n", name);
+	  }
+	  Delete(bodykey);
 	  Setattr(fragments, name, "ignore");
 	  Delattr(looking_fragments, name);
 	}
@@ -15,6 +15,14 @@
 
 #include "swig.h"
 
+#if defined(__unix__)
+#include <fcntl.h>		/* posix_fadvise, for Swig_file_prefetch */
+#endif
+#if !defined(_WIN32)
+#include <dirent.h>		/* directory listing cache */
+#include <errno.h>
+#endif
+
 static List   *directories = 0;	        /* List of include directories */
 static String *lastpath = 0;	        /* Last file that was included */
 static List   *pdirectories = 0;        /* List of pushed directories  */
@@ -151,10 +159,62 @@ List *Swig_search_path() {
 
 
 
+/* -----------------------------------------------------------------------------
+ * candidate_fopen()
+ *
+ * Open a candidate pathname from the include search, consulting a per-run
+ * cache of directory listings first.  A run with many -I directories probes
+ * almost all of them unsuccessfully for every include, so each searched
+ * directory is read once and later existence checks are memory-only.  A
+ * directory that cannot be listed for a reason other than not existing is
+ * marked as such and probed directly, as is every candidate on platforms
+ * without dirent.  Directories are assumed not to change during the run,
+ * consistent with the preprocessor's include caches.
+ * ----------------------------------------------------------------------------- */
+
+static Hash *dir_listings = 0;	/* directory -> Hash of entry names, or "?" if unlistable */
+
+static FILE *candidate_fopen(String *filename) {
+#if !defined(_WIN32)
+  char *path = Char(filename);
+  char *base = strrchr(path, SWIG_FILE_DELIMITER[0]);
+  if (base && base[1]) {
+    DOH *listing;
+    String *dir = NewStringWithSize(path, (int) (base - path) + 1);
+    if (!dir_listings)
+      dir_listings = NewHash();
+    listing = Getattr(dir_listings, dir);
+    if (!listing) {
+      DIR *d = opendir(Char(dir));
+      if (d) {
+	struct dirent *e;
+	listing = NewHash();
+	while ((e = readdir(d)))
+	  Setattr(listing, e->d_name, "");
+	closedir(d);
+      } else if (errno == ENOENT || errno == ENOTDIR) {
+	listing = NewHash();	/* empty: everything in it is absent */
+      } else {
+	listing = NewString("?");	/* exists but unlistable: always probe */
+      }
+      Setattr(dir_listings, dir, listing);
+      Delete(listing);
+      listing = Getattr(dir_listings, dir);
+    }
+    if (DohIsMapping(listing) && !Getattr(listing, base + 1)) {
+      Delete(dir);
+      return 0;
+    }
+    Delete(dir);
+  }
+#endif
+  return fopen(Char(filename), "r");
+}
+
 /* -----------------------------------------------------------------------------
  * Swig_open()
  *
- * open a file, optionally looking for it in the include path.  Returns an open  
+ * open a file, optionally looking for it in the include path.  Returns an open
  * FILE * on success.
  * ----------------------------------------------------------------------------- */
 
@@ -183,7 +243,7 @@ static FILE *Swig_open_file(const_String_or_char_ptr name, int sysfile, int use_
     for (i = 0; i < ilen; i++) {
       Clear(filename);
       Printf(filename, "%s%s", Getitem(spath, i), cname);
-      f = fopen(Char(filename), "r");
+      f = candidate_fopen(filename);
       if (f)
 	break;
     }
@@ -209,6 +269,57 @@ FILE *Swig_include_open(const_String_or_char_ptr name) {
   return Swig_open_file(name, 0, 1);
 }
 
+/* -----------------------------------------------------------------------------
+ * Swig_file_prefetch()
+ *
+ * Hint to the kernel that a file named by an include directive will be read
+ * soon.  The preprocessor calls this for the #include/%include lines it can
+ * see in a file it has just loaded, so on a cold cache (network filesystems
+ * in particular) the reads overlap with preprocessing of the current file
+ * instead of stalling when the directive is reached.  The name is resolved
+ * against the search path like Swig_include_open but no include state
+ * (lastpath, pushed directories) is touched.  Purely advisory: any failure
+ * is silently ignored and the later real open reports errors as usual.
+ * ----------------------------------------------------------------------------- */
+
+void Swig_file_prefetch(const_String_or_char_ptr name, int sysfile) {
+#if defined(POSIX_FADV_WILLNEED)
+  static Hash *prefetched = 0;
+  FILE *f;
+  String *filename;
+  char *cname = Char(name);
+
+  if (!prefetched)
+    prefetched = NewHash();
+  if (Getattr(prefetched, name))
+    return;
+  Setattr(prefetched, name, name);
+
+  filename = NewString(cname);
+  f = fopen(Char(filename), "r");
+  if (!f) {
+    List *spath = Swig_search_path_any(sysfile);
+    int i, ilen = Len(spath);
+    for (i = 0; i < ilen; i++) {
+      Clear(filename);
+      Printf(filename, "%s%s", Getitem(spath, i), cname);
+      f = candidate_fopen(filename);
+      if (f)
+	break;
+    }
+    Delete(spath);
+  }
+  if (f) {
+    posix_fadvise(fileno(f), 0, 0, POSIX_FADV_WILLNEED);
+    fclose(f);
+  }
+  Delete(filename);
+#else
+  (void) name;
+  (void) sysfile;
+#endif
+}
+
 /* Open a file - does not use include paths to find it */
 FILE *Swig_open(const_String_or_char_ptr name) {
   return Swig_open_file(name, 0, 0);
@@ -225,11 +336,31 @@ FILE *Swig_open(const_String_or_char_ptr name) {
 String *Swig_read_file(FILE *f) {
   int len;
   char buffer[4096];
+  long curpos, endpos;
   String *str = NewStringEmpty();
 
   assert(str);
-  while (fgets(buffer, 4095, f)) {
-    Append(str, buffer);
+  /* For seekable files read the remaining contents in a single gulp
+     straight from the page cache rather than line by line */
+  curpos = ftell(f);
+  endpos = -1;
+  if ((curpos >= 0) && (fseek(f, 0, SEEK_END) == 0)) {
+    endpos = ftell(f);
+    if (fseek(f, curpos, SEEK_SET) != 0)
+      endpos = -1;
+  }
+  if (endpos > curpos) {
+    long size = endpos - curpos;
+    char *contents = (char *) DohMalloc(size + 1);
+    size_t nread = fread(contents, 1, (size_t) size, f);
+    contents[nread] = 0;
+    Append(str, contents);
+    DohFree(contents);
+  } else if (endpos < 0) {
+    /* Not seekable (e.g. a pipe): fall back to buffered line reads */
+    while (fgets(buffer, 4095, f)) {
+      Append(str, buffer);
+    }
   }
   len = Len(str);
   /* Add a newline if not present on last line -- the preprocessor seems to 
@@ -693,6 +693,8 @@ String *Swig_string_typecode(String *s) {
  * A_get_value. 
  * ----------------------------------------------------------------------------- */
 
+static Hash *mangle_cache = 0;
+
 String *Swig_string_mangle(const String *s) {
 #if 0
   /* old mangling, not suitable for using in macros */
@@ -705,12 +707,28 @@ String *Swig_string_mangle(const String *s) {
   }
   return t;
 #else
-  String *result = NewStringEmpty();
+  String *result;
   int space = 0;
   int state = 0;
+  int is_template;
   char *pc, *cb;
   String *b = Copy(s);
-  if (SwigType_istemplate(b)) {
+  is_template = SwigType_istemplate(b);
+  if (!is_template) {
+    /* For non-template input the mangling is a pure character transform,
+       so the result can be cached on the input string.  The template path
+       below qualifies the type in the current scope and is not cacheable. */
+    String *cached;
+    if (!mangle_cache)
+      mangle_cache = NewHash();
+    cached = Getattr(mangle_cache, s);
+    if (cached) {
+      Delete(b);
+      return Copy(cached);
+    }
+  }
+  result = NewStringEmpty();
+  if (is_template) {
     String *st = Swig_symbol_template_deftype(b, 0);
     String *sq = Swig_symbol_type_qualify(st, 0);
     String *t = SwigType_namestr(sq);
@@ -723,12 +741,19 @@ String *Swig_string_mangle(const String *s) {
   while (*pc) {
     char c = *pc;
     if (isalnum((int) c) || (c == '_')) {
+      /* Copy the whole identifier run in one write rather than pushing the
+         characters through Printf one at a time */
+      char *run = pc;
       state = 1;
       if (space && (space == state)) {
 	Append(result, "_SS_");
       }
       space = 0;
-      Printf(result, "%c", (int) c);
+      do {
+	c = *++pc;
+      } while (isalnum((int) c) || (c == '_'));
+      Write(result, run, (int) (pc - run));
+      continue;
 
     } else {
       if (isspace((int) c)) {
@@ -826,6 +851,15 @@ String *Swig_string_mangle(const String *s) {
     ++pc;
   }
   Delete(b);
+  if (!is_template) {
+    /* Key on a private copy so later in-place edits of the caller's type
+       string cannot alias the cache entry */
+    String *key = Copy(s);
+    String *cached = Copy(result);
+    Setattr(mangle_cache, key, cached);
+    Delete(key);
+    Delete(cached);
+  }
   return result;
 #endif
 }
@@ -1445,26 +1479,54 @@ String *replace_captures(int num_captures, const char *input, String *subst, int
  *
  *   Printf(stderr,"gsl%(regex:/GSL_(.*)_/\\1/)s", "GSL_Hello_") -> gslHello
  * ----------------------------------------------------------------------------- */
+/* A "%(regex:/pat/sub/)s" format string is applied to every symbol it
+   renames, so keep the compiled form of each distinct pattern rather than
+   recompiling it per use.  The compiled block is wrapped in a void object
+   so the cache owns and frees it */
+
+static Hash *compiled_patterns = 0;
+
+static pcre *regex_compile(String *s, String *pattern, int pcre_options) {
+  pcre *compiled_pat;
+  DOH *entry;
+  const char *pcre_error;
+  int pcre_errorpos;
+
+  if (!compiled_patterns)
+    compiled_patterns = NewHash();
+  entry = Getattr(compiled_patterns, pattern);
+  if (entry)
+    return (pcre *) Data(entry);
+
+  compiled_pat = pcre_compile(Char(pattern), pcre_options, &pcre_error, &pcre_errorpos, NULL);
+  if (!compiled_pat) {
+    Swig_error("SWIG", Getline(s), "PCRE compilation failed: '%s' in '%s':%i.\n",
+	pcre_error, Char(pattern), pcre_errorpos);
+    SWIG_exit(EXIT_FAILURE);
+  }
+
+  entry = NewVoid(compiled_pat, (void (*)(void *)) pcre_free);
+  {
+    String *key = NewString(pattern);
+    Setattr(compiled_patterns, key, entry);
+    Delete(key);
+  }
+  Delete(entry);
+  return compiled_pat;
+}
+
 String *Swig_string_regex(String *s) {
   const int pcre_options = 0;
 
   String *res = 0;
-  pcre *compiled_pat = 0;
-  const char *pcre_error, *input;
-  int pcre_errorpos;
+  const char *input;
   String *pattern = 0, *subst = 0;
   int captures[30];
 
   if (split_regex_pattern_subst(s, &pattern, &subst, &input)) {
     int rc;
 
-    compiled_pat = pcre_compile(
-          Char(pattern), pcre_options, &pcre_error, &pcre_errorpos, NULL);
-    if (!compiled_pat) {
-      Swig_error("SWIG", Getline(s), "PCRE compilation failed: '%s' in '%s':%i.\n",
-          pcre_error, Char(pattern), pcre_errorpos);
-      SWIG_exit(EXIT_FAILURE);
-    }
+    pcre *compiled_pat = regex_compile(s, pattern, pcre_options);
     rc = pcre_exec(compiled_pat, NULL, input, (int)strlen(input), 0, 0, captures, 30);
     if (rc >= 0) {
       res = replace_captures(rc, input, subst, captures, pattern, s);
@@ -1477,7 +1539,6 @@ String *Swig_string_regex(String *s) {
 
   DohDelete(pattern);
   DohDelete(subst);
-  pcre_free(compiled_pat);
   return res ? res : NewStringEmpty();
 }
 
@@ -750,6 +750,14 @@ static Hash *name_namewarn_hash() {
   return namewarn_hash;
 }
 
+/* True while every entry in namewarn_hash is keyed by a plain unscoped name
+   with no declarator.  That is the normal situation: the bulk of the hash is
+   the target language keyword tables (languagekw.swg), which are all simple
+   names.  While it holds, a namewarn lookup is a single hash probe instead of
+   the scoped lookup cascade of Swig_name_object_get, which builds several
+   qualified name strings per queried symbol. */
+static int namewarn_simple = 1;
+
 static Hash *rename_hash = 0;
 static Hash *name_rename_hash() {
   if (!rename_hash)
@@ -1061,6 +1069,8 @@ static void name_nameobj_add(Hash *name_hash, List *name_list, String *prefix, S
   } else {
     /* here we add an old 'hash' nameobj, simple and fast */
     Swig_name_object_set(name_hash, nname, decl, nameobj);
+    if ((name_hash == namewarn_hash) && (decl || Strchr(nname, ':')))
+      namewarn_simple = 0;
   }
   Delete(nname);
 }
@@ -1094,11 +1104,24 @@ static DOH *get_lattr(Node *n, List *lattr) {
 #ifdef HAVE_PCRE
 #include <pcre.h>
 
-static int name_regexmatch_value(Node *n, String *pattern, String *s) {
+/* Each regexmatch/regextarget rule is evaluated against every declaration,
+   so compile a pattern the first time it is seen and reuse it, instead of
+   round-tripping through pcre_compile per node.  The compiled pattern is
+   wrapped in a void object so the cache owns it */
+
+static Hash *compiled_patterns = 0;
+
+static pcre *name_regex_compile(Node *n, String *pattern) {
   pcre *compiled_pat;
+  DOH *entry;
   const char *err;
   int errpos;
-  int rc;
+
+  if (!compiled_patterns)
+    compiled_patterns = NewHash();
+  entry = Getattr(compiled_patterns, pattern);
+  if (entry)
+    return (pcre *) Data(entry);
 
   compiled_pat = pcre_compile(Char(pattern), 0, &err, &errpos, NULL);
   if (!compiled_pat) {
@@ -1108,8 +1131,19 @@ static int name_regexmatch_value(Node *n, String *pattern, String *s) {
     SWIG_exit(EXIT_FAILURE);
   }
 
-  rc = pcre_exec(compiled_pat, NULL, Char(s), Len(s), 0, 0, NULL, 0);
-  pcre_free(compiled_pat);
+  entry = NewVoid(compiled_pat, (void (*)(void *)) pcre_free);
+  {
+    String *key = NewString(pattern);
+    Setattr(compiled_patterns, key, entry);
+    Delete(key);
+  }
+  Delete(entry);
+  return compiled_pat;
+}
+
+static int name_regexmatch_value(Node *n, String *pattern, String *s) {
+  pcre *compiled_pat = name_regex_compile(n, pattern);
+  int rc = pcre_exec(compiled_pat, NULL, Char(s), Len(s), 0, 0, NULL, 0);
 
   if (rc == PCRE_ERROR_NOMATCH)
     return 0;
@@ -1297,7 +1331,36 @@ static Hash *name_namewarn_get(Node *n, String *prefix, String *name, SwigType *
   }
   if (name) {
     /* Check to see if the name is in the hash */
-    Hash *wrn = Swig_name_object_get(name_namewarn_hash(), prefix, name, decl);
+    Hash *wrn;
+    if (namewarn_simple && namewarn_hash) {
+      /* Only plain names in the hash, so the only probes of the scoped
+         cascade that can hit are the unqualified ones; do those directly. */
+      wrn = 0;
+      if (prefix && Len(prefix)) {
+	String *t_name = SwigType_istemplate_templateprefix(name);
+	if (t_name) {
+	  Hash *nw = Getattr(namewarn_hash, t_name);
+	  wrn = nw ? Getattr(nw, "start") : 0;
+	  Delete(t_name);
+	}
+      }
+      if (!wrn) {
+	Hash *nw = Getattr(namewarn_hash, name);
+	wrn = nw ? Getattr(nw, "start") : 0;
+      }
+      if (!wrn && Swig_scopename_check(name)) {
+	String *nprefix = 0;
+	String *nlast = 0;
+	Hash *nw;
+	Swig_scopename_split(name, &nprefix, &nlast);
+	nw = Getattr(namewarn_hash, nlast);
+	wrn = nw ? Getattr(nw, "start") : 0;
+	Delete(nlast);
+	Delete(nprefix);
+      }
+    } else {
+      wrn = Swig_name_object_get(name_namewarn_hash(), prefix, name, decl);
+    }
     if (wrn && !name_match_nameobj(wrn, n))
       wrn = 0;
     if (!wrn) {
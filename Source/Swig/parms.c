@@ -150,7 +150,12 @@ int ParmList_len(ParmList *p) {
  * ---------------------------------------------------------------------- */
 
 static SwigType *get_empty_type() {
-  return NewStringEmpty();
+  /* SwigType_str treats its argument as read-only, so hand out one shared
+     empty type instead of allocating (and leaking) one per untyped parm */
+  static SwigType *empty_type = 0;
+  if (!empty_type)
+    empty_type = NewStringEmpty();
+  return empty_type;
 }
 
 /* ---------------------------------------------------------------------
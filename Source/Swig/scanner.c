@@ -225,12 +225,72 @@ static char nextchar(Scanner *s) {
     s->line = Getline(s->str);
     DohIncref(s->str);
   }
-  if ((nc == '\n') && (!s->freeze_line)) 
+  if ((nc == '\n') && (!s->freeze_line))
     s->line++;
   Putc(nc,s->text);
   return (char)nc;
 }
 
+/* -----------------------------------------------------------------------------
+ * nextchars_to()
+ *
+ * Bulk version of nextchar(): appends the run of characters up to (but not
+ * including) the next character from the delimiter set to the token text.
+ * Scanning runs over the raw buffer with strcspn instead of a byte at a
+ * time.  Stops at the end of the current input object; the caller keeps
+ * driving the state machine with nextchar(), which handles switching to
+ * the next object on the scanner stack.  nextchars_bulk() is the common
+ * consumption step shared with nextchars_in() below.
+ * ----------------------------------------------------------------------------- */
+static void nextchars_bulk(Scanner *s, const char *base, int pos, size_t n) {
+  const char *p, *e;
+  int nl = 0;
+  if (n == 0)
+    return;
+  p = base + pos;
+  e = p + n;
+  while ((p = (const char *) memchr(p, '\n', e - p)) != 0) {
+    nl++;
+    p++;
+  }
+  {
+    /* Seek counts newlines over (pos, pos+n], not the consumed range
+       [pos, pos+n), so set the line explicitly to match Getc */
+    int line = Getline(s->str);
+    Write(s->text, base + pos, (int) n);
+    Seek(s->str, (long) n, SEEK_CUR);
+    Setline(s->str, line + nl);
+  }
+  if (!s->freeze_line)
+    s->line += nl;
+}
+
+static void nextchars_to(Scanner *s, const char *delim) {
+  char *base;
+  int pos;
+  if (!s->str)
+    return;
+  base = Char(s->str);
+  pos = Tell(s->str);
+  nextchars_bulk(s, base, pos, strcspn(base + pos, delim));
+}
+
+/* -----------------------------------------------------------------------------
+ * nextchars_in()
+ *
+ * Like nextchars_to(), but appends the run of characters drawn from the
+ * given set, e.g. the digits of a numeric literal.
+ * ----------------------------------------------------------------------------- */
+static void nextchars_in(Scanner *s, const char *set) {
+  char *base;
+  int pos;
+  if (!s->str)
+    return;
+  base = Char(s->str);
+  pos = Tell(s->str);
+  nextchars_bulk(s, base, pos, strspn(base + pos, set));
+}
+
 /* -----------------------------------------------------------------------------
  * set_error() 
  *
@@ -375,13 +435,14 @@ static void retract(Scanner *s, int n) {
   str = Char(s->text);
   l = Len(s->text);
   assert(n <= l);
-  for (i = 0; i < n; i++) {
-    if (str[l - 1] == '\n') {
-      if (!s->freeze_line) s->line--;
+  if (!s->freeze_line) {
+    for (i = l - n; i < l; i++) {
+      if (str[i] == '\n')
+	s->line--;
     }
-    (void)Seek(s->str, -1, SEEK_CUR);
-    Delitem(s->text, DOH_END);
   }
+  (void)Seek(s->str, -n, SEEK_CUR);
+  Delslice(s->text, l - n, l);
 }
 
 /* -----------------------------------------------------------------------------
@@ -675,6 +736,7 @@ static int look(Scanner *s) {
 	return SWIG_TOKEN_COMMENT;
       } else {
 	state = 10;
+	nextchars_to(s, "\n");
       }
       break;
     case 11:			/* C style comment block */
@@ -686,6 +748,7 @@ static int look(Scanner *s) {
 	state = 12;
       } else {
 	state = 11;
+	nextchars_to(s, "*");
       }
       break;
     case 12:			/* Still in C style comment */
@@ -736,6 +799,8 @@ static int look(Scanner *s) {
 	} else if (c == '\\') {
 	  Delitem(s->text, DOH_END);
 	  get_escape(s);
+	} else {
+	  nextchars_to(s, "\"\\");
 	}
       } else {             /* Custom delimiter string: R"XXXX(value)XXXX" */
 	if (c==')') {
@@ -841,6 +906,9 @@ static int look(Scanner *s) {
       break;
 
     case 40:			/* Process an include block */
+      /* Consume the run up to the next '%' in bulk; code blocks are often
+         the largest tokens in an interface file */
+      nextchars_to(s, "%");
       if ((c = nextchar(s)) == 0) {
 	Swig_error(cparse_file, cparse_start_line, "Unterminated block\n");
 	return SWIG_TOKEN_ERROR;
@@ -1089,6 +1157,7 @@ static int look(Scanner *s) {
       break;
 
     case 8:			/* A numerical digit */
+      nextchars_in(s, "0123456789");
       if ((c = nextchar(s)) == 0)
 	return SWIG_TOKEN_INT;
       if (c == '.') {
@@ -1179,6 +1248,7 @@ static int look(Scanner *s) {
       break;
     case 84:
       /* This is an octal number */
+      nextchars_in(s, "0123456789");
       if ((c = nextchar(s)) == 0)
 	return SWIG_TOKEN_INT;
       if (isdigit(c))
@@ -1198,6 +1268,7 @@ static int look(Scanner *s) {
       break;
     case 85:
       /* This is an hex number */
+      nextchars_in(s, "0123456789abcdefABCDEF");
       if ((c = nextchar(s)) == 0)
 	return SWIG_TOKEN_INT;
       if (isxdigit(c))
@@ -1217,6 +1288,7 @@ static int look(Scanner *s) {
       break;
     case 850:
       /* This is a binary number */
+      nextchars_in(s, "01");
       if ((c = nextchar(s)) == 0)
 	return SWIG_TOKEN_INT;
       if ((c == '0') || (c == '1'))
@@ -1232,6 +1304,7 @@ static int look(Scanner *s) {
       break;
     case 860:
       /* hexadecimal float */
+      nextchars_in(s, "0123456789abcdefABCDEF");
       if ((c = nextchar(s)) == 0) {
 	Swig_error(cparse_file, cparse_start_line, "Hexadecimal floating literals require an exponent\n");
 	return SWIG_TOKEN_ERROR;
@@ -1249,6 +1322,7 @@ static int look(Scanner *s) {
     case 86:
       /* Rest of floating point number */
 
+      nextchars_in(s, "0123456789");
       if ((c = nextchar(s)) == 0)
 	return SWIG_TOKEN_DOUBLE;
       if (isdigit(c))
@@ -100,9 +100,38 @@
  * this pretty easy.
  *
  * Why not use a bunch of nested data structures?  Are you kidding? How
- * would that be easier to use than a few simple string operations? 
+ * would that be easier to use than a few simple string operations?
  * ----------------------------------------------------------------------------- */
 
+/* -----------------------------------------------------------------------------
+ * Stringification memos
+ *
+ * The same types are stringified and mangled hundreds of times across
+ * wrappers (every parameter of every overload), so the results are
+ * remembered per distinct input.  SwigType_str is a pure decode of the
+ * encoding and its memo never needs invalidating.  SwigType_ltype and the
+ * mangled form reduce types through the type system, so their memos are
+ * dropped whenever the type system generation changes; the mangled form
+ * additionally canonicalizes template types through the symbol table, so
+ * the current symbol scope participates in its key.
+ * ----------------------------------------------------------------------------- */
+
+static Hash *str_memo = 0;	/* (type, id) -> SwigType_str() result */
+static Hash *ltype_memo = 0;	/* type -> SwigType_ltype() result */
+static Hash *mangle_memo = 0;	/* (symbol scope, type) -> manglestr result */
+static unsigned long stype_memo_generation = 0;
+
+/* Drop the resolution-dependent memos if the type system has moved on */
+static void stype_memo_check(void) {
+  unsigned long generation = SwigType_typesystem_generation();
+  if (generation != stype_memo_generation) {
+    Delete(ltype_memo);
+    Delete(mangle_memo);
+    ltype_memo = 0;
+    mangle_memo = 0;
+    stype_memo_generation = generation;
+  }
+}
 
 SwigType *NewSwigType(int t) {
   switch (t) {
@@ -237,7 +266,7 @@ int SwigType_isconst(const SwigType *t) {
     return 0;
   c = Char(t);
   if (strncmp(c, "q(", 2) == 0) {
-    String *q = SwigType_parm(t);
+    String *q = SwigType_parm_view(t);
     if (strstr(Char(q), "const")) {
       Delete(q);
       return 1;
@@ -547,6 +576,18 @@ String *SwigType_str(const SwigType *s, const_String_or_char_ptr id) {
   SwigType *member_function_qualifiers = 0;
   List *elements;
   int nelements, i;
+  String *memokey;
+
+  memokey = NewStringf("%s\001%s", s, id ? id : (const_String_or_char_ptr) "");
+  if (str_memo) {
+    result = Getattr(str_memo, memokey);
+    if (result) {
+      Delete(memokey);
+      return Copy(result);
+    }
+  } else {
+    str_memo = NewHash();
+  }
 
   if (id) {
     /* stringify the id expanding templates, for example when the id is a fully qualified templated class name */
@@ -667,6 +708,14 @@ String *SwigType_str(const SwigType *s, const_String_or_char_ptr id) {
   }
   Delete(elements);
   Chop(result);
+  /* Keep the memo's copy private: callers own (and may modify) the result */
+  Setattr(str_memo, memokey, result);
+  Delete(memokey);
+  {
+    String *r1 = Copy(result);
+    Delete(result);
+    result = r1;
+  }
   return result;
 }
 
@@ -686,6 +735,15 @@ SwigType *SwigType_ltype(const SwigType *s) {
   int notypeconv = 0;
   int ignore_member_function_qualifiers = 0;
 
+  stype_memo_check();
+  if (ltype_memo) {
+    result = Getattr(ltype_memo, s);
+    if (result)
+      return Copy(result);
+  } else {
+    ltype_memo = NewHash();
+  }
+
   result = NewStringEmpty();
   tc = Copy(s);
   /* Nuke all leading qualifiers */
@@ -783,6 +841,15 @@ SwigType *SwigType_ltype(const SwigType *s) {
   }
   Delete(elements);
   Delete(tc);
+  {
+    String *key = NewString(s);
+    String *r1;
+    Setattr(ltype_memo, key, result);
+    Delete(key);
+    r1 = Copy(result);
+    Delete(result);
+    result = r1;
+  }
   return result;
 }
 
@@ -1251,6 +1318,8 @@ static String *manglestr_default(const SwigType *s) {
 #endif
 
 String *SwigType_manglestr(const SwigType *s) {
+  String *result;
+  String *memokey;
 #if 0
   /* Debugging checks to ensure a proper SwigType is passed in and not a stringified type */
   String *angle = Strstr(s, "<");
@@ -1259,7 +1328,26 @@ String *SwigType_manglestr(const SwigType *s) {
   else if (Strstr(s, "*") || Strstr(s, "&") || Strstr(s, "["))
     Printf(stderr, "SwigType_manglestr error: %s\n", s);
 #endif
-  return manglestr_default(s);
+  stype_memo_check();
+  memokey = NewStringf("%p\001%s", (void *) Swig_symbol_current(), s);
+  if (mangle_memo) {
+    result = Getattr(mangle_memo, memokey);
+    if (result) {
+      Delete(memokey);
+      return Copy(result);
+    }
+  } else {
+    mangle_memo = NewHash();
+  }
+  result = manglestr_default(s);
+  Setattr(mangle_memo, memokey, result);
+  Delete(memokey);
+  {
+    String *r1 = Copy(result);
+    Delete(result);
+    result = r1;
+  }
+  return result;
 }
 
 /* -----------------------------------------------------------------------------
@@ -143,6 +143,7 @@ extern "C" {
   extern void SwigType_push(SwigType *t, String *s);
   extern List *SwigType_parmlist(const SwigType *p);
   extern String *SwigType_parm(const SwigType *p);
+  extern String *SwigType_parm_view(const SwigType *p);
   extern String *SwigType_str(const SwigType *s, const_String_or_char_ptr id);
   extern String *SwigType_lstr(const SwigType *s, const_String_or_char_ptr id);
   extern String *SwigType_rcaststr(const SwigType *s, const_String_or_char_ptr id);
@@ -201,6 +202,8 @@ extern "C" {
   extern void SwigType_inherit_scope(Typetab *scope);
   extern Typetab *SwigType_pop_scope(void);
   extern Typetab *SwigType_set_scope(Typetab *h);
+  extern unsigned long SwigType_typesystem_generation(void);
+  extern void SwigType_resolve_stats(unsigned long *calls, unsigned long *cache_hits, unsigned long *max_depth);
   extern void SwigType_print_scope(void);
   extern SwigType *SwigType_typedef_resolve(const SwigType *t);
   extern SwigType *SwigType_typedef_resolve_all(const SwigType *t);
@@ -213,12 +216,16 @@ extern "C" {
   extern void SwigType_remember_mangleddata(String *mangled, const_String_or_char_ptr clientdata);
   extern void (*SwigType_remember_trace(void (*tf) (const SwigType *, String *, String *))) (const SwigType *, String *, String *);
   extern void SwigType_emit_type_table(File *f_headers, File *f_table);
+  extern int SwigType_export_type_manifest(const_String_or_char_ptr filename);
+  extern int SwigType_import_type_manifest(const_String_or_char_ptr filename);
   extern int SwigType_type(const SwigType *t);
 
 /* --- Symbol table module --- */
 
   extern void Swig_symbol_print_tables(Symtab *symtab);
   extern void Swig_symbol_print_tables_summary(void);
+  extern void Swig_symbol_lookup_stats(unsigned long *clookup_calls, unsigned long *qualified_lookups);
+  extern Hash *Swig_symbol_symtabs(void);
   extern void Swig_symbol_print_symbols(void);
   extern void Swig_symbol_print_csymbols(void);
   extern void Swig_symbol_init(void);
@@ -407,6 +414,10 @@ extern int        ParmList_is_compactdefargs(ParmList *p);
   extern void Swig_typemap_clear_apply(ParmList *pattern);
   extern void Swig_typemap_replace_embedded_typemap(String *s, Node *file_line_node);
   extern void Swig_typemap_debug(void);
+  extern void Swig_typemap_search_stats(unsigned long *calls, unsigned long *memo_hits, unsigned long *reductions);
+  extern void Swig_typemap_search_stats_permethod(int enable);
+  extern Hash *Swig_typemap_search_stats_methods(void);
+  extern Hash *Swig_typemap_registry(void);
   extern void Swig_typemap_search_debug_set(void);
   extern void Swig_typemap_used_debug_set(void);
   extern void Swig_typemap_register_debug_set(void);
@@ -21,6 +21,8 @@ typedef struct Wrapper {
 extern Wrapper *NewWrapper(void);
 extern void     DelWrapper(Wrapper *w);
 extern void     Wrapper_compact_print_mode_set(int flag);
+extern void     Wrapper_dedup_mode_set(int flag);
+extern void     Wrapper_peephole_mode_set(int flag);
 extern void     Wrapper_pretty_print(String *str, File *f);
 extern void     Wrapper_compact_print(String *str, File *f);
 extern void     Wrapper_print(Wrapper *w, File *f);
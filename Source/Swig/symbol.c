@@ -176,6 +176,36 @@ static Hash *global_scope = 0;	/* Global scope */
 
 static int use_inherit = 1;
 
+/* Merged set of every name ever added to a C symbol table.  A plain,
+   untemplated name absent from this set cannot be found by any scope chain
+   or inherited-scope walk, so the lookup fails without touching a single
+   scope.  Undefined names are the common case during template argument
+   deduction.  Names are never removed: a stale entry only means the walk
+   runs and fails the slow way, so replaced weak symbols need no upkeep.
+   Template names are exempt because lookups retry them under their
+   per-scope canonical spelling. */
+static Hash *all_sym_names = 0;
+
+/* Generation stamp for the qualified scope name memo kept on each symbol
+   table node.  Starts at 1 so a node with no stamp attribute (GetInt
+   returns 0) never looks up to date. */
+static int scopename_generation = 1;
+
+/* Counters for -debug-stats */
+static unsigned long stats_clookup_calls = 0;
+static unsigned long stats_qualified_lookups = 0;
+
+void Swig_symbol_lookup_stats(unsigned long *clookup_calls, unsigned long *qualified_lookups) {
+  *clookup_calls = stats_clookup_calls;
+  *qualified_lookups = stats_qualified_lookups;
+}
+
+/* Registry of all symbol tables by fully-qualified scope name, exposed so
+   -debug-stats can report its probe-distance distribution. */
+Hash *Swig_symbol_symtabs(void) {
+  return symtabs;
+}
+
 /* common attribute keys, to avoid calling find_key all the times */
 
 
@@ -285,6 +315,8 @@ void Swig_symbol_init(void) {
   Setattr(current_symtab, "csymtab", ccurrent);
   Delete(ccurrent);
 
+  all_sym_names = NewHash();
+
   /* Set the global scope */
   symtabs = NewHash();
   Setattr(symtabs, "", current_symtab);
@@ -303,6 +335,10 @@ void Swig_symbol_setscopename(const_String_or_char_ptr name) {
   /* assert(!Getattr(current_symtab,"name")); */
   Setattr(current_symtab, "name", name);
 
+  /* Naming (or renaming) a scope changes the qualified name of every scope
+     nested inside it, so drop all memoized qualified scope names */
+  scopename_generation++;
+
   /* Set nested scope in parent */
 
   qname = Swig_symbol_qualifiedscopename(current_symtab);
@@ -349,6 +385,10 @@ String *Swig_symbol_qualifiedscopename(Symtab *symtab) {
   String *name;
   if (!symtab)
     symtab = current_symtab;
+  if (GetInt(symtab, "qscope:generation") == scopename_generation) {
+    String *cached = Getattr(symtab, "qscope:name");
+    return cached ? Copy(cached) : 0;
+  }
   parent = Getattr(symtab, "parentNode");
   if (parent) {
     result = Swig_symbol_qualifiedscopename(parent);
@@ -364,6 +404,16 @@ String *Swig_symbol_qualifiedscopename(Symtab *symtab) {
       Append(result, name);
     }
   }
+  /* Memoize on the symbol table node itself.  Keep a private copy since the
+     caller owns (and may modify) the returned string */
+  if (result) {
+    String *cached = Copy(result);
+    Setattr(symtab, "qscope:name", cached);
+    Delete(cached);
+  } else {
+    Delattr(symtab, "qscope:name");
+  }
+  SetInt(symtab, "qscope:generation", scopename_generation);
   return result;
 }
 
@@ -549,6 +599,9 @@ void Swig_symbol_cadd(const_String_or_char_ptr name, Node *n) {
   if (!name)
     return;
 
+  if (all_sym_names)
+    Setattr(all_sym_names, name, "1");
+
   if (SwigType_istemplate(name)) {
     String *cname = NewString(name);
     String *dname = Swig_symbol_template_deftype(cname, 0);
@@ -1035,6 +1088,7 @@ static Node *symbol_lookup(const_String_or_char_ptr name, Symtab *symtab, int (*
 static Node *symbol_lookup_qualified(const_String_or_char_ptr name, Symtab *symtab, const String *prefix, int local, int (*checkfunc) (Node *n)) {
   /* This is a little funky, we search by fully qualified names */
 
+  stats_qualified_lookups++;
   if (!symtab)
     return 0;
   if (!prefix) {
@@ -1124,6 +1178,11 @@ Node *Swig_symbol_clookup(const_String_or_char_ptr name, Symtab *n) {
   Hash *hsym = 0;
   Node *s = 0;
 
+  stats_clookup_calls++;
+
+  if (all_sym_names && !Getattr(all_sym_names, name) && !SwigType_istemplate(name) && !Swig_scopename_check(name))
+    return 0;
+
   if (!n) {
     hsym = current_symtab;
   } else {
@@ -47,6 +47,63 @@ void Swig_print_tags(DOH *obj, DOH *root) {
 
 static int indent_level = 0;
 
+/* Filters applied by Swig_print_tree()/Swig_print_node(), configured
+   through Swig_print_tree_filter() (-debug-tree-types and friends) so the
+   stage dumps stay usable on large parse trees. */
+static Hash *print_filter_types = 0;	/* allowlist of node types/names to select */
+static Hash *print_filter_attrs = 0;	/* allowlist of attributes to display */
+static int print_filter_maxdepth = -1;	/* child levels below a selected node, -1 = no limit */
+static int print_filter_selected = 0;	/* currently inside a selected subtree */
+static int print_depth = 0;
+
+static Hash *commalist_hash(const char *list) {
+  Hash *h = NewHash();
+  const char *c = list;
+  while (*c) {
+    const char *e = strchr(c, ',');
+    int n = e ? (int) (e - c) : (int) strlen(c);
+    if (n > 0) {
+      String *item = NewStringWithSize(c, n);
+      Setattr(h, item, "1");
+      Delete(item);
+    }
+    c += n;
+    if (*c == ',')
+      c++;
+  }
+  return h;
+}
+
+/* -----------------------------------------------------------------------------
+ * Swig_print_tree_filter()
+ *
+ * Restrict subsequent tree dumps.  types and attributes are comma separated
+ * allowlists (0 leaves the filter off): only subtrees rooted at a node whose
+ * type or name is listed are printed, and only the listed attributes are
+ * shown.  maxdepth limits how many child levels are printed below a selected
+ * node (-1 for no limit).
+ * ----------------------------------------------------------------------------- */
+
+void Swig_print_tree_filter(const char *types, const char *attributes, int maxdepth) {
+  Delete(print_filter_types);
+  Delete(print_filter_attrs);
+  print_filter_types = types ? commalist_hash(types) : 0;
+  print_filter_attrs = attributes ? commalist_hash(attributes) : 0;
+  print_filter_maxdepth = maxdepth;
+}
+
+/* A node is selected if there is no type filter, if we are already inside a
+   selected subtree, or if its type or name is on the allowlist. */
+static int print_node_selected(Node *obj) {
+  String *name;
+  if (!print_filter_types || print_filter_selected)
+    return 1;
+  if (Getattr(print_filter_types, nodeType(obj)))
+    return 1;
+  name = Getattr(obj, "name");
+  return (name && Getattr(print_filter_types, name)) ? 1 : 0;
+}
+
 static void print_indent(int l) {
   int i;
   for (i = 0; i < indent_level; i++) {
@@ -75,6 +132,8 @@ void Swig_print_node(Node *obj) {
     if ((Cmp(k, "nodeType") == 0) || (Cmp(k, "firstChild") == 0) || (Cmp(k, "lastChild") == 0) ||
 	(Cmp(k, "parentNode") == 0) || (Cmp(k, "nextSibling") == 0) || (Cmp(k, "previousSibling") == 0) || (*(Char(k)) == '$')) {
       /* Do nothing */
+    } else if (print_filter_attrs && !Getattr(print_filter_attrs, k)) {
+      /* Attribute not on the allowlist */
     } else if (Cmp(k, "kwargs") == 0 || Cmp(k, "parms") == 0 || Cmp(k, "wrap:parms") == 0 ||
 	       Cmp(k, "pattern") == 0 || Cmp(k, "templateparms") == 0 || Cmp(k, "throws") == 0) {
       print_indent(2);
@@ -98,11 +157,16 @@ void Swig_print_node(Node *obj) {
     ki = Next(ki);
   }
   cobj = firstChild(obj);
-  if (cobj) {
+  if (cobj && (print_filter_maxdepth < 0 || print_depth < print_filter_maxdepth)) {
+    int selected = print_filter_selected;
+    print_filter_selected = 1;
+    print_depth++;
     indent_level += 6;
     Printf(stdout, "\n");
     Swig_print_tree(cobj);
     indent_level -= 6;
+    print_depth--;
+    print_filter_selected = selected;
   } else {
     print_indent(1);
     Printf(stdout, "\n");
@@ -117,7 +181,12 @@ void Swig_print_node(Node *obj) {
 
 void Swig_print_tree(DOH *obj) {
   while (obj) {
-    Swig_print_node(obj);
+    if (print_node_selected(obj)) {
+      Swig_print_node(obj);
+    } else {
+      /* Not selected: keep searching the subtree for selected nodes */
+      Swig_print_tree(firstChild(obj));
+    }
     obj = nextSibling(obj);
   }
 }
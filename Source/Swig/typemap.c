@@ -61,6 +61,76 @@ static void replace_embedded_typemap(String *s, ParmList *parm_sublist, Wrapper
 
 static Hash *typemaps;
 
+/* Memo of typemap_search() results.  Thousands of parameters share the same
+   few dozen (method, type, name) combinations, so remember the matched
+   typemap and matchtype instead of re-running the reduction loops.  The memo
+   is dropped when a typemap is registered or cleared, and when the type
+   system generation changes, since the search reduces types through
+   SwigType_typedef_resolve().  Template types are not memoized: their hash
+   key canonicalization goes through the symbol table, whose changes are not
+   covered by the generation counter. */
+static Hash *typemap_search_cache = 0;
+static unsigned long typemap_search_generation = 0;
+
+/* Typemap methods that have at least one registration.  Searches for a
+   method that was never registered ("check" and "default" in most language
+   libraries, and nearly every composed multi-argument method name) skip the
+   type reduction ladder outright.  Presence is one-way: %clearing a typemap
+   only drops its code, so a method once seen stays in the hash and the
+   ladder remains the arbiter for it. */
+static Hash *typemap_methods_seen = 0;
+
+static void typemap_search_cache_invalidate(void) {
+  Delete(typemap_search_cache);
+  typemap_search_cache = 0;
+}
+
+/* Counters for -debug-stats */
+static unsigned long stats_search_calls = 0;
+static unsigned long stats_search_memo_hits = 0;
+static unsigned long stats_search_reductions = 0;
+
+/* Per-method breakdown of the counters above, keyed by canonical method
+   name; each entry records "calls", "memo_hits" and "reduction_steps".
+   Only collected when requested, so the common path pays nothing. */
+static int stats_search_permethod = 0;
+static Hash *stats_search_methods = 0;
+
+void Swig_typemap_search_stats(unsigned long *calls, unsigned long *memo_hits, unsigned long *reductions) {
+  *calls = stats_search_calls;
+  *memo_hits = stats_search_memo_hits;
+  *reductions = stats_search_reductions;
+}
+
+void Swig_typemap_search_stats_permethod(int enable) {
+  stats_search_permethod = enable;
+}
+
+Hash *Swig_typemap_search_stats_methods(void) {
+  return stats_search_methods;
+}
+
+/* Top-level typemap registry, exposed so -debug-stats can report its
+   probe-distance distribution alongside the symbol tables. */
+Hash *Swig_typemap_registry(void) {
+  return typemaps;
+}
+
+static void stats_method_bump(const String *tm_method, const char *counter, int n) {
+  Hash *entry;
+  if (!n)
+    return;
+  if (!stats_search_methods)
+    stats_search_methods = NewHash();
+  entry = Getattr(stats_search_methods, tm_method);
+  if (!entry) {
+    entry = NewHash();
+    Setattr(stats_search_methods, tm_method, entry);
+    Delete(entry);
+  }
+  SetInt(entry, counter, GetInt(entry, counter) + n);
+}
+
 /* -----------------------------------------------------------------------------
  * typemap_identifier_fix()
  *
@@ -153,6 +223,7 @@ static void set_typemap(const SwigType *type, Hash **tmhash) {
 
 void Swig_typemap_init() {
   typemaps = NewHash();
+  typemap_methods_seen = NewHash();
 }
 
 static String *typemap_method_name(const_String_or_char_ptr tmap_method) {
@@ -204,7 +275,11 @@ static void typemap_register(const_String_or_char_ptr tmap_method, ParmList *par
       Swig_print_node(parms);
   }
 
+  typemap_search_cache_invalidate();
+
   tm_method = typemap_method_name(tmap_method);
+  if (!Getattr(typemap_methods_seen, tm_method))
+    Setattr(typemap_methods_seen, tm_method, "1");
 
   /* Register the first type in the parameter list */
 
@@ -395,6 +470,8 @@ void Swig_typemap_clear(const_String_or_char_ptr tmap_method, ParmList *parms) {
   String *multi_tmap_method;
   Hash *tm = 0;
 
+  typemap_search_cache_invalidate();
+
   /* This might not work */
   multi_tmap_method = NewString(tmap_method);
   p = parms;
@@ -569,6 +646,8 @@ void Swig_typemap_clear_apply(Parm *parms) {
   Hash *tm;
   String *name;
 
+  typemap_search_cache_invalidate();
+
   /* Create a type signature of the parameters */
   tsig = NewStringEmpty();
   p = parms;
@@ -699,14 +778,53 @@ static Hash *typemap_search(const_String_or_char_ptr tmap_method, SwigType *type
   int isarray;
   const String *cname = 0;
   const String *cqualifiedname = 0;
+  String *cachekey = 0;
   String *tm_method = typemap_method_name(tmap_method);
   int debug_display = (in_typemap_search_multi == 0) && typemap_search_debug;
+  unsigned long steps_at_entry;
+
+  stats_search_calls++;
+  steps_at_entry = stats_search_reductions;
+  if (stats_search_permethod)
+    stats_method_bump(tm_method, "calls", 1);
+
+  /* A method with no registrations cannot match at any reduction step */
+  if (!typemap_search_debug && !typemaps_used_debug && !Getattr(typemap_methods_seen, tm_method)) {
+    if (matchtype)
+      *matchtype = 0;
+    return 0;
+  }
 
   if ((name) && Len(name))
     cname = name;
   if ((qualifiedname) && Len(qualifiedname))
     cqualifiedname = qualifiedname;
 
+  if (!typemap_search_debug && !typemaps_used_debug && !SwigType_istemplate(type)) {
+    unsigned long generation = SwigType_typesystem_generation();
+    if (typemap_search_cache && typemap_search_generation != generation)
+      typemap_search_cache_invalidate();
+    typemap_search_generation = generation;
+    /* The symbol scope participates in the key: reduced types can be
+       canonicalized through the symbol table (get_typemap), and the symbol
+       scope moves independently of the type system generation */
+    cachekey = NewStringf("%p\001%s\001%s\001%s\001%s", (void *) Swig_symbol_current(), tmap_method, type, cname ? cname : (const String *) "", cqualifiedname ? cqualifiedname : (const String *) "");
+    if (typemap_search_cache) {
+      Hash *memo = Getattr(typemap_search_cache, cachekey);
+      if (memo) {
+	stats_search_memo_hits++;
+	if (stats_search_permethod)
+	  stats_method_bump(tm_method, "memo_hits", 1);
+	Delete(cachekey);
+	if (matchtype)
+	  *matchtype = Copy(Getattr(memo, "matchtype"));
+	return Getattr(memo, "result");
+      }
+    } else {
+      typemap_search_cache = NewHash();
+    }
+  }
+
   if (debug_display) {
     String *typestr = SwigType_str(type, cqualifiedname ? cqualifiedname : cname);
     Swig_diagnostic(Getfile(node), Getline(node), "Searching for a suitable '%s' typemap for: %s\n", tmap_method, typestr);
@@ -715,6 +833,7 @@ static Hash *typemap_search(const_String_or_char_ptr tmap_method, SwigType *type
   ctype = Copy(type);
   ctype_unstripped = Copy(ctype);
   while (ctype) {
+    stats_search_reductions++;
     /* Try to get an exact type-match */
     tm = get_typemap(ctype);
     result = typemap_search_helper(debug_display, tm, tm_method, ctype, cqualifiedname, cname, &backup);
@@ -773,6 +892,7 @@ static Hash *typemap_search(const_String_or_char_ptr tmap_method, SwigType *type
 
   primitive = SwigType_default_create(type);
   while (primitive) {
+    stats_search_reductions++;
     tm = get_typemap(primitive);
     result = typemap_search_helper(debug_display, tm, tm_method, primitive, cqualifiedname, cname, &backup);
     if (result && Getattr(result, "code"))
@@ -791,9 +911,23 @@ static Hash *typemap_search(const_String_or_char_ptr tmap_method, SwigType *type
   result = backup;
 
 ret_result:
+  if (stats_search_permethod)
+    stats_method_bump(tm_method, "reduction_steps", (int) (stats_search_reductions - steps_at_entry));
   Delete(primitive);
   if (matchtype)
     *matchtype = Copy(ctype);
+  if (cachekey) {
+    if (typemap_search_cache) {
+      Hash *memo = NewHash();
+      if (result)
+	Setattr(memo, "result", result);
+      if (ctype)
+	Setattr(memo, "matchtype", ctype);
+      Setattr(typemap_search_cache, cachekey, memo);
+      Delete(memo);
+    }
+    Delete(cachekey);
+  }
   Delete(ctype);
   Delete(ctype_unstripped);
   return result;
@@ -2052,11 +2186,8 @@ static void replace_embedded_typemap(String *s, ParmList *parm_sublist, Wrapper
 	      Printf(attr, "%s", ":next");
 	      /* fail if multi-argument lookup requested in $typemap(...) and the lookup failed */
 	      if (!Getattr(to_match_parms, attr)) {
-		/* Replace parameter variables */
-		Iterator ki;
-		for (ki = First(vars); ki.key; ki = Next(ki)) {
-		  Replace(tm, ki.key, ki.item, DOH_REPLACE_ANY);
-		}
+		/* Replace parameter variables in one pass */
+		ReplaceMulti(tm, vars);
 		/* offer the target language module the chance to make special variable substitutions */
 		Language_replace_special_variables(tmap_method, tm, to_match_parms);
 		/* finish up - do the substitution */
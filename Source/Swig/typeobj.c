@@ -141,28 +141,27 @@ SwigType *NewSwigType(const_String_or_char_ptr initial) {
  * ----------------------------------------------------------------------------- */
 
 static int element_size(char *c) {
-  int nparen;
   char *s = c;
   while (*c) {
+    /* Let the libc scan for the next separator or parameter list rather
+       than walking a character at a time */
+    c += strcspn(c, ".(");
     if (*c == '.') {
       c++;
       return (int) (c - s);
     } else if (*c == '(') {
-      nparen = 1;
+      int nparen = 1;
       c++;
-      while (*c) {
+      while (*c && nparen) {
+	c += strcspn(c, "()");
 	if (*c == '(')
 	  nparen++;
-	if (*c == ')') {
+	else if (*c == ')')
 	  nparen--;
-	  if (nparen == 0)
-	    break;
-	}
-	c++;
+	if (*c)
+	  c++;
       }
     }
-    if (*c)
-      c++;
   }
   return (int) (c - s);
 }
@@ -238,6 +237,38 @@ String *SwigType_parm(const SwigType *t) {
   return NewStringWithSize(start, (int) (c - start));
 }
 
+/* -----------------------------------------------------------------------------
+ * SwigType_parm_view()
+ *
+ * Returns the parameter of an operator as a read-only view into t, avoiding
+ * a copy.  The result must only be inspected (Char/Strcmp/Strstr) and
+ * Deleted before t is next modified.
+ * ----------------------------------------------------------------------------- */
+
+String *SwigType_parm_view(const SwigType *t) {
+  char *base, *start, *c;
+  int nparens = 0;
+
+  base = c = Char(t);
+  while (*c && (*c != '(') && (*c != '.'))
+    c++;
+  if (!*c || (*c == '.'))
+    return 0;
+  c++;
+  start = c;
+  while (*c) {
+    if (*c == ')') {
+      if (nparens == 0)
+	break;
+      nparens--;
+    } else if (*c == '(') {
+      nparens++;
+    }
+    c++;
+  }
+  return NewStringView((DOH *) t, (int) (start - base), (int) (c - start));
+}
+
 /* -----------------------------------------------------------------------------
  * SwigType_split()
  *
@@ -298,30 +329,29 @@ List *SwigType_parmlist(const String *p) {
   list = NewList();
   itemstart = c;
   while (*c) {
+    c += strcspn(c, ",()");
     if (*c == ',') {
       size = (int) (c - itemstart);
       item = NewStringWithSize(itemstart, size);
       Append(list, item);
       Delete(item);
       itemstart = c + 1;
+      c++;
     } else if (*c == '(') {
       int nparens = 1;
       c++;
-      while (*c) {
+      while (*c && nparens) {
+	c += strcspn(c, "()");
 	if (*c == '(')
 	  nparens++;
-	if (*c == ')') {
+	else if (*c == ')')
 	  nparens--;
-	  if (nparens == 0)
-	    break;
-	}
-	c++;
+	if (*c)
+	  c++;
       }
-    } else if (*c == ')') {
-      break;
+    } else {
+      break;			/* ')' or end of string */
     }
-    if (*c)
-      c++;
   }
   size = (int) (c - itemstart);
   if (size > 0) {
@@ -1126,44 +1156,43 @@ SwigType *SwigType_base(const SwigType *t) {
 
   /* Search for the last type constructor separator '.' */
   while (*c) {
+    c += strcspn(c, ".<(");
     if (*c == '.') {
       if (*(c + 1)) {
 	lastop = c + 1;
       }
       c++;
-      continue;
-    }
-    if (*c == '<') {
+    } else if (*c == '<') {
       /* Skip over template---it's part of the base name */
       int ntemp = 1;
       c++;
-      while ((*c) && (ntemp > 0)) {
-	if (*c == '>')
-	  ntemp--;
-	else if (*c == '<')
+      while (*c && ntemp > 0) {
+	c += strcspn(c, "<>");
+	if (*c == '<')
 	  ntemp++;
-	c++;
+	else if (*c == '>')
+	  ntemp--;
+	if (*c)
+	  c++;
       }
       if (ntemp)
 	break;
-      continue;
-    }
-    if (*c == '(') {
+    } else if (*c == '(') {
       /* Skip over params */
       int nparen = 1;
       c++;
-      while ((*c) && (nparen > 0)) {
+      while (*c && nparen > 0) {
+	c += strcspn(c, "()");
 	if (*c == '(')
 	  nparen++;
 	else if (*c == ')')
 	  nparen--;
-	c++;
+	if (*c)
+	  c++;
       }
       if (nparen)
 	break;
-      continue;
     }
-    c++;
   }
   return NewString(lastop);
 }
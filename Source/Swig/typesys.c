@@ -180,10 +180,51 @@ int Swig_value_wrapper_mode(int mode) {
 }
 
 
+/* Flush the resolution caches.  Called when the type system is mutated (a
+   typedef, class, scope alias or using declaration is added), not when the
+   current scope merely changes: cache keys are qualified by the scope they
+   were resolved in, so entries stay valid across scope switches. */
+static unsigned long typesys_generation = 0;
+
 static void flush_cache() {
+  Delete(typedef_resolve_cache);
+  Delete(typedef_all_cache);
+  Delete(typedef_qualified_cache);
   typedef_resolve_cache = 0;
   typedef_all_cache = 0;
   typedef_qualified_cache = 0;
+  typesys_generation++;
+}
+
+/* Counters for -debug-stats */
+static unsigned long stats_resolve_calls = 0;
+static unsigned long stats_resolve_cache_hits = 0;
+static unsigned long stats_resolve_all_max_depth = 0;
+
+void SwigType_resolve_stats(unsigned long *calls, unsigned long *cache_hits, unsigned long *max_depth) {
+  *calls = stats_resolve_calls;
+  *cache_hits = stats_resolve_cache_hits;
+  *max_depth = stats_resolve_all_max_depth;
+}
+
+/* -----------------------------------------------------------------------------
+ * SwigType_typesystem_generation()
+ *
+ * Returns a counter that changes whenever a type resolution could start
+ * returning a different answer: on any type system mutation or change of the
+ * current scope.  Callers caching resolution-dependent results compare it to
+ * decide whether their cache is still valid.
+ * ----------------------------------------------------------------------------- */
+
+unsigned long SwigType_typesystem_generation(void) {
+  return typesys_generation;
+}
+
+/* Cache key for a resolution of t in the current scope.  A Typetab address
+   can only be recycled after another scope is created, which flushes, so the
+   pointer is a safe discriminator. */
+static String *cache_key(const SwigType *t) {
+  return NewStringf("%p\001%s", (void *) current_scope, t);
 }
 
 /* Initialize the scoping system */
@@ -193,6 +234,7 @@ void SwigType_typesystem_init() {
     Delete(global_scope);
   if (scopes)
     Delete(scopes);
+  flush_cache();
 
   current_scope = NewHash();
   global_scope = current_scope;
@@ -415,7 +457,7 @@ Typetab *SwigType_pop_scope() {
   current_scope = t;
   current_typetab = Getattr(t, "typetab");
   current_symtab = Getattr(t, "symtab");
-  flush_cache();
+  typesys_generation++;
   return old;
 }
 
@@ -432,7 +474,7 @@ Typetab *SwigType_set_scope(Typetab *t) {
   current_scope = t;
   current_typetab = Getattr(t, "typetab");
   current_symtab = Getattr(t, "symtab");
-  flush_cache();
+  typesys_generation++;
   return old;
 }
 
@@ -689,15 +731,22 @@ SwigType *SwigType_typedef_resolve(const SwigType *t) {
   String *namebase = 0;
   String *nameprefix = 0, *rnameprefix = 0;
   int newtype = 0;
+#ifdef SWIG_TYPEDEF_RESOLVE_CACHE
+  String *cachekey = 0;
+#endif
 
   resolved_scope = 0;
+  stats_resolve_calls++;
 
 #ifdef SWIG_TYPEDEF_RESOLVE_CACHE
   if (!typedef_resolve_cache) {
     typedef_resolve_cache = NewHash();
   }
-  r = Getattr(typedef_resolve_cache, t);
+  cachekey = cache_key(t);
+  r = Getattr(typedef_resolve_cache, cachekey);
   if (r) {
+    stats_resolve_cache_hits++;
+    Delete(cachekey);
     resolved_scope = Getmeta(r, "scope");
     return Copy(r);
   }
@@ -977,18 +1026,15 @@ SwigType *SwigType_typedef_resolve(const SwigType *t) {
 
 return_result:
 #ifdef SWIG_TYPEDEF_RESOLVE_CACHE
-  {
-    String *key = NewString(t);
-    if (r) {
-      SwigType *r1;
-      Setattr(typedef_resolve_cache, key, r);
-      Setmeta(r, "scope", resolved_scope);
-      r1 = Copy(r);
-      Delete(r);
-      r = r1;
-    }
-    Delete(key);
+  if (r && typedef_resolve_cache) {
+    SwigType *r1;
+    Setattr(typedef_resolve_cache, cachekey, r);
+    Setmeta(r, "scope", resolved_scope);
+    r1 = Copy(r);
+    Delete(r);
+    r = r1;
   }
+  Delete(cachekey);
 #endif
   return r;
 }
@@ -1002,14 +1048,17 @@ return_result:
 SwigType *SwigType_typedef_resolve_all(const SwigType *t) {
   SwigType *n;
   SwigType *r;
+  String *cachekey;
   int count = 0;
 
   /* Check to see if the typedef resolve has been done before by checking the cache */
   if (!typedef_all_cache) {
     typedef_all_cache = NewHash();
   }
-  r = Getattr(typedef_all_cache, t);
+  cachekey = cache_key(t);
+  r = Getattr(typedef_all_cache, cachekey);
   if (r) {
+    Delete(cachekey);
     return Copy(r);
   }
 
@@ -1027,15 +1076,16 @@ SwigType *SwigType_typedef_resolve_all(const SwigType *t) {
     }
   }
 
+  if ((unsigned long) count > stats_resolve_all_max_depth)
+    stats_resolve_all_max_depth = (unsigned long) count;
+
   /* Add the typedef to the cache for next time it is looked up */
-  {
-    String *key;
+  if (typedef_all_cache) {
     SwigType *rr = Copy(r);
-    key = NewString(t);
-    Setattr(typedef_all_cache, key, rr);
-    Delete(key);
+    Setattr(typedef_all_cache, cachekey, rr);
     Delete(rr);
   }
+  Delete(cachekey);
 #ifdef SWIG_DEBUG
   Printf(stdout, "SwigType_typedef_resolve_all end   === %s => %s\n", t, r);
 #endif
@@ -1064,13 +1114,16 @@ SwigType *SwigType_typedef_resolve_all(const SwigType *t) {
 SwigType *SwigType_typedef_qualified(const SwigType *t) {
   List *elements;
   String *result;
+  String *cachekey;
   int i, len;
 
   if (!typedef_qualified_cache)
     typedef_qualified_cache = NewHash();
-  result = Getattr(typedef_qualified_cache, t);
+  cachekey = cache_key(t);
+  result = Getattr(typedef_qualified_cache, cachekey);
   if (result) {
     String *rc = Copy(result);
+    Delete(cachekey);
     return rc;
   }
 
@@ -1239,14 +1292,12 @@ SwigType *SwigType_typedef_qualified(const SwigType *t) {
     }
   }
   Delete(elements);
-  {
-    String *key, *cresult;
-    key = NewString(t);
-    cresult = NewString(result);
-    Setattr(typedef_qualified_cache, key, cresult);
-    Delete(key);
+  if (typedef_qualified_cache) {
+    String *cresult = NewString(result);
+    Setattr(typedef_qualified_cache, cachekey, cresult);
     Delete(cresult);
   }
+  Delete(cachekey);
   return result;
 }
 
@@ -1303,6 +1354,7 @@ int SwigType_typedef_using(const_String_or_char_ptr name) {
 
   /* We set up a typedef  B --> A::B */
   Setattr(current_typetab, base, name);
+  flush_cache();
 
   /* Find the scope name where the symbol is defined */
   td = SwigType_typedef_resolve(name);
@@ -2094,9 +2146,204 @@ static int SwigType_compare_mangled(const DOH *a, const DOH *b) {
  * wrapper file.
  * ----------------------------------------------------------------------------- */
 List *SwigType_get_sorted_mangled_list() {
-  List *l = Keys(r_mangled);
-  SortList(l, SwigType_compare_mangled);
-  return l;
+  return SortedKeys(r_mangled, SwigType_compare_mangled);
+}
+
+/* -----------------------------------------------------------------------------
+ * Binary type manifests
+ *
+ * A manifest is a compact binary snapshot of the type tracking tables above
+ * (r_mangled, r_resolved, r_ltype).  A module generated with -export-typetab
+ * writes one after code generation; other modules preload it with
+ * -import-typetab so that their emitted type tables already contain the
+ * exporting module's types and typedef equivalences.  The runtime module
+ * merge in swiginit then resolves shared types by direct name lookup instead
+ * of rediscovering the equivalences at every process start.
+ *
+ * Format (all integers little endian):
+ *   "SWGM"  4-byte magic
+ *   u8      format version (currently 1)
+ *   u32     number of mangled entries
+ * followed by one record per entry:
+ *   string  mangled name
+ *   u32     resolved type count, followed by that many strings
+ *   u32     ltype count, followed by that many strings
+ * where a string is a u32 byte count followed by the bytes.
+ * ----------------------------------------------------------------------------- */
+
+#define SWIG_TYPE_MANIFEST_MAGIC   "SWGM"
+#define SWIG_TYPE_MANIFEST_VERSION 1
+
+static void manifest_put_u32(FILE *f, unsigned long n) {
+  unsigned char b[4];
+  b[0] = (unsigned char) (n & 0xff);
+  b[1] = (unsigned char) ((n >> 8) & 0xff);
+  b[2] = (unsigned char) ((n >> 16) & 0xff);
+  b[3] = (unsigned char) ((n >> 24) & 0xff);
+  fwrite(b, 1, 4, f);
+}
+
+static int manifest_get_u32(FILE *f, unsigned long *n) {
+  unsigned char b[4];
+  if (fread(b, 1, 4, f) != 4)
+    return -1;
+  *n = (unsigned long) b[0] | ((unsigned long) b[1] << 8) | ((unsigned long) b[2] << 16) | ((unsigned long) b[3] << 24);
+  return 0;
+}
+
+static void manifest_put_str(FILE *f, String *s) {
+  unsigned long len = (unsigned long) Len(s);
+  manifest_put_u32(f, len);
+  fwrite(Char(s), 1, (size_t) len, f);
+}
+
+static String *manifest_get_str(FILE *f) {
+  unsigned long len;
+  String *s;
+  char *buf;
+  if (manifest_get_u32(f, &len) < 0)
+    return 0;
+  buf = (char *) DohMalloc(len + 1);
+  if (fread(buf, 1, (size_t) len, f) != (size_t) len) {
+    DohFree(buf);
+    return 0;
+  }
+  buf[len] = 0;
+  s = NewString(buf);
+  DohFree(buf);
+  return s;
+}
+
+/* -----------------------------------------------------------------------------
+ * SwigType_export_type_manifest()
+ *
+ * Write the remembered type tables to a binary manifest file.  Entries are
+ * sorted so the output is reproducible.  Returns 0 on success, -1 on failure.
+ * ----------------------------------------------------------------------------- */
+
+int SwigType_export_type_manifest(const_String_or_char_ptr filename) {
+  FILE *f;
+  List *mangled_list;
+  int i, nmangled;
+  if (!r_mangled) {
+    r_mangled = NewHash();
+    r_resolved = NewHash();
+    r_ltype = NewHash();
+    r_clientdata = NewHash();
+    r_remembered = NewHash();
+  }
+  f = fopen(Char(filename), "wb");
+  if (!f)
+    return -1;
+  fwrite(SWIG_TYPE_MANIFEST_MAGIC, 1, 4, f);
+  fputc(SWIG_TYPE_MANIFEST_VERSION, f);
+  mangled_list = SwigType_get_sorted_mangled_list();
+  nmangled = Len(mangled_list);
+  manifest_put_u32(f, (unsigned long) nmangled);
+  for (i = 0; i < nmangled; i++) {
+    String *mt = Getitem(mangled_list, i);
+    List *resolved_list = SortedKeys(Getattr(r_mangled, mt), Strcmp);
+    Hash *lthash = Getattr(r_ltype, mt);
+    List *ltype_list = lthash ? SortedKeys(lthash, Strcmp) : NewList();
+    int j;
+    manifest_put_str(f, mt);
+    manifest_put_u32(f, (unsigned long) Len(resolved_list));
+    for (j = 0; j < Len(resolved_list); j++) {
+      manifest_put_str(f, Getitem(resolved_list, j));
+    }
+    manifest_put_u32(f, (unsigned long) Len(ltype_list));
+    for (j = 0; j < Len(ltype_list); j++) {
+      manifest_put_str(f, Getitem(ltype_list, j));
+    }
+    Delete(resolved_list);
+    Delete(ltype_list);
+  }
+  Delete(mangled_list);
+  if (fclose(f) != 0)
+    return -1;
+  return 0;
+}
+
+/* -----------------------------------------------------------------------------
+ * SwigType_import_type_manifest()
+ *
+ * Read a binary manifest written by SwigType_export_type_manifest() and merge
+ * its entries into the remembered type tables, exactly as if the types had
+ * been remembered during this run.  Returns 0 on success, -1 on failure.
+ * ----------------------------------------------------------------------------- */
+
+int SwigType_import_type_manifest(const_String_or_char_ptr filename) {
+  FILE *f;
+  char magic[4];
+  unsigned long nmangled, i;
+  f = fopen(Char(filename), "rb");
+  if (!f)
+    return -1;
+  if (fread(magic, 1, 4, f) != 4 || memcmp(magic, SWIG_TYPE_MANIFEST_MAGIC, 4) != 0 || fgetc(f) != SWIG_TYPE_MANIFEST_VERSION) {
+    fclose(f);
+    return -1;
+  }
+  if (manifest_get_u32(f, &nmangled) < 0) {
+    fclose(f);
+    return -1;
+  }
+  if (!r_mangled) {
+    r_mangled = NewHash();
+    r_resolved = NewHash();
+    r_ltype = NewHash();
+    r_clientdata = NewHash();
+    r_remembered = NewHash();
+  }
+  for (i = 0; i < nmangled; i++) {
+    String *mt = manifest_get_str(f);
+    unsigned long nresolved, nltype, j;
+    Hash *mh, *lthash;
+    if (!mt || manifest_get_u32(f, &nresolved) < 0)
+      goto fail;
+    mh = Getattr(r_mangled, mt);
+    if (!mh) {
+      mh = NewHash();
+      Setattr(r_mangled, mt, mh);
+      Delete(mh);
+      mh = Getattr(r_mangled, mt);
+    }
+    for (j = 0; j < nresolved; j++) {
+      String *fr = manifest_get_str(f);
+      Hash *rh;
+      if (!fr)
+	goto fail;
+      Setattr(mh, fr, mt);
+      rh = Getattr(r_resolved, fr);
+      if (!rh) {
+	rh = NewHash();
+	Setattr(r_resolved, fr, rh);
+	Delete(rh);
+	rh = Getattr(r_resolved, fr);
+      }
+      Setattr(rh, mt, fr);
+      Delete(fr);
+    }
+    if (manifest_get_u32(f, &nltype) < 0)
+      goto fail;
+    lthash = Getattr(r_ltype, mt);
+    if (!lthash) {
+      lthash = NewHash();
+      Setattr(r_ltype, mt, lthash);
+    }
+    for (j = 0; j < nltype; j++) {
+      String *lt = manifest_get_str(f);
+      if (!lt)
+	goto fail;
+      Setattr(lthash, lt, "1");
+      Delete(lt);
+    }
+    Delete(mt);
+  }
+  fclose(f);
+  return 0;
+fail:
+  fclose(f);
+  return -1;
 }
 
 
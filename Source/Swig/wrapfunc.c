@@ -18,6 +18,21 @@
 
 static int Compact_mode = 0;	/* set to 0 on default */
 static int Max_line_size = 128;
+static int Dedup_mode = 0;	/* emit thunks for duplicate wrapper bodies (-fdedup) */
+static Hash *Dedup_bodies = 0;	/* normalized body (per output file) -> name of first wrapper */
+static int Peephole_mode = 0;	/* fold known-redundant text in wrapper bodies (-fpeephole) */
+
+/* Pool of retired Wrapper objects.  Wrappers are created and destroyed
+   once per emitted function, and Clear() on a String or Hash keeps its
+   buffer, so recycling them means the def/locals/code sections stay at
+   their high-water-mark capacity instead of re-growing from empty tens
+   of thousands of times.  A wrapper is only pooled when nothing else
+   holds references to its sections; otherwise it is destroyed for real,
+   since clearing a section on reuse would wipe the survivor. */
+#define WRAPPER_POOL_SIZE 8
+
+static Wrapper *Wrapper_pool[WRAPPER_POOL_SIZE];
+static int Wrapper_pool_n = 0;
 
 /* -----------------------------------------------------------------------------
  * NewWrapper()
@@ -27,6 +42,14 @@ static int Max_line_size = 128;
 
 Wrapper *NewWrapper(void) {
   Wrapper *w;
+  if (Wrapper_pool_n > 0) {
+    w = Wrapper_pool[--Wrapper_pool_n];
+    Clear(w->localh);
+    Clear(w->locals);
+    Clear(w->code);
+    Clear(w->def);
+    return w;
+  }
   w = (Wrapper *) malloc(sizeof(Wrapper));
   w->localh = NewHash();
   w->locals = NewStringEmpty();
@@ -42,6 +65,10 @@ Wrapper *NewWrapper(void) {
  * ----------------------------------------------------------------------------- */
 
 void DelWrapper(Wrapper *w) {
+  if (Wrapper_pool_n < WRAPPER_POOL_SIZE && DohRefcount(w->localh) == 1 && DohRefcount(w->locals) == 1 && DohRefcount(w->code) == 1 && DohRefcount(w->def) == 1) {
+    Wrapper_pool[Wrapper_pool_n++] = w;
+    return;
+  }
   Delete(w->localh);
   Delete(w->locals);
   Delete(w->code);
@@ -59,6 +86,203 @@ void Wrapper_compact_print_mode_set(int flag) {
   Compact_mode = flag;
 }
 
+/* -----------------------------------------------------------------------------
+ * Wrapper_dedup_mode_set()
+ *
+ * Set Dedup_mode.
+ * ----------------------------------------------------------------------------- */
+
+void Wrapper_dedup_mode_set(int flag) {
+  Dedup_mode = flag;
+  if (flag && !Dedup_bodies)
+    Dedup_bodies = NewHash();
+}
+
+/* -----------------------------------------------------------------------------
+ * dedup_print()
+ *
+ * Template instantiations and overloads frequently produce wrapper bodies that
+ * are identical except for the function's own name.  When dedup mode is on,
+ * the first body with a given content is printed normally and subsequent
+ * duplicates become one-line thunks forwarding to it, shrinking the generated
+ * file and the compiled binary.  Returns 1 if a thunk was printed, 0 if the
+ * wrapper is not a duplicate (or could not be analyzed) and must be printed
+ * in full.
+ * ----------------------------------------------------------------------------- */
+
+static int dedup_ident_char(int c) {
+  return isalnum(c) || c == '_' || c == '$';
+}
+
+/* Duplicate bodies usually still differ in the diagnostic messages that quote
+   the function's scripting-language name.  Mask that name inside double-quoted
+   literals only - outside of strings it may be the name of the C function
+   being called, where it distinguishes genuinely different wrappers. */
+static void dedup_mask_in_strings(String *key, const char *symname) {
+  String *out = NewStringEmpty();
+  size_t symlen = strlen(symname);
+  char *p = Char(key);
+  int changed = 0;
+  while (*p) {
+    if (*p == '"') {
+      Putc(*p, out);
+      p++;
+      while (*p && *p != '"') {
+	if (*p == '\\' && p[1]) {
+	  Putc(*p, out);
+	  Putc(p[1], out);
+	  p += 2;
+	} else if (strncmp(p, symname, symlen) == 0) {
+	  Append(out, "SWIG_DEDUP_NAME");
+	  p += symlen;
+	  changed = 1;
+	} else {
+	  Putc(*p, out);
+	  p++;
+	}
+      }
+      if (*p == '"') {
+	Putc(*p, out);
+	p++;
+      }
+    } else {
+      Putc(*p, out);
+      p++;
+    }
+  }
+  if (changed) {
+    Clear(key);
+    Append(key, out);
+  }
+  Delete(out);
+}
+
+static int dedup_print(Wrapper *w, File *f) {
+  char *def = Char(w->def);
+  char *lparen = strchr(def, '(');
+  char *nstart, *nend, *p, *rparen;
+  int depth;
+  String *name, *args, *key, *target;
+  int isvoid;
+
+  /* The def must be a single line of the form '<type> name(parms) {' */
+  if (!lparen || strchr(def, '\n'))
+    return 0;
+  nend = lparen;
+  while (nend > def && isspace((int) nend[-1]))
+    nend--;
+  nstart = nend;
+  while (nstart > def && dedup_ident_char((int) nstart[-1]))
+    nstart--;
+  if (nstart == nend || isdigit((int) *nstart))
+    return 0;
+
+  /* A void return forwards without 'return'; anything else returns the call.
+     The return type may hide behind linkage macros, so look for a lone 'void'
+     with no pointer in sight. */
+  isvoid = 0;
+  for (p = def; p + 4 <= nstart; p++) {
+    if (strncmp(p, "void", 4) == 0 && (p == def || !dedup_ident_char((int) p[-1])) && !dedup_ident_char((int) p[4])) {
+      isvoid = 1;
+      break;
+    }
+  }
+  if (isvoid && memchr(def, '*', (size_t) (nstart - def)))
+    return 0;
+
+  /* Collect the parameter names for the forwarding call */
+  rparen = 0;
+  depth = 0;
+  for (p = lparen; *p; p++) {
+    if (*p == '(')
+      depth++;
+    else if (*p == ')' && --depth == 0) {
+      rparen = p;
+      break;
+    }
+  }
+  if (!rparen || !strchr(rparen, '{'))
+    return 0;
+  args = NewStringEmpty();
+  p = lparen + 1;
+  while (p < rparen && isspace((int) *p))
+    p++;
+  if (p < rparen && !(strncmp(p, "void", 4) == 0 && rparen - p <= 5)) {
+    char *pstart = p;
+    depth = 0;
+    for (; p <= rparen; p++) {
+      if (*p == '(' || *p == '[')
+	depth++;
+      else if (*p == ')' || *p == ']')
+	depth--;
+      if ((*p == ',' && depth == 0) || p == rparen) {
+	/* The parameter name is the last identifier that is not a number
+	   (skipping over array dimensions); an unnamed parameter makes the
+	   wrapper ineligible. */
+	char *e = p;
+	char *s = 0;
+	while (e > pstart) {
+	  while (e > pstart && !dedup_ident_char((int) e[-1]))
+	    e--;
+	  s = e;
+	  while (s > pstart && dedup_ident_char((int) s[-1]))
+	    s--;
+	  if (s == e || !isdigit((int) *s))
+	    break;
+	  e = s;
+	}
+	if (!s || s == e || s == pstart) {
+	  Delete(args);
+	  return 0;
+	}
+	if (Len(args) > 0)
+	  Append(args, ", ");
+	Write(args, s, (int) (e - s));
+	pstart = p + 1;
+      }
+    }
+  }
+
+  /* Normalize the body by masking the wrapper's own name and look it up */
+  name = NewStringWithSize(nstart, (int) (nend - nstart));
+  key = NewStringEmpty();
+  Printf(key, "%p|%s\n%s\n%s\n", f, w->def, w->locals, w->code);
+  Replace(key, name, "SWIG_DEDUP_SELF", DOH_REPLACE_ID);
+  if (strncmp(Char(name), "_wrap_", 6) == 0 && Len(name) > 6)
+    dedup_mask_in_strings(key, Char(name) + 6);
+  target = Getattr(Dedup_bodies, key);
+  if (!target) {
+    Setattr(Dedup_bodies, key, name);
+    Delete(name);
+    Delete(args);
+    Delete(key);
+    return 0;
+  }
+  Delete(key);
+
+  {
+    String *thunk = NewStringEmpty();
+    String *tdef = Copy(w->def);
+    /* SWIGUNUSEDPARM discards the parameter name under C++, but the thunk
+       forwards it; '(name)' is an equivalent plain declarator */
+    Replaceall(tdef, "SWIGUNUSEDPARM(", "(");
+    Printf(thunk, "%s\n", tdef);
+    Delete(tdef);
+    if (isvoid)
+      Printf(thunk, "%s(%s);\n}\n", target, args);
+    else
+      Printf(thunk, "return %s(%s);\n}\n", target, args);
+    if (Compact_mode == 1)
+      Wrapper_compact_print(thunk, f);
+    else
+      Wrapper_pretty_print(thunk, f);
+    Delete(thunk);
+  }
+  Delete(args);
+  Delete(name);
+  return 1;
+}
+
 /* -----------------------------------------------------------------------------
  * Wrapper_pretty_print()
  *
@@ -380,6 +604,41 @@ void Wrapper_compact_print(String *str, File *f) {
   Printf(f, "\n");
 }
 
+/* -----------------------------------------------------------------------------
+ * Peephole cleanup of assembled wrapper bodies (-fpeephole).
+ *
+ * The standard Lib typemaps compose conversion flags with a trailing
+ * "| 0" placeholder, so nearly every SWIG_ConvertPtr call in generated
+ * code carries a "0 |  0" or "SWIG_POINTER_OWN |  0" argument the C
+ * compiler has to fold away.  Folding these fixed spellings here keeps
+ * the generated text smaller and a little quicker to compile.  The
+ * patterns are literal strings produced by the library macros - bitwise
+ * or with 0 is an identity on the integer flag words they build - and
+ * nothing else in generated code matches their double-space spelling.
+ * ----------------------------------------------------------------------------- */
+
+static const char *Peephole_patterns[][2] = {
+  {" |  0 )", ")"},		/* "0 |  0 )", "SWIG_POINTER_OWN |  0 )", ... */
+  {"  0  | 0)", " 0)"},		/* spelling used by the AsVal/From macros */
+};
+
+static void peephole(String *s) {
+  unsigned int i;
+  for (i = 0; i < sizeof(Peephole_patterns) / sizeof(Peephole_patterns[0]); i++) {
+    Replaceall(s, Peephole_patterns[i][0], Peephole_patterns[i][1]);
+  }
+}
+
+/* -----------------------------------------------------------------------------
+ * Wrapper_peephole_mode_set()
+ *
+ * Set Peephole_mode.
+ * ----------------------------------------------------------------------------- */
+
+void Wrapper_peephole_mode_set(int flag) {
+  Peephole_mode = flag;
+}
+
 /* -----------------------------------------------------------------------------
  * Wrapper_print()
  *
@@ -389,6 +648,16 @@ void Wrapper_compact_print(String *str, File *f) {
 void Wrapper_print(Wrapper *w, File *f) {
   String *str;
 
+  if (Peephole_mode) {
+    /* Idempotent in-place rewrites, so printing the same wrapper into a
+       second file sees the already-folded text */
+    peephole(w->def);
+    peephole(w->code);
+  }
+
+  if (Dedup_mode && dedup_print(w, f))
+    return;
+
   str = NewStringEmpty();
   Printf(str, "%s\n", w->def);
   Printf(str, "%s\n", w->locals);
@@ -414,7 +683,8 @@ int Wrapper_add_local(Wrapper *w, const_String_or_char_ptr name, const_String_or
     return -1;
   }
   Setattr(w->localh, name, decl);
-  Printf(w->locals, "%s;\n", decl);
+  Append(w->locals, decl);
+  Append(w->locals, ";\n");
   return 0;
 }
 
@@ -482,7 +752,8 @@ char *Wrapper_new_local(Wrapper *w, const_String_or_char_ptr name, const_String_
   }
   Replace(ndecl, name, nname, DOH_REPLACE_ID);
   Setattr(w->localh, nname, ndecl);
-  Printf(w->locals, "%s;\n", ndecl);
+  Append(w->locals, ndecl);
+  Append(w->locals, ";\n");
   ret = Char(nname);
   Delete(nname);
   Delete(ndecl);
@@ -0,0 +1,86 @@
+#!/usr/bin/env python3
+# Generate synthetic SWIG interfaces of controlled shape for benchmarking.
+#
+# The corpus shape mirrors what large production interfaces look like:
+# namespaces holding classes with overloaded methods, typedef chains that
+# exercise SwigType_typedef_resolve, and template stacks instantiated with
+# %template to a configurable depth.
+#
+# Example:
+#   genbench.py --classes 200 --overloads 8 --template-depth 4 -o bench.i
+
+import argparse
+import sys
+
+
+def generate(out, classes, overloads, template_depth, namespaces, typedef_chain):
+    w = out.write
+    w("/* Generated by Tools/bench/genbench.py -- do not edit */\n")
+    w("%module bench\n\n")
+    w("%{\n/* no real implementation is needed to time generation */\n%}\n\n")
+
+    # typedef chains ending in distinct base types
+    w("/* typedef chains (depth %d) */\n" % typedef_chain)
+    for c in range(classes):
+        w("typedef int base_t_%d;\n" % c)
+        prev = "base_t_%d" % c
+        for d in range(typedef_chain):
+            name = "t_%d_%d" % (c, d)
+            w("typedef %s %s;\n" % (prev, name))
+            prev = name
+    w("\n")
+
+    # template stack instantiated at increasing depth
+    if template_depth:
+        w("/* template stack (depth %d) */\n" % template_depth)
+        w("template<typename T> struct Box { T value; T get() const; void set(T v); };\n")
+        for d in range(template_depth):
+            inner = "int" if d == 0 else nested(d)
+            w("%%template(Box%d) Box<%s >;\n" % (d, inner))
+        w("\n")
+
+    per_ns = max(1, classes // max(1, namespaces))
+    cls = 0
+    for n in range(namespaces):
+        w("namespace ns%d {\n" % n)
+        while cls < classes and (cls < (n + 1) * per_ns or n == namespaces - 1):
+            w("class Cls%d {\npublic:\n" % cls)
+            w("  Cls%d();\n" % cls)
+            w("  ~Cls%d();\n" % cls)
+            for m in range(overloads):
+                # same method name, arity m+1: exercises overload dispatch
+                args = ", ".join("t_%d_%d a%d" % (cls, i % max(1, typedef_chain), i) for i in range(m + 1))
+                w("  int method(%s);\n" % args)
+            w("  int plain(int a, const char *b);\n")
+            w("};\n")
+            cls += 1
+        w("}\n\n")
+
+
+def nested(depth):
+    s = "int"
+    for _ in range(depth):
+        s = "Box<%s >" % s
+    return s
+
+
+def main():
+    p = argparse.ArgumentParser(description="Generate a synthetic SWIG benchmark interface")
+    p.add_argument("--classes", type=int, default=100)
+    p.add_argument("--overloads", type=int, default=4)
+    p.add_argument("--template-depth", type=int, default=3)
+    p.add_argument("--namespaces", type=int, default=4)
+    p.add_argument("--typedef-chain", type=int, default=4)
+    p.add_argument("-o", "--output", default="-")
+    args = p.parse_args()
+
+    out = sys.stdout if args.output == "-" else open(args.output, "w")
+    try:
+        generate(out, args.classes, args.overloads, args.template_depth, args.namespaces, args.typedef_chain)
+    finally:
+        if out is not sys.stdout:
+            out.close()
+
+
+if __name__ == "__main__":
+    main()
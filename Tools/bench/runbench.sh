@@ -0,0 +1,73 @@
+#!/bin/sh
+# Time SWIG code generation over a synthetic corpus, per language module.
+#
+# Usage: runbench.sh [swig-binary] [languages...]
+#
+# Defaults to ./swig in the current directory (the tree's build output) and
+# a representative module set.  SWIG_LIB should point at the Lib directory
+# of the tree being measured; the top-level "make bench" target sets it.
+# Extra swig options (e.g. -I paths) can be passed in BENCH_SWIG_FLAGS.
+#
+# Output is one line per (shape, language): wall-clock seconds and peak
+# resident set size, suitable for committing to a log and diffing release
+# to release.
+
+SWIG=${1:-./swig}
+shift 2>/dev/null
+LANGUAGES=${*:-"python java ruby"}
+
+BENCHDIR=`dirname "$0"`
+WORKDIR=${BENCH_WORKDIR:-/tmp/swig-bench.$$}
+mkdir -p "$WORKDIR" || exit 1
+
+if [ ! -x "$SWIG" ]; then
+  echo "runbench.sh: $SWIG is not executable (build swig first)" 1>&2
+  exit 1
+fi
+
+# corpus shapes: classes overloads template-depth
+SHAPES="\
+small:50:4:2 \
+wide:400:2:2 \
+overloaded:100:16:2 \
+deep-templates:50:4:8"
+
+echo "# swig: `$SWIG -version 2>/dev/null | sed -n 's/^SWIG Version //p'`"
+echo "# shape language seconds maxrss_kb"
+
+for shape in $SHAPES; do
+  name=`echo $shape | cut -d: -f1`
+  nc=`echo $shape | cut -d: -f2`
+  no=`echo $shape | cut -d: -f3`
+  td=`echo $shape | cut -d: -f4`
+  corpus="$WORKDIR/$name.i"
+  python3 "$BENCHDIR/genbench.py" --classes $nc --overloads $no \
+    --template-depth $td -o "$corpus" || exit 1
+  for lang in $LANGUAGES; do
+    out="$WORKDIR/${name}_${lang}_wrap.cxx"
+    if [ -x /usr/bin/time ]; then
+      /usr/bin/time -f "$name $lang %e %M" -o "$WORKDIR/time.txt" \
+        "$SWIG" $BENCH_SWIG_FLAGS -c++ -$lang -o "$out" "$corpus" >/dev/null 2>"$WORKDIR/err.txt"
+      status=$?
+      if [ $status -eq 0 ]; then
+        cat "$WORKDIR/time.txt"
+      else
+        echo "$name $lang FAILED (status $status)" 1>&2
+      fi
+    else
+      start=`date +%s`
+      "$SWIG" $BENCH_SWIG_FLAGS -c++ -$lang -o "$out" "$corpus" >/dev/null 2>"$WORKDIR/err.txt"
+      status=$?
+      end=`date +%s`
+      if [ $status -eq 0 ]; then
+        echo "$name $lang `expr $end - $start` -"
+      else
+        echo "$name $lang FAILED (status $status)" 1>&2
+      fi
+    fi
+  done
+done
+
+if [ -z "$BENCH_WORKDIR" ]; then
+  rm -rf "$WORKDIR"
+fi
@@ -0,0 +1,137 @@
+#!/usr/bin/env python3
+# Time a pinned subset of the Examples/test-suite interfaces through each
+# language module and gate against a committed JSON baseline.
+#
+# The test-suite Makefiles only check correctness; this harness catches
+# performance regressions in the same place.  The subset is pinned so the
+# numbers are comparable run to run: each entry exercises a different part
+# of the pipeline (overload dispatch, template expansion, smart pointers,
+# the STL library files, directors).
+#
+# Record a baseline on a known-good tree:
+#   timetests.py --swig ./swig --testsuite Examples/test-suite \
+#       --write-baseline bench-baseline.json
+# then gate later trees against it:
+#   timetests.py --swig ./swig --testsuite Examples/test-suite \
+#       --baseline bench-baseline.json
+# which exits nonzero if any (test, language) pair is more than
+# --threshold (default 10%) slower than the baseline.
+#
+# Wall time is the best of --repeats runs; peak RSS comes from wait4(2),
+# so no external time(1) binary is needed.
+
+import argparse
+import json
+import os
+import resource
+import shlex
+import sys
+import tempfile
+import time
+
+# (test name, why it is in the subset)
+PINNED_TESTS = [
+    ("overload_simple", "overload dispatch generation"),
+    ("template_default2", "template instantiation and default args"),
+    ("smart_pointer_multi", "smart pointer member resolution"),
+    ("li_std_string", "STL library file expansion"),
+    ("director_basic", "director class emission"),
+    ("operator_overload", "operator renaming and overloads"),
+    ("namespace_class", "nested namespace symbol handling"),
+]
+
+
+def run_once(argv):
+    """Run argv to completion, returning (status, seconds, maxrss_kb)."""
+    with open(os.devnull, "wb") as devnull:
+        start = time.monotonic()
+        pid = os.posix_spawn(argv[0], argv, os.environ,
+                             file_actions=[(os.POSIX_SPAWN_DUP2, devnull.fileno(), 1),
+                                           (os.POSIX_SPAWN_DUP2, devnull.fileno(), 2)])
+        _, status, rusage = os.wait4(pid, 0)
+        seconds = time.monotonic() - start
+    return status, seconds, rusage.ru_maxrss
+
+
+def measure(swig, flags, testsuite, test, lang, workdir, repeats):
+    out = os.path.join(workdir, "%s_%s_wrap.cxx" % (test, lang))
+    argv = [swig] + flags + ["-c++", "-" + lang, "-o", out,
+            "-outdir", workdir, os.path.join(testsuite, test + ".i")]
+    best = None
+    for _ in range(repeats):
+        status, seconds, maxrss = run_once(argv)
+        if status != 0:
+            return None
+        if best is None or seconds < best[0]:
+            best = (seconds, maxrss)
+    return {"seconds": round(best[0], 4), "maxrss_kb": best[1]}
+
+
+def main():
+    p = argparse.ArgumentParser(description="Time pinned test-suite interfaces per language module")
+    p.add_argument("--swig", default="./swig")
+    p.add_argument("--testsuite", default="Examples/test-suite")
+    p.add_argument("--languages", default="python java ruby")
+    p.add_argument("--repeats", type=int, default=3)
+    p.add_argument("--threshold", type=float, default=0.10,
+                   help="relative wall-time slowdown that fails the gate")
+    p.add_argument("--min-delta", type=float, default=0.05,
+                   help="absolute slowdown (seconds) below which noise is ignored")
+    p.add_argument("--baseline", help="JSON baseline to compare against")
+    p.add_argument("--write-baseline", help="write results as a new JSON baseline")
+    args = p.parse_args()
+
+    if not os.access(args.swig, os.X_OK):
+        sys.exit("timetests.py: %s is not executable (build swig first)" % args.swig)
+
+    flags = shlex.split(os.environ.get("BENCH_SWIG_FLAGS", ""))
+    languages = args.languages.split()
+    results = {}
+    failed = []
+
+    with tempfile.TemporaryDirectory(prefix="swig-timetests.") as workdir:
+        print("# test language seconds maxrss_kb")
+        for test, _why in PINNED_TESTS:
+            for lang in languages:
+                r = measure(args.swig, flags, args.testsuite, test, lang,
+                            workdir, args.repeats)
+                if r is None:
+                    failed.append("%s %s" % (test, lang))
+                    print("%s %s FAILED" % (test, lang), file=sys.stderr)
+                    continue
+                results["%s:%s" % (test, lang)] = r
+                print("%s %s %.4f %d" % (test, lang, r["seconds"], r["maxrss_kb"]))
+
+    if failed:
+        sys.exit("timetests.py: generation failed for: %s" % ", ".join(failed))
+
+    if args.write_baseline:
+        with open(args.write_baseline, "w") as f:
+            json.dump({"threshold": args.threshold, "results": results}, f, indent=2)
+            f.write("\n")
+        print("baseline written to %s" % args.write_baseline)
+
+    if args.baseline:
+        with open(args.baseline) as f:
+            baseline = json.load(f)
+        regressions = []
+        for key, r in sorted(results.items()):
+            base = baseline["results"].get(key)
+            if not base:
+                continue
+            delta = r["seconds"] - base["seconds"]
+            if delta > args.min_delta and r["seconds"] > base["seconds"] * (1.0 + args.threshold):
+                regressions.append("%s: %.4fs -> %.4fs (+%.0f%%)"
+                                   % (key, base["seconds"], r["seconds"],
+                                      100.0 * delta / base["seconds"]))
+        if regressions:
+            print("timetests.py: wall-time regressions over %.0f%%:" % (100.0 * args.threshold),
+                  file=sys.stderr)
+            for line in regressions:
+                print("  " + line, file=sys.stderr)
+            sys.exit(1)
+        print("no regressions over %.0f%% against %s" % (100.0 * args.threshold, args.baseline))
+
+
+if __name__ == "__main__":
+    main()